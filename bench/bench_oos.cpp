@@ -0,0 +1,57 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench_suite.hpp"
+
+#include "object/PrototypeBenchUnit.hpp"
+#include "object/ContainerBenchUnit.hpp"
+#include "object/StoreBenchUnit.hpp"
+
+#include "tools/TimeBenchUnit.hpp"
+#include "tools/SequencerBenchUnit.hpp"
+
+#include "json/JsonBenchUnit.hpp"
+
+#include "database/SQLiteBenchUnit.hpp"
+#include "database/SessionBenchUnit.hpp"
+
+#include "connections.hpp"
+
+int main(int argc, char *argv[])
+{
+  bench_suite::instance().init(argc, argv);
+
+  bench_suite::instance().register_unit(new PrototypeBenchUnit());
+  bench_suite::instance().register_unit(new ContainerBenchUnit());
+  bench_suite::instance().register_unit(new StoreBenchUnit());
+  bench_suite::instance().register_unit(new TimeBenchUnit());
+  bench_suite::instance().register_unit(new SequencerBenchUnit());
+  bench_suite::instance().register_unit(new JsonBenchUnit());
+#ifdef OOS_MYSQL
+  bench_suite::instance().register_unit(new SessionBenchUnit("mysql", "mysql session bench unit", connection::mysql));
+#endif
+#ifdef OOS_ODBC
+  bench_suite::instance().register_unit(new SessionBenchUnit("mssql", "mssql session bench unit", connection::mssql));
+#endif
+#ifdef OOS_SQLITE3
+  bench_suite::instance().register_unit(new SQLiteBenchUnit("sqlite://bench.sqlite"));
+  bench_suite::instance().register_unit(new SessionBenchUnit("sqlite_session", "sqlite session bench unit", "sqlite://bench.sqlite"));
+#endif
+
+  bool result = bench_suite::instance().run();
+  return result ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench_suite.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+std::string escape(const std::string &str)
+{
+  std::string result;
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      default:
+        result += c;
+        break;
+    }
+  }
+  return result;
+}
+
+}
+
+bench_suite::bench_suite()
+  : cmd_(UNKNOWN)
+  , initialized_(false)
+{}
+
+bench_suite::~bench_suite()
+{
+  bench_unit_map_.clear();
+}
+
+void bench_suite::init(int argc, char *argv[])
+{
+  if (argc < 2) {
+    return;
+  }
+  std::string arg(argv[1]);
+
+  if (arg == "list") {
+    cmd_ = LIST;
+  } else if (arg == "exec") {
+    if (argc < 3) {
+      return;
+    }
+    cmd_ = EXECUTE;
+
+    std::string val(argv[2]);
+    if (val != "all") {
+      std::stringstream sval(val);
+      std::string part;
+      while (std::getline(sval, part, ',')) {
+        bench_unit_args args;
+        size_t pos = part.find(':');
+        if (pos == std::string::npos) {
+          args.unit = part;
+        } else {
+          args.unit = part.substr(0, pos);
+          std::stringstream benches(part.substr(pos + 1));
+          std::string bench;
+          while (std::getline(benches, bench, ':')) {
+            args.benches.push_back(bench);
+          }
+        }
+        unit_args_.push_back(args);
+      }
+    }
+    for (int i = 3; i < argc; ++i) {
+      std::string opt(argv[i]);
+      if (opt == "--json" && i + 1 < argc) {
+        json_file_ = argv[++i];
+      } else {
+        return;
+      }
+    }
+  } else {
+    return;
+  }
+  initialized_ = true;
+}
+
+void bench_suite::register_unit(bench_unit *unit)
+{
+  bench_unit_map_.insert(std::make_pair(unit->name(), bench_unit_ptr(unit)));
+}
+
+bool bench_suite::run()
+{
+  if (!initialized_) {
+    std::cout << "usage: bench_oos [list]|[exec <val> [--json <file>]]\n";
+    return true;
+  }
+  bool result = true;
+  switch (cmd_) {
+    case LIST:
+      for (t_bench_unit_map::const_iterator i = bench_unit_map_.begin(); i != bench_unit_map_.end(); ++i) {
+        std::cout << "Bench Unit [" << i->first << "] has the following benchmarks:\n";
+        i->second->list(std::cout);
+      }
+      break;
+    case EXECUTE:
+      if (unit_args_.empty()) {
+        for (t_bench_unit_map::const_iterator i = bench_unit_map_.begin(); i != bench_unit_map_.end(); ++i) {
+          if (!i->second->execute(results_)) {
+            result = false;
+          }
+        }
+      } else {
+        for (auto args : unit_args_) {
+          if (!run(args)) {
+            result = false;
+          }
+        }
+      }
+      break;
+    default:
+      break;
+  }
+  if (cmd_ == EXECUTE && !json_file_.empty()) {
+    std::ofstream out(json_file_.c_str());
+    if (!out) {
+      std::cout << "couldn't open json file [" << json_file_ << "]\n";
+      return false;
+    }
+    write_json(out);
+  }
+  return result;
+}
+
+const bench_unit::result_vector& bench_suite::results() const
+{
+  return results_;
+}
+
+void bench_suite::write_json(std::ostream &out) const
+{
+  out << "{\n  \"results\": [";
+  for (bench_unit::result_vector::const_iterator i = results_.begin(); i != results_.end(); ++i) {
+    double ns_per_op = i->ops ? i->nanoseconds / i->ops : 0.0;
+    double ops_per_sec = i->nanoseconds > 0 ? i->ops / (i->nanoseconds / 1e9) : 0.0;
+    double allocs_per_op = i->ops ? (double)i->allocations / i->ops : 0.0;
+    out << (i == results_.begin() ? "\n" : ",\n")
+        << "    { \"unit\": \"" << escape(i->unit) << "\""
+        << ", \"bench\": \"" << escape(i->bench) << "\""
+        << ", \"label\": \"" << escape(i->label) << "\""
+        << ", \"ops\": " << i->ops
+        << std::fixed << std::setprecision(1)
+        << ", \"ns\": " << i->nanoseconds
+        << ", \"ns_per_op\": " << ns_per_op
+        << ", \"ops_per_sec\": " << ops_per_sec
+        << std::setprecision(3)
+        << ", \"allocs_per_op\": " << allocs_per_op
+        << ", \"peak_rss\": " << i->peak_rss << " }";
+  }
+  out << "\n  ],\n  \"peak_rss\": " << bench_unit::peak_rss() << "\n}\n";
+}
+
+bool bench_suite::run(const bench_unit_args &args)
+{
+  t_bench_unit_map::const_iterator i = bench_unit_map_.find(args.unit);
+  if (i == bench_unit_map_.end()) {
+    std::cout << "couldn't find bench unit [" << args.unit << "]\n";
+    return false;
+  }
+  if (args.benches.empty()) {
+    return i->second->execute(results_);
+  }
+  bool result = true;
+  for (auto bench : args.benches) {
+    if (!i->second->execute(bench, results_)) {
+      result = false;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCH_SUITE_HPP
+#define BENCH_SUITE_HPP
+
+#include "bench_unit.hpp"
+
+#include "tools/singleton.hpp"
+
+#include <map>
+#include <ostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class bench_suite
+ * @brief The container for all bench units.
+ *
+ * The bench_suite is the benchmark counterpart of
+ * the test_suite. It is a singleton holding all
+ * bench_unit objects. It can list them or execute
+ * all, one or a single benchmark of a unit:
+ *
+ *   bench_oos list
+ *   bench_oos exec all
+ *   bench_oos exec <unit>[:<bench>[:<bench>]][,<unit>...]
+ *
+ * Appending --json <file> to an exec command writes
+ * all measurements as machine readable JSON to file.
+ */
+class bench_suite : public oos::singleton<bench_suite>
+{
+private:
+  friend class oos::singleton<bench_suite>;
+
+  typedef enum bench_suite_cmd_enum
+  {
+    UNKNOWN = 0,
+    LIST,
+    EXECUTE
+  } bench_suite_cmd;
+
+  struct bench_unit_args
+  {
+    std::string unit;
+    std::vector<std::string> benches;
+  };
+
+  bench_suite();
+
+  typedef std::shared_ptr<bench_unit> bench_unit_ptr;
+  typedef std::map<std::string, bench_unit_ptr> t_bench_unit_map;
+
+public:
+  virtual ~bench_suite();
+
+  /**
+   * Parses the command line arguments.
+   *
+   * @param argc Number of arguments.
+   * @param argv List of arguments.
+   */
+  void init(int argc, char *argv[]);
+
+  /**
+   * Registers a new bench_unit. The suite
+   * takes the ownership of the unit.
+   *
+   * @param unit The bench_unit to register.
+   */
+  void register_unit(bench_unit *unit);
+
+  /**
+   * Executes the command given via init.
+   *
+   * @return True if all benchmarks succeeded.
+   */
+  bool run();
+
+  /**
+   * Returns all measurements of the last run.
+   *
+   * @return All measurements.
+   */
+  const bench_unit::result_vector& results() const;
+
+  /**
+   * Writes all results as one JSON document
+   * to the given stream. Each measurement
+   * reports ops, ns/op, ops/s, allocs/op and
+   * the peak resident set size in bytes.
+   *
+   * @param out The stream to be written on.
+   */
+  void write_json(std::ostream &out) const;
+
+private:
+  bool run(const bench_unit_args &args);
+
+private:
+  bench_suite_cmd cmd_;
+  bool initialized_;
+  std::vector<bench_unit_args> unit_args_;
+  std::string json_file_;
+  t_bench_unit_map bench_unit_map_;
+  bench_unit::result_vector results_;
+};
+
+#endif /* BENCH_SUITE_HPP */
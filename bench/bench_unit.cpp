@@ -0,0 +1,213 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench_unit.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <iomanip>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+std::atomic<unsigned long> allocation_count(0);
+
+void* allocate(std::size_t size)
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void *p = std::malloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+}
+
+/*
+ * count all heap allocations of the
+ * benchmark process to report them
+ * for each measurement
+ */
+void* operator new(std::size_t size)
+{
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+  return allocate(size);
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+bench_unit::bench_unit(const std::string &name, const std::string &caption)
+  : name_(name)
+  , caption_(caption)
+  , current_(nullptr)
+  , results_(nullptr)
+{}
+
+bench_unit::~bench_unit()
+{}
+
+std::string bench_unit::name() const
+{
+  return name_;
+}
+
+std::string bench_unit::caption() const
+{
+  return caption_;
+}
+
+bool bench_unit::execute(result_vector &results)
+{
+  bool succeeded = true;
+  std::for_each(bench_func_infos_.begin(), bench_func_infos_.end(), [&](bench_func_info &info) {
+    if (!execute(info, results)) {
+      succeeded = false;
+    }
+  });
+  return succeeded;
+}
+
+bool bench_unit::execute(const std::string &bench, result_vector &results)
+{
+  t_bench_func_info_vector::iterator i = std::find_if(bench_func_infos_.begin(), bench_func_infos_.end(), [bench](const bench_func_info &x) {
+    return x.name == bench;
+  });
+  if (i == bench_func_infos_.end()) {
+    std::cout << "couldn't find benchmark [" << bench << "] of unit [" << caption_ << "]\n";
+    return false;
+  }
+  return execute(*i, results);
+}
+
+void bench_unit::list(std::ostream &out) const
+{
+  std::for_each(bench_func_infos_.begin(), bench_func_infos_.end(), [&](const bench_func_info &info) {
+    out << "Bench [" << info.name << "]: " << info.caption << std::endl;
+  });
+}
+
+void bench_unit::add_bench(const std::string &name, const bench_func &func, const std::string &caption)
+{
+  bench_func_infos_.push_back(bench_func_info(func, name, caption));
+}
+
+unsigned long bench_unit::allocations()
+{
+  return allocation_count.load(std::memory_order_relaxed);
+}
+
+unsigned long bench_unit::peak_rss()
+{
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return 0;
+  }
+  return (unsigned long)counters.PeakWorkingSetSize;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  // reported in bytes
+  return (unsigned long)usage.ru_maxrss;
+#else
+  // reported in kilobytes
+  return (unsigned long)usage.ru_maxrss * 1024UL;
+#endif
+#endif
+}
+
+void bench_unit::measure(const std::string &label, unsigned long ops, const std::function<void ()> &func)
+{
+  unsigned long allocated = allocations();
+  clock_type::time_point start = clock_type::now();
+  func();
+  clock_type::time_point stop = clock_type::now();
+  allocated = allocations() - allocated;
+
+  result r;
+  r.unit = name_;
+  r.bench = current_->name;
+  r.label = label;
+  r.ops = ops;
+  r.nanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+  r.allocations = allocated;
+  r.peak_rss = peak_rss();
+
+  std::cout << "  " << std::left << std::setw(40) << label
+            << std::right << std::setw(12) << ops << " ops "
+            << std::setw(12) << std::fixed << std::setprecision(1) << (ops ? r.nanoseconds / ops : 0.0) << " ns/op "
+            << std::setw(14) << std::setprecision(0) << (r.nanoseconds > 0 ? ops / (r.nanoseconds / 1e9) : 0.0) << " ops/s "
+            << std::setw(10) << std::setprecision(2) << (ops ? (double)allocated / ops : 0.0) << " allocs/op "
+            << std::setw(8) << r.peak_rss / (1024 * 1024) << " MB peak\n";
+
+  results_->push_back(r);
+}
+
+bool bench_unit::execute(bench_func_info &info, result_vector &results)
+{
+  bool succeeded = true;
+  current_ = &info;
+  results_ = &results;
+  std::cout << name_ << ":" << info.name << " (" << info.caption << ")\n" << std::flush;
+  initialize();
+  try {
+    info.func();
+  } catch (std::exception &ex) {
+    std::cout << "  FAILED: " << ex.what() << "\n";
+    succeeded = false;
+  }
+  finalize();
+  current_ = nullptr;
+  results_ = nullptr;
+  return succeeded;
+}
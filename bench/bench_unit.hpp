@@ -0,0 +1,174 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCH_UNIT_HPP
+#define BENCH_UNIT_HPP
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @class bench_unit
+ * @brief A bench_unit consists of several benchmarks.
+ *
+ * The bench_unit class is the base class for all
+ * benchmark units. It mirrors the unit_test class:
+ * derived classes add their benchmark methods in the
+ * constructor and each benchmark reports one or more
+ * measurements via measure().
+ */
+class bench_unit
+{
+public:
+  typedef std::function<void ()> bench_func;   /**< Shortcut for the benchmark function object. */
+  typedef std::chrono::high_resolution_clock clock_type; /**< Shortcut for the clock type. */
+
+  /**
+   * @brief A single measurement of a benchmark.
+   */
+  struct result
+  {
+    std::string unit;         /**< Name of the bench unit. */
+    std::string bench;        /**< Name of the benchmark. */
+    std::string label;        /**< Label of the measurement. */
+    unsigned long ops;        /**< Number of measured operations. */
+    double nanoseconds;       /**< Total duration in nanoseconds. */
+    unsigned long allocations; /**< Number of heap allocations. */
+    unsigned long peak_rss;   /**< Peak resident set size of the process in bytes. */
+  };
+
+  typedef std::vector<result> result_vector; /**< Shortcut for a vector of results. */
+
+  /**
+   * @brief Creates a bench_unit
+   *
+   * @param name The name of the bench_unit.
+   * @param caption The caption of the bench_unit.
+   */
+  bench_unit(const std::string &name, const std::string &caption);
+  virtual ~bench_unit();
+
+  /**
+   * Called before each executed benchmark.
+   */
+  virtual void initialize() = 0;
+
+  /**
+   * Called after each executed benchmark.
+   */
+  virtual void finalize() = 0;
+
+  /**
+   * Returns the name of the bench_unit.
+   *
+   * @return The name of the bench_unit.
+   */
+  std::string name() const;
+
+  /**
+   * Returns the caption of the bench_unit.
+   *
+   * @return The caption of the bench_unit.
+   */
+  std::string caption() const;
+
+  /**
+   * Executes all benchmarks of this unit.
+   *
+   * @param results The vector the measurements are appended to.
+   * @return True if all benchmarks succeeded.
+   */
+  bool execute(result_vector &results);
+
+  /**
+   * Executes the benchmark with the given name.
+   *
+   * @param bench Name of the benchmark to execute.
+   * @param results The vector the measurements are appended to.
+   * @return True if the benchmark succeeded.
+   */
+  bool execute(const std::string &bench, result_vector &results);
+
+  /**
+   * Lists all benchmarks to the given stream.
+   *
+   * @param out The stream to be written on.
+   */
+  void list(std::ostream &out) const;
+
+  /**
+   * Adds a benchmark to the unit.
+   *
+   * @param name Unique name of the benchmark.
+   * @param func The benchmark function object.
+   * @param caption A short description of the benchmark.
+   */
+  void add_bench(const std::string &name, const bench_func &func, const std::string &caption);
+
+  /**
+   * Returns the number of heap allocations
+   * done by the process so far.
+   *
+   * @return The number of heap allocations.
+   */
+  static unsigned long allocations();
+
+  /**
+   * Returns the peak resident set size
+   * of the process in bytes or zero if
+   * it can't be determined.
+   *
+   * @return The peak resident set size.
+   */
+  static unsigned long peak_rss();
+
+protected:
+  /**
+   * Measures the execution of the given function
+   * which executes the given number of operations.
+   *
+   * @param label Label of the measurement.
+   * @param ops Number of operations executed by func.
+   * @param func The function to measure.
+   */
+  void measure(const std::string &label, unsigned long ops, const std::function<void ()> &func);
+
+private:
+  struct bench_func_info
+  {
+    bench_func_info(const bench_func &f, const std::string &n, const std::string &c)
+      : func(f), name(n), caption(c)
+    {}
+    bench_func func;
+    std::string name;
+    std::string caption;
+  };
+  typedef std::vector<bench_func_info> t_bench_func_info_vector;
+
+  bool execute(bench_func_info &info, result_vector &results);
+
+private:
+  std::string name_;
+  std::string caption_;
+  t_bench_func_info_vector bench_func_infos_;
+  bench_func_info *current_;
+  result_vector *results_;
+};
+
+#endif /* BENCH_UNIT_HPP */
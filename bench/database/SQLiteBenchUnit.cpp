@@ -0,0 +1,105 @@
+#include "SQLiteBenchUnit.hpp"
+
+#include "../../test/Item.hpp"
+
+#include "database/session.hpp"
+#include "database/transaction.hpp"
+
+using namespace oos;
+
+SQLiteBenchUnit::SQLiteBenchUnit(const std::string &db)
+  : bench_unit("sqlite", "sqlite bench unit")
+  , db_(db)
+{
+  add_bench("time", std::bind(&SQLiteBenchUnit::time_storage, this), "insert and load 10k timestamps as text and native");
+  add_bench("commit", std::bind(&SQLiteBenchUnit::commit_mode, this), "commit 2k small transactions synchronously and asynchronously");
+}
+
+SQLiteBenchUnit::~SQLiteBenchUnit()
+{}
+
+void SQLiteBenchUnit::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+}
+
+void SQLiteBenchUnit::finalize()
+{
+  ostore_.clear(true);
+}
+
+void SQLiteBenchUnit::time_storage()
+{
+  insert_load("text");
+  insert_load("native");
+}
+
+void SQLiteBenchUnit::insert_load(const std::string &mode)
+{
+  const unsigned long count = 10000;
+
+  session db(ostore_, db_ + "?time=" + mode);
+  db.open();
+  db.create();
+
+  oos::time t(2015, 3, 15, 13, 56, 23, 123);
+
+  measure("insert " + mode, count, [&]() {
+    transaction tr(db);
+    tr.begin();
+    for (unsigned long i = 0; i < count; ++i) {
+      Item *item = new Item("item", (int)i);
+      item->set_time(t);
+      ostore_.insert(item);
+    }
+    tr.commit();
+  });
+
+  db.close();
+  ostore_.clear();
+  db.open();
+
+  measure("load " + mode, count, [&]() {
+    db.load();
+  });
+
+  db.drop();
+  db.close();
+  ostore_.clear();
+}
+
+void SQLiteBenchUnit::commit_mode()
+{
+  const unsigned long count = 2000;
+
+  session db(ostore_, db_);
+  db.open();
+  db.create();
+
+  // one item per transaction
+  auto run = [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      transaction tr(db);
+      tr.begin();
+      ostore_.insert(new Item("item", (int)i));
+      tr.commit();
+    }
+  };
+
+  measure("sync commit", count, run);
+
+  db.enable_async_commit();
+
+  measure("async commit", count, run);
+
+  measure("async commit and flush", count, [&]() {
+    run();
+    db.flush();
+  });
+
+  db.disable_async_commit();
+
+  db.drop();
+  db.close();
+  ostore_.clear();
+}
@@ -0,0 +1,28 @@
+#ifndef SQLITE_BENCHUNIT_HPP
+#define SQLITE_BENCHUNIT_HPP
+
+#include "../bench_unit.hpp"
+
+#include "object/object_store.hpp"
+
+class SQLiteBenchUnit : public bench_unit
+{
+public:
+  explicit SQLiteBenchUnit(const std::string &db);
+  virtual ~SQLiteBenchUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void time_storage();
+  void commit_mode();
+
+private:
+  void insert_load(const std::string &mode);
+
+private:
+  oos::object_store ostore_;
+  std::string db_;
+};
+
+#endif /* SQLITE_BENCHUNIT_HPP */
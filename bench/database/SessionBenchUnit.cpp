@@ -0,0 +1,290 @@
+#include "SessionBenchUnit.hpp"
+
+#include "../../test/Item.hpp"
+
+#include "database/session.hpp"
+#include "database/transaction.hpp"
+
+#include "object/object_view.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace oos;
+
+namespace {
+
+/*
+ * one distinct type per prototype
+ */
+template < int N >
+class TypedItem : public Item
+{
+public:
+  TypedItem() {}
+  TypedItem(const std::string &str, int i) : Item(str, i) {}
+  virtual ~TypedItem() {}
+};
+
+typedef void (*insert_func)(object_store &, int);
+
+template < int N >
+void insert_typed_item(object_store &ostore, int i)
+{
+  ostore.insert(new TypedItem<N>("typed", i));
+}
+
+template < int N >
+struct typed_prototypes
+{
+  static void insert(object_store &ostore, std::vector<insert_func> &inserter)
+  {
+    typed_prototypes<N - 1>::insert(ostore, inserter);
+    ostore.insert_prototype<TypedItem<N>, Item>(("typed_item_" + std::to_string(N)).c_str());
+    inserter.push_back(&insert_typed_item<N>);
+  }
+};
+
+template <>
+struct typed_prototypes<0>
+{
+  static void insert(object_store &, std::vector<insert_func> &) {}
+};
+
+}
+
+SessionBenchUnit::SessionBenchUnit(const std::string &name, const std::string &caption, const std::string &db)
+  : bench_unit(name, caption)
+  , db_(db)
+{
+  add_bench("commit", std::bind(&SessionBenchUnit::commit_load, this), "insert, update, load and delete 10k items");
+  add_bench("prototypes", std::bind(&SessionBenchUnit::commit_prototypes, this), "insert, update and delete 10k items of 50 prototypes");
+  add_bench("mixed", std::bind(&SessionBenchUnit::commit_mixed, this), "commit 10k interleaved inserts, updates and deletes");
+  add_bench("delete", std::bind(&SessionBenchUnit::delete_graph, this), "delete 5k object items with their 5k referred items");
+  add_bench("update", std::bind(&SessionBenchUnit::update_batch, this), "update 50k items of one type in one transaction");
+}
+
+SessionBenchUnit::~SessionBenchUnit()
+{}
+
+void SessionBenchUnit::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+}
+
+void SessionBenchUnit::finalize()
+{
+  ostore_.clear(true);
+}
+
+void SessionBenchUnit::commit_load()
+{
+  typedef object_view<Item> item_view_t;
+
+  const unsigned long count = 10000;
+
+  session db(ostore_, db_);
+  db.open();
+  db.create();
+
+  transaction tr(db);
+
+  measure("insert and commit", count, [&]() {
+    tr.begin();
+    for (unsigned long i = 0; i < count; ++i) {
+      ostore_.insert(new Item("item", (int)i));
+    }
+    tr.commit();
+  });
+
+  item_view_t view(ostore_);
+
+  measure("update and commit", count, [&]() {
+    tr.begin();
+    for (item_view_t::iterator i = view.begin(); i != view.end(); ++i) {
+      (*i)->set_int((*i)->get_int() + 1);
+    }
+    tr.commit();
+  });
+
+  db.close();
+  ostore_.clear();
+  db.open();
+
+  measure("load", count, [&]() {
+    db.load();
+  });
+
+  measure("delete and commit", count, [&]() {
+    std::vector<object_ptr<Item> > items(view.begin(), view.end());
+    tr.begin();
+    for (object_ptr<Item> &item : items) {
+      ostore_.remove(item);
+    }
+    tr.commit();
+  });
+
+  db.drop();
+  db.close();
+}
+
+void SessionBenchUnit::commit_prototypes()
+{
+  const unsigned long count = 10000;
+
+  object_store ostore;
+  ostore.insert_prototype<Item>("item", true);
+  std::vector<insert_func> inserter;
+  typed_prototypes<50>::insert(ostore, inserter);
+
+  session db(ostore, db_);
+  db.open();
+  db.create();
+
+  transaction tr(db);
+
+  measure("insert and commit", count, [&]() {
+    tr.begin();
+    for (unsigned long i = 0; i < count; ++i) {
+      inserter[i % inserter.size()](ostore, (int)i);
+    }
+    tr.commit();
+  });
+
+  // all items interleaved by type
+  std::vector<object_ptr<Item> > items;
+  object_view<Item> view(ostore);
+  items.assign(view.begin(), view.end());
+
+  measure("update and commit", count, [&]() {
+    tr.begin();
+    for (object_ptr<Item> &item : items) {
+      item->set_int(item->get_int() + 1);
+    }
+    tr.commit();
+  });
+
+  measure("delete and commit", count, [&]() {
+    tr.begin();
+    for (object_ptr<Item> &item : items) {
+      ostore.remove(item);
+    }
+    tr.commit();
+  });
+
+  db.drop();
+  db.close();
+}
+
+void SessionBenchUnit::commit_mixed()
+{
+  typedef ObjectItem<Item> object_item_t;
+
+  const unsigned long count = 10000;
+
+  object_store ostore;
+  ostore.insert_prototype<Item>("item");
+  ostore.insert_prototype<object_item_t, Item>("object_item");
+
+  session db(ostore, db_);
+  db.open();
+  db.create();
+
+  transaction tr(db);
+
+  std::vector<object_ptr<Item> > items;
+  tr.begin();
+  for (unsigned long i = 0; i < count; ++i) {
+    items.push_back(ostore.insert(new Item("item", (int)i)));
+  }
+  tr.commit();
+
+  // insert object item, update item, insert item,
+  // delete item as the observers report them
+  measure("interleaved commit", count, [&]() {
+    tr.begin();
+    for (unsigned long i = 0; i + 1 < count; i += 4) {
+      ostore.insert(new object_item_t("object item", (int)i));
+      items[i]->set_int((int)i + 1);
+      ostore.insert(new Item("inserted", (int)i));
+      ostore.remove(items[i + 1]);
+    }
+    tr.commit();
+  });
+
+  db.drop();
+  db.close();
+}
+
+void SessionBenchUnit::delete_graph()
+{
+  typedef ObjectItem<Item> object_item_t;
+  typedef object_ptr<object_item_t> object_item_ptr;
+
+  const unsigned long count = 5000;
+
+  object_store ostore;
+  ostore.insert_prototype<Item>("item");
+  ostore.insert_prototype<object_item_t, Item>("object_item");
+
+  session db(ostore, db_);
+  db.open();
+  db.create();
+
+  transaction tr(db);
+
+  std::vector<object_item_ptr> object_items;
+  tr.begin();
+  for (unsigned long i = 0; i < count; ++i) {
+    object_item_ptr oi = ostore.insert(new object_item_t("object item", (int)i));
+    oi->ptr(ostore.insert(new Item("item", (int)i)));
+    object_items.push_back(oi);
+  }
+  tr.commit();
+
+  // removing an object item removes its item as well
+  measure("delete graph and commit", 2 * count, [&]() {
+    tr.begin();
+    for (object_item_ptr &oi : object_items) {
+      ostore.remove(oi);
+    }
+    tr.commit();
+  });
+
+  db.drop();
+  db.close();
+}
+
+void SessionBenchUnit::update_batch()
+{
+  const unsigned long count = 50000;
+
+  object_store ostore;
+  ostore.insert_prototype<Item>("item");
+
+  session db(ostore, db_);
+  db.open();
+  db.create();
+
+  transaction tr(db);
+
+  std::vector<object_ptr<Item> > items;
+  tr.begin();
+  for (unsigned long i = 0; i < count; ++i) {
+    items.push_back(ostore.insert(new Item("item", (int)i)));
+  }
+  tr.commit();
+
+  for (int round = 0; round < 3; ++round) {
+    measure("update and commit", count, [&]() {
+      tr.begin();
+      for (object_ptr<Item> &item : items) {
+        item->set_int(item->get_int() + 1);
+      }
+      tr.commit();
+    });
+  }
+
+  db.drop();
+  db.close();
+}
@@ -0,0 +1,28 @@
+#ifndef SESSION_BENCHUNIT_HPP
+#define SESSION_BENCHUNIT_HPP
+
+#include "../bench_unit.hpp"
+
+#include "object/object_store.hpp"
+
+class SessionBenchUnit : public bench_unit
+{
+public:
+  SessionBenchUnit(const std::string &name, const std::string &caption, const std::string &db);
+  virtual ~SessionBenchUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void commit_load();
+  void commit_prototypes();
+  void commit_mixed();
+  void delete_graph();
+  void update_batch();
+
+private:
+  oos::object_store ostore_;
+  std::string db_;
+};
+
+#endif /* SESSION_BENCHUNIT_HPP */
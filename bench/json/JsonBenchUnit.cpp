@@ -0,0 +1,84 @@
+#include "JsonBenchUnit.hpp"
+
+#include "json/json.hpp"
+
+#include <sstream>
+
+using namespace oos;
+
+namespace {
+
+const unsigned long record_count = 10000;
+
+}
+
+JsonBenchUnit::JsonBenchUnit()
+  : bench_unit("json", "json bench unit")
+{
+  add_bench("parse", std::bind(&JsonBenchUnit::parse_document, this), "parse a document of 10k records");
+  add_bench("print", std::bind(&JsonBenchUnit::print_document, this), "print a document of 10k records");
+}
+
+JsonBenchUnit::~JsonBenchUnit()
+{}
+
+void JsonBenchUnit::initialize()
+{
+  // an array of flat records mixing all
+  // json types in the layout the parser
+  // reads and the printer writes
+  std::stringstream doc;
+  doc << "[ ";
+  for (unsigned long i = 0; i < record_count; ++i) {
+    doc << (i ? ", " : "")
+        << "{ \"id\" : " << i
+        << ", \"name\" : \"item " << i << "\""
+        << ", \"price\" : " << i * 0.25
+        << ", \"active\" : " << (i % 2 ? "true" : "false")
+        << ", \"parent\" : null"
+        << ", \"tags\" : [ \"a\", \"b\", " << i % 7 << " ] }";
+  }
+  doc << " ]";
+  document_ = doc.str();
+}
+
+void JsonBenchUnit::finalize()
+{
+  document_.clear();
+}
+
+void JsonBenchUnit::parse_document()
+{
+  const unsigned long passes = 10;
+
+  json_parser parser;
+
+  measure("parse records", record_count * passes, [&]() {
+    for (unsigned long p = 0; p < passes; ++p) {
+      json_value value = parser.parse(document_.c_str());
+    }
+  });
+}
+
+void JsonBenchUnit::print_document()
+{
+  const unsigned long passes = 10;
+
+  json_parser parser;
+  json_value value = parser.parse(document_.c_str());
+
+  measure("print records", record_count * passes, [&]() {
+    for (unsigned long p = 0; p < passes; ++p) {
+      std::stringstream out;
+      out << value;
+    }
+  });
+
+  measure("round trip records", record_count * passes, [&]() {
+    for (unsigned long p = 0; p < passes; ++p) {
+      std::stringstream out;
+      out << parser.parse(document_.c_str());
+      json_value copy = parser.parse(out.str().c_str());
+    }
+  });
+}
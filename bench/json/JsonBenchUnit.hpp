@@ -0,0 +1,24 @@
+#ifndef JSON_BENCHUNIT_HPP
+#define JSON_BENCHUNIT_HPP
+
+#include "../bench_unit.hpp"
+
+#include <string>
+
+class JsonBenchUnit : public bench_unit
+{
+public:
+  JsonBenchUnit();
+  virtual ~JsonBenchUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void parse_document();
+  void print_document();
+
+private:
+  std::string document_;
+};
+
+#endif /* JSON_BENCHUNIT_HPP */
@@ -0,0 +1,107 @@
+#include "ContainerBenchUnit.hpp"
+
+#include "../../test/Item.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace oos;
+
+ContainerBenchUnit::ContainerBenchUnit()
+  : bench_unit("container", "object container bench unit")
+{
+  add_bench("vector", std::bind(&ContainerBenchUnit::build_vector, this), "build a vector of 1M elements");
+  add_bench("list", std::bind(&ContainerBenchUnit::relink_list, this), "reorder linked lists of 100k elements");
+}
+
+ContainerBenchUnit::~ContainerBenchUnit()
+{}
+
+void ContainerBenchUnit::initialize()
+{
+  ostore_.insert_prototype<IntVector>("item_int_vector");
+  ostore_.insert_prototype<LinkedIntList>("LINKED_INT_LIST");
+}
+
+void ContainerBenchUnit::finalize()
+{
+  ostore_.clear(true);
+}
+
+void ContainerBenchUnit::build_vector()
+{
+  const unsigned long count = 1000000;
+
+  std::vector<int> values;
+  values.reserve(count);
+  for (unsigned long i = 0; i < count; ++i) {
+    values.push_back((int)i);
+  }
+
+  object_ptr<IntVector> pushed = ostore_.insert(new IntVector);
+  measure("push_back", count, [&]() {
+    for (int value : values) {
+      pushed->push_back(value);
+    }
+  });
+  // start the bulk run on an empty store
+  pushed.reset();
+  ostore_.clear();
+
+  object_ptr<IntVector> bulk = ostore_.insert(new IntVector);
+  measure("reserve and bulk insert", count, [&]() {
+    bulk->reserve(count);
+    bulk->insert(bulk->end(), values.begin(), values.end());
+  });
+
+  std::vector<unsigned long> ids;
+  ids.reserve(count);
+  measure("collect item ids", count, [&]() {
+    bulk->ids(std::back_inserter(ids));
+  });
+}
+
+void ContainerBenchUnit::relink_list()
+{
+  const unsigned long count = 100000;
+
+  std::vector<int> values;
+  values.reserve(count);
+  for (unsigned long i = 0; i < count; ++i) {
+    values.push_back((int)i);
+  }
+  std::shuffle(values.begin(), values.end(), std::mt19937(42));
+
+  object_ptr<LinkedIntList> first = ostore_.insert(new LinkedIntList);
+  object_ptr<LinkedIntList> second = ostore_.insert(new LinkedIntList);
+  for (int value : values) {
+    first->push_back(value);
+  }
+
+  measure("sort", count, [&]() {
+    first->sort();
+  });
+
+  measure("reverse", count, [&]() {
+    first->reverse();
+  });
+
+  measure("splice into other list", count, [&]() {
+    second->splice(second->end(), *first);
+  });
+
+  measure("splice within list", count, [&]() {
+    LinkedIntList::iterator middle = second->begin();
+    std::advance(middle, count / 2);
+    second->splice(second->begin(), *second, middle, second->end());
+  });
+
+  measure("move by erase and push_back", count, [&]() {
+    LinkedIntList::iterator i = second->begin();
+    while (i != second->end()) {
+      first->push_back(i->value());
+      i = second->erase(i);
+    }
+  });
+}
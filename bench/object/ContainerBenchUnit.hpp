@@ -0,0 +1,24 @@
+#ifndef CONTAINER_BENCHUNIT_HPP
+#define CONTAINER_BENCHUNIT_HPP
+
+#include "../bench_unit.hpp"
+
+#include "object/object_store.hpp"
+
+class ContainerBenchUnit : public bench_unit
+{
+public:
+  ContainerBenchUnit();
+  virtual ~ContainerBenchUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void build_vector();
+  void relink_list();
+
+private:
+  oos::object_store ostore_;
+};
+
+#endif /* CONTAINER_BENCHUNIT_HPP */
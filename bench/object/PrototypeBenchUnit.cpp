@@ -0,0 +1,122 @@
+#include "PrototypeBenchUnit.hpp"
+
+#include "object/object.hpp"
+#include "object/object_atomizer.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace oos;
+
+namespace {
+
+const int PROTOTYPE_COUNT = 64;
+
+template < int N >
+class BenchItem : public object
+{
+public:
+  BenchItem() : value_(N) {}
+  virtual ~BenchItem() {}
+
+  virtual void deserialize(object_reader &deserializer)
+  {
+    object::deserialize(deserializer);
+    deserializer.read("value", value_);
+  }
+  virtual void serialize(object_writer &serializer) const
+  {
+    object::serialize(serializer);
+    serializer.write("value", value_);
+  }
+
+private:
+  int value_;
+};
+
+template < int N >
+struct prototype_inserter
+{
+  static void insert(object_store &ostore)
+  {
+    prototype_inserter<N - 1>::insert(ostore);
+    std::stringstream type;
+    type << "bench_item_" << N;
+    ostore.insert_prototype<BenchItem<N> >(type.str().c_str());
+  }
+};
+
+template <>
+struct prototype_inserter<0>
+{
+  static void insert(object_store &) {}
+};
+
+}
+
+PrototypeBenchUnit::PrototypeBenchUnit()
+  : bench_unit("prototype", "prototype bench unit")
+{
+  add_bench("find", std::bind(&PrototypeBenchUnit::find_prototype, this), "find prototype by type name and by type info");
+  add_bench("insert", std::bind(&PrototypeBenchUnit::insert_objects, this), "insert objects with 64 registered prototypes");
+}
+
+PrototypeBenchUnit::~PrototypeBenchUnit()
+{}
+
+void PrototypeBenchUnit::initialize()
+{
+  prototype_inserter<PROTOTYPE_COUNT>::insert(ostore_);
+}
+
+void PrototypeBenchUnit::finalize()
+{
+  ostore_.clear(true);
+}
+
+void PrototypeBenchUnit::find_prototype()
+{
+  const unsigned long count = 1000000;
+  prototype_tree &ptree = ostore_.prototypes();
+
+  const char *name = typeid(BenchItem<PROTOTYPE_COUNT / 2>).name();
+  unsigned long found = 0;
+  measure("find by typeid name", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      found += ptree.find(name)->depth;
+    }
+  });
+  measure("find by type info", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      found += ptree.find(typeid(BenchItem<PROTOTYPE_COUNT / 2>))->depth;
+    }
+  });
+  if (found != 2 * count) {
+    throw std::logic_error("unexpected prototype depth");
+  }
+}
+
+void PrototypeBenchUnit::insert_objects()
+{
+  const unsigned long count = 200000;
+
+  // create objects of eight different types up front
+  std::vector<std::string> types;
+  for (int i = 1; i <= PROTOTYPE_COUNT; i += PROTOTYPE_COUNT / 8) {
+    std::stringstream type;
+    type << "bench_item_" << i;
+    types.push_back(type.str());
+  }
+  std::vector<object*> objects;
+  objects.reserve(count);
+  for (unsigned long i = 0; i < count; ++i) {
+    objects.push_back(ostore_.create(types[i % types.size()].c_str()));
+  }
+
+  measure("insert", count, [&]() {
+    for (object *o : objects) {
+      ostore_.insert(o);
+    }
+  });
+}
@@ -0,0 +1,24 @@
+#ifndef PROTOTYPE_BENCHUNIT_HPP
+#define PROTOTYPE_BENCHUNIT_HPP
+
+#include "../bench_unit.hpp"
+
+#include "object/object_store.hpp"
+
+class PrototypeBenchUnit : public bench_unit
+{
+public:
+  PrototypeBenchUnit();
+  virtual ~PrototypeBenchUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void find_prototype();
+  void insert_objects();
+
+private:
+  oos::object_store ostore_;
+};
+
+#endif /* PROTOTYPE_BENCHUNIT_HPP */
@@ -0,0 +1,484 @@
+#include "StoreBenchUnit.hpp"
+
+#include "../../test/Item.hpp"
+
+#include "object/object_serializer.hpp"
+
+#include "database/session.hpp"
+#include "database/transaction.hpp"
+
+#include "object/object_view.hpp"
+
+#include "tools/byte_buffer.hpp"
+#include "tools/shared_mutex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace oos;
+
+StoreBenchUnit::StoreBenchUnit()
+  : bench_unit("store", "object store bench unit")
+{
+  add_bench("remove", std::bind(&StoreBenchUnit::remove_tree, this), "remove an object tree of 100k objects");
+  add_bench("attribute", std::bind(&StoreBenchUnit::named_attribute, this), "set and get attributes by name");
+  add_bench("commit", std::bind(&StoreBenchUnit::commit_load, this), "commit and restore 10k modified items");
+  add_bench("transaction", std::bind(&StoreBenchUnit::insert_delete, this), "insert 100k items and delete half of them in one transaction");
+  add_bench("journal", std::bind(&StoreBenchUnit::journal_commit, this), "commit 2k small transactions to the journal");
+  add_bench("concurrent", std::bind(&StoreBenchUnit::concurrent_access, this), "many readers iterate 10k items while one writer modifies");
+  add_bench("scale", std::bind(&StoreBenchUnit::insert_find_remove, this), "insert, find and remove 10k up to 1M items");
+  add_bench("view", std::bind(&StoreBenchUnit::view_access, this), "iterate and search an object view of 100k items");
+  add_bench("ptr", std::bind(&StoreBenchUnit::ptr_churn, this), "copy, assign and release object pointers");
+  add_bench("serializer", std::bind(&StoreBenchUnit::serializer_round_trip, this), "serialize and deserialize items and object items");
+}
+
+StoreBenchUnit::~StoreBenchUnit()
+{}
+
+void StoreBenchUnit::initialize()
+{
+  ostore_.insert_prototype<Item>("ITEM");
+  ostore_.insert_prototype<ObjectItem<Item> >("OBJECT_ITEM");
+  ostore_.insert_prototype<ItemPtrList>("ITEM_PTR_LIST");
+}
+
+void StoreBenchUnit::finalize()
+{
+  ostore_.clear(true);
+}
+
+void StoreBenchUnit::remove_tree()
+{
+  const unsigned long count = 50000;
+
+  // the list, its items and the
+  // pointed items form the tree
+  object_ptr<ItemPtrList> itemlist = ostore_.insert(new ItemPtrList);
+  for (unsigned long i = 0; i < count; ++i) {
+    itemlist->push_back(ostore_.insert(new Item("item", (int)i)));
+  }
+
+  measure("check removable", 2 * count, [&]() {
+    ostore_.is_removable(itemlist);
+  });
+
+  measure("check removable again", 2 * count, [&]() {
+    ostore_.is_removable(itemlist);
+  });
+
+  measure("remove", 2 * count, [&]() {
+    ostore_.remove(itemlist);
+  });
+}
+
+void StoreBenchUnit::named_attribute()
+{
+  const unsigned long count = 1000000;
+
+  Item item("item", 4711);
+  const std::string name("val_varchar");
+  const std::string value("hello");
+  std::string result;
+
+  measure("set by serialization", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      attribute_reader<std::string> reader(name, value);
+      item.deserialize(reader);
+    }
+  });
+
+  measure("set by attribute table", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      item.set(name, value);
+    }
+  });
+
+  measure("get by serialization", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      attribute_writer<std::string> writer(name, result);
+      item.serialize(writer);
+    }
+  });
+
+  measure("get by attribute table", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      item.get(name, result);
+    }
+  });
+}
+
+void StoreBenchUnit::commit_load()
+{
+  const unsigned long count = 10000;
+
+  session db(ostore_, "memory://");
+  db.open();
+  db.create();
+
+  std::vector<object_ptr<Item> > items;
+  items.reserve(count);
+
+  transaction tr(db);
+  tr.begin();
+  for (unsigned long i = 0; i < count; ++i) {
+    items.push_back(ostore_.insert(new Item("item", (int)i)));
+  }
+  tr.commit();
+
+  varchar<64> value("The answer is 42");
+
+  measure("modify and commit", count, [&]() {
+    tr.begin();
+    for (unsigned long i = 0; i < count; ++i) {
+      items[i]->set_varchar(value);
+    }
+    tr.commit();
+  });
+
+  measure("modify and rollback", count, [&]() {
+    tr.begin();
+    for (unsigned long i = 0; i < count; ++i) {
+      items[i]->set_varchar(value);
+    }
+    tr.rollback();
+  });
+
+  object_serializer serializer;
+  byte_buffer buffer;
+
+  measure("serialize", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      serializer.serialize(items[i].get(), &buffer);
+    }
+  });
+
+  measure("deserialize", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      serializer.deserialize(items[i].get(), &buffer, &ostore_);
+    }
+  });
+
+  items.clear();
+  db.close();
+}
+
+void StoreBenchUnit::insert_delete()
+{
+  const unsigned long count = 100000;
+
+  session db(ostore_, "memory://");
+  db.open();
+  db.create();
+
+  std::vector<object_ptr<Item> > items;
+  items.reserve(count);
+
+  transaction tr(db);
+
+  measure("insert, delete and commit", count + count / 2, [&]() {
+    tr.begin();
+    for (unsigned long i = 0; i < count; ++i) {
+      items.push_back(ostore_.insert(new Item("item", (int)i)));
+    }
+    for (unsigned long i = 0; i < count; i += 2) {
+      ostore_.remove(items[i]);
+    }
+    tr.commit();
+  });
+
+  items.clear();
+
+  measure("insert, delete and rollback", count + count / 2, [&]() {
+    tr.begin();
+    for (unsigned long i = 0; i < count; ++i) {
+      items.push_back(ostore_.insert(new Item("item", (int)i)));
+    }
+    for (unsigned long i = 0; i < count; i += 2) {
+      ostore_.remove(items[i]);
+    }
+    tr.rollback();
+  });
+
+  items.clear();
+  db.close();
+  ostore_.clear();
+}
+
+void StoreBenchUnit::journal_commit()
+{
+  const unsigned long count = 2000;
+
+  session db(ostore_, "journal://bench.journal");
+  db.open();
+  db.create();
+
+  // one item per transaction
+  auto run = [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      transaction tr(db);
+      tr.begin();
+      ostore_.insert(new Item("item", (int)i));
+      tr.commit();
+    }
+  };
+
+  measure("sync commit", count, run);
+
+  db.enable_async_commit();
+
+  measure("async commit and flush", count, [&]() {
+    run();
+    db.flush();
+  });
+
+  db.disable_async_commit();
+
+  db.close();
+  ostore_.clear();
+  db.open();
+
+  measure("replay", 2 * count, [&]() {
+    db.load();
+  });
+
+  db.drop();
+  db.close();
+}
+
+void StoreBenchUnit::concurrent_access()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> item_view_t;
+
+  const unsigned long count = 10000;
+  const unsigned long passes = 50;
+
+  for (unsigned long i = 0; i < count; ++i) {
+    ostore_.insert(new Item("item", (int)i));
+  }
+  item_view_t view(ostore_);
+
+  // each reader iterates the view and resolves every
+  // object pointer; one writer modifies, inserts and
+  // removes items until all readers are done
+  auto run = [&](unsigned int reader_count, bool exclusive) {
+    std::atomic<unsigned int> running(reader_count);
+    std::vector<std::thread> readers;
+    for (unsigned int r = 0; r < reader_count; ++r) {
+      readers.push_back(std::thread([&]() {
+        long sum = 0;
+        for (unsigned long p = 0; p < passes; ++p) {
+          std::unique_ptr<shared_lock> shared;
+          std::unique_lock<shared_mutex> unique(ostore_.mutex(), std::defer_lock);
+          if (exclusive) {
+            unique.lock();
+          } else {
+            shared.reset(new shared_lock(ostore_.mutex()));
+          }
+          for (item_view_t::const_iterator i = view.begin(); i != view.end(); ++i) {
+            const item_ptr item = *i;
+            sum += item->get_int();
+          }
+        }
+        --running;
+        (void)sum;
+      }));
+    }
+    unsigned long n = 0;
+    while (running > 0) {
+      std::lock_guard<shared_mutex> l(ostore_.mutex());
+      item_ptr item = view.front();
+      item->set_int(item->get_int() + 1);
+      item = ostore_.insert(new Item("extra", (int)n++));
+      ostore_.remove(item);
+    }
+    for (std::thread &t : readers) {
+      t.join();
+    }
+  };
+
+  measure("1 reader, 1 writer", count * passes, [&]() { run(1, false); });
+  measure("2 readers, 1 writer", 2 * count * passes, [&]() { run(2, false); });
+  measure("4 readers, 1 writer", 4 * count * passes, [&]() { run(4, false); });
+  measure("4 exclusive readers, 1 writer", 4 * count * passes, [&]() { run(4, true); });
+  measure("8 readers, 1 writer", 8 * count * passes, [&]() { run(8, false); });
+}
+
+void StoreBenchUnit::insert_find_remove()
+{
+  const unsigned long counts[] = { 10000, 100000, 1000000 };
+
+  for (unsigned long count : counts) {
+    std::vector<long> ids;
+    ids.reserve(count);
+    const std::string suffix(" " + std::to_string(count));
+
+    measure("insert" + suffix, count, [&]() {
+      for (unsigned long i = 0; i < count; ++i) {
+        ids.push_back(ostore_.insert(new Item("item", (int)i)).id());
+      }
+    });
+
+    // visit the ids in a scattered order
+    // to defeat the locality of insertion
+    std::vector<long> order(ids);
+    for (unsigned long i = 0; i < count; ++i) {
+      std::swap(order[i], order[(i * 7919) % count]);
+    }
+
+    measure("find" + suffix, count, [&]() {
+      unsigned long found = 0;
+      for (long id : order) {
+        if (ostore_.find_proxy(id)) {
+          ++found;
+        }
+      }
+      if (found != count) {
+        throw std::logic_error("couldn't find all items");
+      }
+    });
+
+    measure("remove" + suffix, count, [&]() {
+      for (long id : order) {
+        object_ptr<Item> item(ostore_.find_proxy(id));
+        ostore_.remove(item);
+      }
+    });
+
+    ostore_.clear();
+  }
+}
+
+void StoreBenchUnit::view_access()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> item_view_t;
+
+  const unsigned long count = 100000;
+  const unsigned long passes = 10;
+
+  for (unsigned long i = 0; i < count; ++i) {
+    ostore_.insert(new Item("item", (int)i));
+  }
+  item_view_t view(ostore_);
+
+  measure("iterate", count * passes, [&]() {
+    long sum = 0;
+    for (unsigned long p = 0; p < passes; ++p) {
+      for (item_view_t::const_iterator i = view.begin(); i != view.end(); ++i) {
+        sum += (*i)->get_int();
+      }
+    }
+    (void)sum;
+  });
+
+  measure("find_if last", count * passes, [&]() {
+    for (unsigned long p = 0; p < passes; ++p) {
+      const int last = (int)count - 1;
+      if (view.find_if([last](const item_ptr &item) { return item->get_int() == last; }) == view.end()) {
+        throw std::logic_error("couldn't find last item");
+      }
+    }
+  });
+
+  measure("size", passes, [&]() {
+    for (unsigned long p = 0; p < passes; ++p) {
+      if (view.size() != count) {
+        throw std::logic_error("unexpected view size");
+      }
+    }
+  });
+}
+
+void StoreBenchUnit::ptr_churn()
+{
+  typedef object_ptr<Item> item_ptr;
+
+  const unsigned long count = 1000;
+  const unsigned long passes = 1000;
+
+  std::vector<item_ptr> items;
+  items.reserve(count);
+  for (unsigned long i = 0; i < count; ++i) {
+    items.push_back(ostore_.insert(new Item("item", (int)i)));
+  }
+
+  measure("copy and release", count * passes, [&]() {
+    for (unsigned long p = 0; p < passes; ++p) {
+      std::vector<item_ptr> copies(items);
+    }
+  });
+
+  std::vector<item_ptr> targets(count);
+
+  measure("assign", count * passes, [&]() {
+    for (unsigned long p = 0; p < passes; ++p) {
+      for (unsigned long i = 0; i < count; ++i) {
+        targets[i] = items[(i + p) % count];
+      }
+    }
+  });
+
+  measure("convert to reference", count * passes, [&]() {
+    for (unsigned long p = 0; p < passes; ++p) {
+      for (unsigned long i = 0; i < count; ++i) {
+        object_ref<Item> ref(items[i]);
+      }
+    }
+  });
+
+  targets.clear();
+  items.clear();
+}
+
+void StoreBenchUnit::serializer_round_trip()
+{
+  typedef ObjectItem<Item> object_item;
+
+  const unsigned long count = 100000;
+
+  std::vector<object_ptr<Item> > items;
+  std::vector<object_ptr<object_item> > object_items;
+  items.reserve(count);
+  object_items.reserve(count);
+  for (unsigned long i = 0; i < count; ++i) {
+    items.push_back(ostore_.insert(new Item("item", (int)i)));
+    object_item *oi = new object_item("object item", (int)i);
+    oi->ptr(items.back());
+    object_items.push_back(ostore_.insert(oi));
+  }
+
+  object_serializer serializer;
+  byte_buffer buffer;
+
+  // restore the stored objects from
+  // their own images like a rollback
+  measure("item round trip", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      serializer.serialize(items[i].get(), &buffer);
+      serializer.deserialize(items[i].get(), &buffer, &ostore_);
+    }
+  });
+
+  measure("object item round trip", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      serializer.serialize(object_items[i].get(), &buffer);
+      serializer.deserialize(object_items[i].get(), &buffer, &ostore_);
+    }
+  });
+
+  // restore into fresh objects without
+  // a store like the commit pipeline
+  measure("detached round trip", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      serializer.serialize(object_items[i].get(), &buffer);
+      object_proxy proxy(new object_item, nullptr);
+      serializer.deserialize(proxy.obj, &buffer, nullptr);
+    }
+  });
+
+  object_items.clear();
+  items.clear();
+}
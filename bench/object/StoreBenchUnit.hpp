@@ -0,0 +1,32 @@
+#ifndef STORE_BENCHUNIT_HPP
+#define STORE_BENCHUNIT_HPP
+
+#include "../bench_unit.hpp"
+
+#include "object/object_store.hpp"
+
+class StoreBenchUnit : public bench_unit
+{
+public:
+  StoreBenchUnit();
+  virtual ~StoreBenchUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void remove_tree();
+  void named_attribute();
+  void commit_load();
+  void insert_delete();
+  void journal_commit();
+  void concurrent_access();
+  void insert_find_remove();
+  void view_access();
+  void ptr_churn();
+  void serializer_round_trip();
+
+private:
+  oos::object_store ostore_;
+};
+
+#endif /* STORE_BENCHUNIT_HPP */
@@ -0,0 +1,135 @@
+#include "SequencerBenchUnit.hpp"
+
+#include "tools/sequencer.hpp"
+
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace oos;
+
+namespace {
+
+/*
+ * the default sequencer guarded by
+ * a mutex for comparison
+ */
+class locked_sequencer : public sequencer_impl
+{
+public:
+  virtual ~locked_sequencer() {}
+
+  virtual long init() { std::lock_guard<std::mutex> l(mutex_); return seq_.init(); }
+  virtual long reset(long id) { std::lock_guard<std::mutex> l(mutex_); return seq_.reset(id); }
+  virtual long next() { std::lock_guard<std::mutex> l(mutex_); return seq_.next(); }
+  virtual long current() const { std::lock_guard<std::mutex> l(mutex_); return seq_.current(); }
+  virtual long update(long id) { std::lock_guard<std::mutex> l(mutex_); return seq_.update(id); }
+
+private:
+  mutable std::mutex mutex_;
+  default_sequencer seq_;
+};
+
+long allocate(sequencer &seq, unsigned long threads, unsigned long count)
+{
+  std::vector<long> last(threads, 0);
+  std::vector<std::thread> workers;
+  for (unsigned long t = 0; t < threads; ++t) {
+    workers.push_back(std::thread([&seq, &last, t, count, threads]() {
+      long id = 0;
+      for (unsigned long i = 0; i < count / threads; ++i) {
+        id = seq.next();
+      }
+      last[t] = id;
+    }));
+  }
+  long total = 0;
+  for (unsigned long t = 0; t < threads; ++t) {
+    workers[t].join();
+    total += last[t];
+  }
+  return total;
+}
+
+}
+
+SequencerBenchUnit::SequencerBenchUnit()
+  : bench_unit("sequencer", "sequencer bench unit")
+{
+  add_bench("next", std::bind(&SequencerBenchUnit::next, this), "allocate 10m ids in one thread");
+  add_bench("concurrent", std::bind(&SequencerBenchUnit::concurrent, this), "allocate 8m ids in 1, 2, 4 and 8 threads");
+}
+
+SequencerBenchUnit::~SequencerBenchUnit()
+{}
+
+void SequencerBenchUnit::next()
+{
+  const unsigned long count = 10000000;
+
+  long total = 0;
+
+  sequencer plain;
+  measure("default", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      total += plain.next();
+    }
+  });
+
+  sequencer locked(sequencer_impl_ptr(new locked_sequencer));
+  measure("mutex", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      total += locked.next();
+    }
+  });
+
+  sequencer atomic(sequencer_impl_ptr(new atomic_sequencer(1)));
+  measure("atomic", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      total += atomic.next();
+    }
+  });
+
+  sequencer cached(sequencer_impl_ptr(new atomic_sequencer(64)));
+  measure("atomic cached", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      total += cached.next();
+    }
+  });
+
+  if (total == 0) {
+    throw std::logic_error("no ids");
+  }
+}
+
+void SequencerBenchUnit::concurrent()
+{
+  const unsigned long count = 8000000;
+
+  long total = 0;
+
+  for (unsigned long threads = 1; threads <= 8; threads *= 2) {
+    std::string suffix(" " + std::to_string(threads) + (threads == 1 ? " thread" : " threads"));
+
+    sequencer locked(sequencer_impl_ptr(new locked_sequencer));
+    measure("mutex" + suffix, count, [&]() {
+      total += allocate(locked, threads, count);
+    });
+
+    sequencer atomic(sequencer_impl_ptr(new atomic_sequencer(1)));
+    measure("atomic" + suffix, count, [&]() {
+      total += allocate(atomic, threads, count);
+    });
+
+    sequencer cached(sequencer_impl_ptr(new atomic_sequencer(64)));
+    measure("atomic cached" + suffix, count, [&]() {
+      total += allocate(cached, threads, count);
+    });
+  }
+
+  if (total == 0) {
+    throw std::logic_error("no ids");
+  }
+}
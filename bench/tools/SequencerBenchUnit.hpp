@@ -0,0 +1,19 @@
+#ifndef SEQUENCER_BENCHUNIT_HPP
+#define SEQUENCER_BENCHUNIT_HPP
+
+#include "../bench_unit.hpp"
+
+class SequencerBenchUnit : public bench_unit
+{
+public:
+  SequencerBenchUnit();
+  virtual ~SequencerBenchUnit();
+
+  virtual void initialize() {}
+  virtual void finalize() {}
+
+  void next();
+  void concurrent();
+};
+
+#endif /* SEQUENCER_BENCHUNIT_HPP */
@@ -0,0 +1,153 @@
+#include "TimeBenchUnit.hpp"
+
+#include "tools/date.hpp"
+#include "tools/time.hpp"
+#include "tools/string.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+using namespace oos;
+
+namespace {
+
+/*
+ * the former strftime based formatting
+ * and strptime/mktime based parsing
+ */
+std::string strftime_to_string(const oos::time &x, const char *format)
+{
+  struct tm timeinfo = x.get_tm();
+  char buffer[255];
+  strftime(buffer, 255, format, &timeinfo);
+  std::string result(buffer);
+  auto pos = result.find("%f");
+  if (pos != std::string::npos) {
+    result.replace(pos, 2, std::to_string(x.milli_second()));
+  }
+  return result;
+}
+
+oos::time strptime_parse(const std::string &tstr, const char *format)
+{
+  const char *pch = strstr(format, "%f");
+  std::string part(format, (pch ? pch-format : strlen(format)));
+  struct tm tm;
+  memset(&tm, 0, sizeof(struct tm));
+  const char *endptr = strptime(tstr.c_str(), part.c_str(), &tm);
+  unsigned long usec = 0;
+  if (endptr != nullptr && pch != nullptr) {
+    char *next;
+    usec = std::strtoul(endptr, &next, 10);
+    usec *= (unsigned long)pow(10.0, 6 - (next - endptr));
+  }
+  tm.tm_isdst = -1;
+  struct timeval tv;
+  tv.tv_sec = mktime(&tm);
+  tv.tv_usec = usec;
+  return oos::time(tv);
+}
+
+}
+
+TimeBenchUnit::TimeBenchUnit()
+  : bench_unit("time", "date and time bench unit")
+{
+  add_bench("format", std::bind(&TimeBenchUnit::format_time, this), "format 1m times as ISO8601");
+  add_bench("parse", std::bind(&TimeBenchUnit::parse_time, this), "parse 1m ISO8601 time strings");
+  add_bench("date", std::bind(&TimeBenchUnit::date_calendar, this), "iterate and convert 1m dates");
+}
+
+TimeBenchUnit::~TimeBenchUnit()
+{}
+
+void TimeBenchUnit::format_time()
+{
+  const unsigned long count = 1000000;
+
+  oos::time t(2015, 3, 15, 13, 56, 23, 123);
+  std::size_t total = 0;
+
+  measure("strftime to_string", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      total += strftime_to_string(t, "%F %T.%f").size();
+    }
+  });
+
+  measure("to_string", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      total += to_string(t, time_format::ISO8601_MILLI).size();
+    }
+  });
+
+  char buffer[32];
+  measure("to_string into buffer", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      total += to_string(t, buffer, sizeof(buffer), time_format::ISO8601_MILLI);
+    }
+  });
+
+  if (total == 0) {
+    throw std::logic_error("nothing formatted");
+  }
+}
+
+void TimeBenchUnit::parse_time()
+{
+  const unsigned long count = 1000000;
+
+  // a thousand different timestamps over two years
+  std::vector<std::string> strings;
+  struct timeval tv;
+  tv.tv_sec = 1420070400;
+  tv.tv_usec = 123000;
+  for (int i = 0; i < 1000; ++i) {
+    strings.push_back(to_string(oos::time(tv), time_format::ISO8601_MILLI));
+    tv.tv_sec += 63113;
+  }
+
+  long total = 0;
+
+  measure("strptime parse", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      total += strptime_parse(strings[i % 1000], "%F %T.%f").second();
+    }
+  });
+
+  measure("parse", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      total += oos::time::parse(strings[i % 1000].c_str(), time_format::ISO8601_MILLI).second();
+    }
+  });
+
+  if (total == 0) {
+    throw std::logic_error("nothing parsed");
+  }
+}
+
+void TimeBenchUnit::date_calendar()
+{
+  const unsigned long count = 1000000;
+
+  long total = 0;
+
+  measure("increment date", count, [&]() {
+    date d(1, 1, 1900);
+    for (unsigned long i = 0; i < count; ++i) {
+      ++d;
+    }
+    total += d.year();
+  });
+
+  measure("create date from julian date", count, [&]() {
+    for (unsigned long i = 0; i < count; ++i) {
+      total += date(2415021 + (int)i).day();
+    }
+  });
+
+  if (total == 0) {
+    throw std::logic_error("no dates");
+  }
+}
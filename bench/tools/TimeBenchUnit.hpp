@@ -0,0 +1,20 @@
+#ifndef TIME_BENCHUNIT_HPP
+#define TIME_BENCHUNIT_HPP
+
+#include "../bench_unit.hpp"
+
+class TimeBenchUnit : public bench_unit
+{
+public:
+  TimeBenchUnit();
+  virtual ~TimeBenchUnit();
+
+  virtual void initialize() {}
+  virtual void finalize() {}
+
+  void format_time();
+  void parse_time();
+  void date_calendar();
+};
+
+#endif /* TIME_BENCHUNIT_HPP */
@@ -84,6 +84,7 @@ protected:
   virtual void read(const char *id, std::string &x);
   virtual void read(const char *id, oos::date &x);
   virtual void read(const char *id, oos::time &x);
+  virtual void read(const char *id, oos::blob &x);
   virtual void read(const char *id, object_base_ptr &x);
   virtual void read(const char *id, object_container &x);
   virtual void read(const char *id, primary_key_base &x);
@@ -106,6 +107,7 @@ protected:
   void read_column(const char *, varchar_base &val);
   void read_column(const char *, oos::date &val);
   void read_column(const char *, oos::time &val);
+  void read_column(const char *, oos::blob &val);
 
 private:
   size_type affected_rows_;
@@ -115,6 +117,7 @@ private:
   bool free_;
   
   enum { NUMERIC_LEN = 21 };
+  enum { BLOB_CHUNK_SIZE = 64 * 1024 };
 
   SQLHANDLE stmt_;
 };
@@ -82,6 +82,7 @@ protected:
   virtual void write(const char *id, const std::string &x);
   virtual void write(const char *id, const oos::date &x);
   virtual void write(const char *id, const oos::time &x);
+  virtual void write(const char *id, const oos::blob &x);
 	virtual void write(const char *id, const object_base_ptr &x);
   virtual void write(const char *id, const object_container &x);
   virtual void write(const char *id, const primary_key_base &x);
@@ -103,6 +104,9 @@ protected:
   void bind_value(const oos::time &t, int index);
   void bind_value(unsigned long val, int index);
   void bind_value(const char *val, int size, int index);
+  void bind_value(const oos::blob &x, int index);
+
+  SQLRETURN put_data();
 
 private:
   mssql_database &db_;
@@ -117,6 +121,7 @@ private:
   std::vector<value_t*> host_data_;
 
   enum { NUMERIC_LEN = 21 };
+  enum { BLOB_CHUNK_SIZE = 64 * 1024 };
 
   SQLHANDLE stmt_;
 };
@@ -232,6 +232,8 @@ const char* mssql_database::type_string(data_type_t type) const
       return "DATE";
     case type_time:
       return "DATETIME";
+    case type_blob:
+      return "VARBINARY(MAX)";
     default:
       {
         std::stringstream msg;
@@ -23,6 +23,8 @@
 #include "object/object_ptr.hpp"
 #include "object/object.hpp"
 
+#include "tools/blob.hpp"
+
 namespace oos {
 
 namespace mssql {
@@ -183,6 +185,11 @@ void mssql_result::read(const char *id, oos::time &x)
   read_column(id, x);
 }
 
+void mssql_result::read(const char *id, oos::blob &x)
+{
+  read_column(id, x);
+}
+
 void mssql_result::read(const char *id, object_base_ptr &x)
 {
   long val;
@@ -267,6 +274,35 @@ void mssql_result::read_column(char const *, time &x)
   }
 }
 
+void mssql_result::read_column(char const *, oos::blob &x)
+{
+  SQLUSMALLINT column = static_cast<SQLUSMALLINT>(result_index++);
+  x.clear();
+  while (true) {
+    // read the next chunk directly into the blob
+    oos::blob::size_type offset = x.size();
+    x.resize(offset + BLOB_CHUNK_SIZE);
+    SQLLEN info = 0;
+    SQLRETURN ret = SQLGetData(stmt_, column, SQL_C_BINARY, x.data() + offset, BLOB_CHUNK_SIZE, &info);
+    if (ret == SQL_NO_DATA) {
+      x.resize(offset);
+      return;
+    } else if (!SQL_SUCCEEDED(ret)) {
+      throw_error(ret, SQL_HANDLE_STMT, stmt_, "mssql", "error on retrieving field value");
+    } else if (info == SQL_NULL_DATA) {
+      x.clear();
+      return;
+    } else if (ret == SQL_SUCCESS) {
+      // last chunk, info holds its size
+      x.resize(offset + info);
+      return;
+    } else if (info != SQL_NO_TOTAL) {
+      // info holds the remaining size
+      x.reserve(offset + info);
+    }
+  }
+}
+
 }
 
 }
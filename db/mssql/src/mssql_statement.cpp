@@ -23,7 +23,9 @@
 #include "object/object_ptr.hpp"
 
 #include "tools/varchar.hpp"
+#include "tools/blob.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <cstring>
 #include <cstdio>
@@ -89,6 +91,11 @@ result* mssql_statement::execute()
 {
   SQLRETURN ret = SQLExecute(stmt_);
 
+  if (ret == SQL_NEED_DATA) {
+    // send blob parameters
+    ret = put_data();
+  }
+
   // check result
   throw_error(ret, SQL_HANDLE_STMT, stmt_, str(), "error on query execute");
 
@@ -170,9 +177,14 @@ void mssql_statement::write(const char *, const oos::time &x)
   bind_value(x, ++host_index);
 }
 
+void mssql_statement::write(const char *, const oos::blob &x)
+{
+  bind_value(x, ++host_index);
+}
+
 void mssql_statement::write(const char *, const varchar_base &x)
 {
-  bind_value(x.c_str(), x.size() + 1, ++host_index);
+  bind_value(x.data(), x.size() + 1, ++host_index);
 }
 
 void mssql_statement::write(const char *, const object_base_ptr &x)
@@ -258,6 +270,37 @@ void mssql_statement::bind_value(const char *val, int /*size*/, int index)
   throw_error(ret, SQL_HANDLE_STMT, stmt_, "mssql", "couldn't bind parameter");
 }
 
+void mssql_statement::bind_value(const oos::blob &x, int index)
+{
+  // the blob itself is passed as token and
+  // its data is sent on execution with SQLPutData
+  std::unique_ptr<value_t> v(new value_t(false, SQL_LEN_DATA_AT_EXEC((SQLLEN)x.size())));
+
+  SQLRETURN ret = SQLBindParameter(stmt_, (SQLUSMALLINT)index, SQL_PARAM_INPUT, SQL_C_BINARY, SQL_LONGVARBINARY, x.size(), 0, (SQLPOINTER)&x, 0, &v->len);
+  throw_error(ret, SQL_HANDLE_STMT, stmt_, "mssql", "couldn't bind parameter");
+
+  host_data_.push_back(v.release());
+}
+
+SQLRETURN mssql_statement::put_data()
+{
+  SQLPOINTER token = 0;
+  SQLRETURN ret = SQLParamData(stmt_, &token);
+  while (ret == SQL_NEED_DATA) {
+    const oos::blob *x = static_cast<const oos::blob*>(token);
+    oos::blob::size_type offset = 0;
+    do {
+      // an empty blob is sent as one empty chunk
+      oos::blob::size_type len = std::min<oos::blob::size_type>(x->size() - offset, BLOB_CHUNK_SIZE);
+      ret = SQLPutData(stmt_, (SQLPOINTER)(x->data() + offset), (SQLLEN)len);
+      throw_error(ret, SQL_HANDLE_STMT, stmt_, "mssql", "couldn't send blob data");
+      offset += len;
+    } while (offset < x->size());
+    ret = SQLParamData(stmt_, &token);
+  }
+  return ret;
+}
+
 database& mssql_statement::db()
 {
   return db_;
@@ -299,6 +342,8 @@ int mssql_statement::type2int(data_type_t type)
       return SQL_C_CHAR;
     case type_text:
       return SQL_C_CHAR;
+    case type_blob:
+      return SQL_C_BINARY;
     case type_date:
       return SQL_C_DATE;
     case type_time:
@@ -341,6 +386,8 @@ int mssql_statement::type2sql(data_type_t type)
       return SQL_VARCHAR;
     case type_text:
       return SQL_VARCHAR;
+    case type_blob:
+      return SQL_LONGVARBINARY;
     case type_date:
       return SQL_DATE;
     case type_time:
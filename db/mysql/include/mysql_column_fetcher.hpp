@@ -33,6 +33,7 @@ public:
   void read_value(const char *id, oos::date &x);
   void read_value(const char *id, oos::time &x);
   void read_value(const char *id, std::string &x);
+  void read_value(const char *id, oos::blob &x);
   void read_value(const char *id, varchar_base &x);
   void read_value(const char *id, object_base_ptr &x);
   void read_value(const char *id, char *x, int s);
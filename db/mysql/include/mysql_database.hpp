@@ -66,6 +66,14 @@ public:
    */
   virtual bool is_open() const;
 
+  /**
+   * Returns true if the server
+   * connection is alive.
+   *
+   * @return True on a working connection.
+   */
+  virtual bool ping();
+
   /**
    * Create a new sqlite result
    * 
@@ -90,6 +98,17 @@ public:
    */
   MYSQL* operator()();
 
+  /**
+   * Returns the query plan of the given sql
+   * from EXPLAIN, one line per row of the plan.
+   * A prepared sql isn't explained because the
+   * plan depends on the unknown parameters.
+   *
+   * @param sql The sql to explain.
+   * @return The query plan.
+   */
+  virtual std::string explain(const std::string &sql);
+
 protected:
   virtual void on_open(const std::string &db);
   virtual void on_close();
@@ -63,6 +63,7 @@ protected:
   virtual void read(const char *id, std::string &x);
   virtual void read(const char *id, oos::date &x);
   virtual void read(const char *id, oos::time &x);
+  virtual void read(const char *id, oos::blob &x);
   virtual void read(const char *id, object_base_ptr &x);
   virtual void read(const char *id, object_container &x);
   virtual void read(const char *id, primary_key_base &x);
@@ -91,6 +92,7 @@ private:
   void prepare_bind_column(int index, enum_field_types type, oos::date &value);
   void prepare_bind_column(int index, enum_field_types type, oos::time &value);
   void prepare_bind_column(int index, enum_field_types type, std::string &value);
+  void prepare_bind_column(int index, enum_field_types type, oos::blob &value);
   void prepare_bind_column(int index, enum_field_types type, char *x, int s);
   void prepare_bind_column(int index, enum_field_types type, varchar_base &value);
   void prepare_bind_column(int index, enum_field_types type, object_base_ptr &value);
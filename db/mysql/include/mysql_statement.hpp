@@ -50,6 +50,7 @@ public:
 
   virtual void clear();
   virtual result* execute();
+  virtual unsigned long execute_update();
   virtual void prepare(const sql &s);
   virtual void reset();
   
@@ -76,6 +77,7 @@ protected:
   virtual void write(const char *id, const std::string &x);
   virtual void write(const char *id, const oos::date &x);
   virtual void write(const char *id, const oos::time &x);
+  virtual void write(const char *id, const oos::blob &x);
 	virtual void write(const char *id, const object_base_ptr &x);
   virtual void write(const char *id, const object_container &x);
   virtual void write(const char *id, const primary_key_base &x);
@@ -100,6 +102,8 @@ private:
   void bind_value(MYSQL_BIND &bind, enum_field_types type, const char *value, int size, int index);
   void bind_value(MYSQL_BIND &bind, enum_field_types type, const object_base_ptr &value, int index);
 
+  void send_long_data();
+
 private:
   mysql_database &db_;
   int result_size;
@@ -107,6 +111,15 @@ private:
   std::vector<unsigned long> length_vector;
   MYSQL_STMT *stmt;
   MYSQL_BIND *host_array;
+
+  /*
+   * blobs are sent in chunks after
+   * binding the parameters
+   */
+  typedef std::vector<std::pair<int, const oos::blob*> > t_long_data_vector;
+  t_long_data_vector long_data_;
+
+  enum { LONG_DATA_CHUNK_SIZE = 64 * 1024 };
 };
 
 }
@@ -1,7 +1,10 @@
 #include "mysql_column_fetcher.hpp"
 
+#include "mysql_exception.hpp"
 #include "object/object.hpp"
 
+#include "tools/blob.hpp"
+
 namespace oos {
 
 namespace mysql {
@@ -59,6 +62,24 @@ void mysql_column_fetcher::read_value(const char *, std::string &x)
   ++column_index_;
 }
 
+void mysql_column_fetcher::read_value(const char *, oos::blob &x)
+{
+  unsigned long len = info_[column_index_].length;
+  x.resize(len);
+  if (len > 0) {
+    // fetch the column directly into the blob
+    bind_[column_index_].buffer = x.data();
+    bind_[column_index_].buffer_length = len;
+    int ret = mysql_stmt_fetch_column(stmt_, &bind_[column_index_], column_index_, 0);
+    bind_[column_index_].buffer = 0;
+    bind_[column_index_].buffer_length = 0;
+    if (ret != 0) {
+      throw_stmt_error(ret, stmt_, "mysql", "");
+    }
+  }
+  ++column_index_;
+}
+
 void mysql_column_fetcher::read_value(const char *, varchar_base &x)
 {
   char *data = (char*)bind_[column_index_].buffer;
@@ -94,11 +94,16 @@ bool mysql_database::is_open() const
   return is_open_;
 }
 
+bool mysql_database::ping()
+{
+  return is_open_ && mysql_ping(&mysql_) == 0;
+}
+
 void mysql_database::on_close()
 {
+  // the client library stays initialized,
+  // other (pooled) connections may be open
   mysql_close(&mysql_);
-  // tell mysql to close the library
-  mysql_library_end();
 
   is_open_ = false;
 }
@@ -126,6 +131,40 @@ result* mysql_database::on_execute(const std::string &sqlstr)
   return new mysql_result(&mysql_);
 }
 
+std::string mysql_database::explain(const std::string &sql)
+{
+  if (sql.find('?') != std::string::npos) {
+    return "";
+  }
+  std::string query("EXPLAIN " + sql);
+  if (mysql_query(&mysql_, query.c_str())) {
+    return "";
+  }
+  MYSQL_RES *res = mysql_store_result(&mysql_);
+  if (!res) {
+    return "";
+  }
+  unsigned int count = mysql_num_fields(res);
+  MYSQL_FIELD *fields = mysql_fetch_fields(res);
+  std::string plan;
+  MYSQL_ROW row;
+  while ((row = mysql_fetch_row(res)) != 0) {
+    if (!plan.empty()) {
+      plan += "\n";
+    }
+    for (unsigned int i = 0; i < count; ++i) {
+      if (i > 0) {
+        plan += " ";
+      }
+      plan += fields[i].name;
+      plan += "=";
+      plan += row[i] ? row[i] : "NULL";
+    }
+  }
+  mysql_free_result(res);
+  return plan;
+}
+
 void mysql_database::on_begin()
 {
   result *res = execute("START TRANSACTION;");
@@ -186,6 +225,8 @@ const char* mysql_database::type_string(data_type_t type) const
       return "VARCHAR";
     case type_text:
       return "TEXT";
+    case type_blob:
+      return "LONGBLOB";
     default:
       {
         std::stringstream msg;
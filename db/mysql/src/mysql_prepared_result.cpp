@@ -209,6 +209,11 @@ void mysql_prepared_result::read(const char *, oos::time &x)
   prepare_bind_column(result_index++, MYSQL_TYPE_TIMESTAMP, x);
 }
 
+void mysql_prepared_result::read(const char *, oos::blob &x)
+{
+  prepare_bind_column(result_index++, MYSQL_TYPE_LONG_BLOB, x);
+}
+
 void mysql_prepared_result::read(const char *, varchar_base &x)
 {
   prepare_bind_column(result_index++, MYSQL_TYPE_VAR_STRING, x);
@@ -270,6 +275,17 @@ void mysql_prepared_result::prepare_bind_column(int index, enum_field_types type
   bind_[index].error = &info_[index].error;
 }
 
+void mysql_prepared_result::prepare_bind_column(int index, enum_field_types type, oos::blob & /*value*/)
+{
+  // the blob is fetched later directly into its own memory
+  bind_[index].buffer_type = type;
+  bind_[index].buffer = 0;
+  bind_[index].buffer_length = 0;
+  bind_[index].is_null = &info_[index].is_null;
+  bind_[index].length = &info_[index].length;
+  bind_[index].error = &info_[index].error;
+}
+
 void mysql_prepared_result::prepare_bind_column(int index, enum_field_types type, char *x, int s)
 {
   bind_[index].buffer_type = type;
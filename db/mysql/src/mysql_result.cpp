@@ -19,6 +19,8 @@
 #include "mysql_result.hpp"
 #include "mysql_exception.hpp"
 
+#include "tools/blob.hpp"
+
 #include "database/row.hpp"
 
 namespace oos {
@@ -170,6 +172,15 @@ void mysql_result::read(const char *, oos::time &)
   // TODO: read time from mysql result
 }
 
+void mysql_result::read(const char *, oos::blob &x)
+{
+  if (!row) {
+    return;
+  }
+  unsigned long *lengths = mysql_fetch_lengths(res);
+  x.assign(row[result_index], lengths[result_index]);
+}
+
 void mysql_result::read(const char */*id*/, object_base_ptr &/*x*/)
 {
 }
@@ -24,10 +24,12 @@
 
 #include "tools/varchar.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 #include <tools/date.hpp>
 #include <tools/time.hpp>
+#include <tools/blob.hpp>
 
 namespace oos {
 
@@ -80,6 +82,7 @@ void mysql_statement::prepare(const sql &s)
 
 void mysql_statement::reset()
 {
+  long_data_.clear();
   mysql_stmt_reset(stmt);
 }
 
@@ -92,6 +95,7 @@ void mysql_statement::clear()
   }
   result_size = 0;
   host_size = 0;
+  long_data_.clear();
   mysql_stmt_free_result(stmt);
   delete [] host_array;
 }
@@ -103,6 +107,7 @@ result* mysql_statement::execute()
     if (res > 0) {
       throw_stmt_error(res, stmt, "mysql", str());
     }
+    send_long_data();
   }
   int res = mysql_stmt_execute(stmt);
   if (res > 0) {
@@ -115,6 +120,22 @@ result* mysql_statement::execute()
   return new mysql_prepared_result(stmt, result_size);
 }
 
+unsigned long mysql_statement::execute_update()
+{
+  if (host_array) {
+    int res = mysql_stmt_bind_param(stmt, host_array);
+    if (res > 0) {
+      throw_stmt_error(res, stmt, "mysql", str());
+    }
+    send_long_data();
+  }
+  int res = mysql_stmt_execute(stmt);
+  if (res > 0) {
+    throw_stmt_error(res, stmt, "mysql", str());
+  }
+  return (unsigned long)mysql_stmt_affected_rows(stmt);
+}
+
 void mysql_statement::write(const char *, char x)
 {
   bind_value(host_array[host_index], MYSQL_TYPE_TINY, x, host_index);
@@ -205,9 +226,18 @@ void mysql_statement::write(const char *, const oos::time &x)
   ++host_index;
 }
 
+void mysql_statement::write(const char *, const oos::blob &x)
+{
+  // the data isn't copied into the bind buffer,
+  // it is sent in chunks on execution
+  bind_value(host_array[host_index], MYSQL_TYPE_LONG_BLOB, host_index);
+  long_data_.push_back(std::make_pair(host_index, &x));
+  ++host_index;
+}
+
 void mysql_statement::write(const char *, const varchar_base &x)
 {
-  bind_value(host_array[host_index], MYSQL_TYPE_VAR_STRING, x.c_str(), x.size(), host_index);
+  bind_value(host_array[host_index], MYSQL_TYPE_VAR_STRING, x.data(), x.size(), host_index);
   ++host_index;
 }
 
@@ -311,6 +341,24 @@ void mysql_statement::bind_value(MYSQL_BIND &bind, enum_field_types type, const
   bind_value(bind, type, value.id(), index);
 }
 
+void mysql_statement::send_long_data()
+{
+  for (t_long_data_vector::const_iterator i = long_data_.begin(); i != long_data_.end(); ++i) {
+    const char *data = i->second->data();
+    oos::blob::size_type size = i->second->size();
+    oos::blob::size_type offset = 0;
+    do {
+      // an empty blob is sent as one empty chunk
+      unsigned long len = (unsigned long)std::min<oos::blob::size_type>(size - offset, LONG_DATA_CHUNK_SIZE);
+      if (mysql_stmt_send_long_data(stmt, (unsigned int)i->first, data + offset, len) != 0) {
+        throw_stmt_error(1, stmt, "mysql", str());
+      }
+      offset += len;
+    } while (offset < size);
+  }
+  long_data_.clear();
+}
+
 }
 
 }
@@ -47,6 +47,22 @@ class sqlite_statement;
  * 
  * This class is the sqlite database backend
  * class. It provides the sqlite version 3
+ *
+ * Options can be appended to the database file
+ * of the connection string:
+ *
+ * @code
+ * sqlite://test.sqlite?time=native
+ * @endcode
+ *
+ * With time=native time values are stored as
+ * INTEGER microseconds since epoch and date
+ * values as INTEGER julian dates. The default
+ * time=text stores time values as ISO8601
+ * strings. Both representations are read in
+ * either mode, so existing databases can be
+ * opened in native mode; time columns created
+ * in text mode keep getting ISO8601 strings.
  */
 class OOS_SQLITE_API sqlite_database : public database
 {
@@ -79,6 +95,36 @@ public:
 
   virtual const char* type_string(data_type_t type) const;
 
+  /**
+   * Returns true if time and date values
+   * are stored in their native integer
+   * representation.
+   *
+   * @return True if native time storage is enabled.
+   */
+  bool native_time() const;
+
+  /**
+   * Returns the query plan of the given
+   * sql from EXPLAIN QUERY PLAN, one line
+   * per step of the plan.
+   *
+   * @param sql The sql to explain.
+   * @return The query plan.
+   */
+  virtual std::string explain(const std::string &sql);
+
+  /**
+   * Prepares a multi row insert of the given
+   * number of objects. Existing rows are updated
+   * on a conflicting id instead of inserted.
+   *
+   * @param node The prototype node of the objects.
+   * @param rows The number of objects.
+   * @return The prepared statement.
+   */
+  virtual statement* prepare_update(const prototype_node &node, std::size_t rows);
+
 protected:
   virtual void on_open(const std::string &db);
   virtual void on_close();
@@ -92,6 +138,7 @@ private:
 
 private:
   sqlite3 *sqlite_db_;
+  bool native_time_;
 };
 
 }
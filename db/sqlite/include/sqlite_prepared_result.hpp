@@ -25,7 +25,7 @@ public:
   typedef result::size_type size_type;
 
 public:
-  sqlite_prepared_result(sqlite3_stmt *stmt, int rs);
+  sqlite_prepared_result(sqlite3_stmt *stmt, int rs, size_type affected_rows = 0);
   ~sqlite_prepared_result();
   
   const char* column(size_type c) const;
@@ -56,6 +56,7 @@ protected:
   virtual void read(const char *id, std::string &x);
   virtual void read(const char *id, oos::date &x);
   virtual void read(const char *id, oos::time &x);
+  virtual void read(const char *id, oos::blob &x);
   virtual void read(const char *id, object_base_ptr &x);
   virtual void read(const char *id, object_container &x);
   virtual void read(const char *id, primary_key_base &x);
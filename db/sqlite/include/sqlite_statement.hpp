@@ -24,6 +24,7 @@
 #include "object/primary_key.hpp"
 
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <memory>
 
@@ -45,6 +46,7 @@ public:
 
   virtual void clear();
   virtual result* execute();
+  virtual unsigned long execute_update();
   virtual void prepare(const sql &s);
   virtual void reset();
 
@@ -65,15 +67,21 @@ protected:
   virtual void write(const char *id, const std::string &x);
   virtual void write(const char *id, const oos::date &x);
   virtual void write(const char *id, const oos::time &x);
+  virtual void write(const char *id, const oos::blob &x);
   virtual void write(const char *id, const object_base_ptr &x);
   virtual void write(const char *id, const object_container &x);
   virtual void write(const char *id, const primary_key_base &x);
 
+private:
+  void collect_text_columns();
+
 private:
   sqlite_database &db_;
   sqlite3_stmt *stmt_;
-
-  std::vector<std::shared_ptr<std::string> > host_strings_;
+  // columns of the written table declared
+  // as TEXT; they keep text time values
+  // in native mode
+  std::unordered_set<std::string> text_columns_;
 };
 
 }
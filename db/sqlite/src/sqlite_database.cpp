@@ -24,8 +24,17 @@
 #include "database/session.hpp"
 
 #include "database/database_sequencer.hpp"
+#include "database/sql.hpp"
+#include "database/query_insert.hpp"
+
+#include "object/object.hpp"
+#include "object/object_producer.hpp"
+#include "object/primary_key.hpp"
+#include "object/prototype_node.hpp"
 
 #include <sqlite3.h>
+#include <cstring>
+#include <memory>
 #include <sstream>
 
 using namespace std::placeholders;
@@ -33,7 +42,46 @@ using namespace std::placeholders;
 namespace oos {
   
 namespace sqlite {
-  
+
+namespace {
+
+/*
+ * appends the update of each column on a
+ * conflicting id, the id itself is kept
+ */
+class conflict_update : public generic_object_writer<conflict_update>
+{
+public:
+  explicit conflict_update(sql &s)
+    : generic_object_writer<conflict_update>(this)
+    , sql_(s)
+    , first_(true)
+  {}
+  virtual ~conflict_update() {}
+
+  template < class T >
+  void write_value(const char *id, const T&) { column(id); }
+  void write_value(const char *id, const char*, int) { column(id); }
+  void write_value(const char*, const object_container&) {}
+  void write_value(const char *id, const primary_key_base &x) { x.serialize(id, *this); }
+
+private:
+  void column(const char *id)
+  {
+    if (std::strcmp(id, "id") == 0) {
+      return;
+    }
+    sql_.append(std::string(first_ ? " " : ", ") + id + "=excluded." + id);
+    first_ = false;
+  }
+
+private:
+  sql &sql_;
+  bool first_;
+};
+
+}
+
 void throw_error(int ec, sqlite3 *db, const std::string &source)
 {
   if (ec == SQLITE_OK) {
@@ -47,6 +95,7 @@ void throw_error(int ec, sqlite3 *db, const std::string &source)
 sqlite_database::sqlite_database(session *db)
   : database(db, new database_sequencer(*this))
   , sqlite_db_(0)
+  , native_time_(false)
 {
 }
 
@@ -56,8 +105,24 @@ sqlite_database::~sqlite_database()
 }
 
 
-void sqlite_database::on_open(const std::string &db)
+void sqlite_database::on_open(const std::string &connection)
 {
+  // parse file[?option=value[&option=value]]
+  std::string::size_type pos = connection.find('?');
+  std::string db = connection.substr(0, pos);
+
+  native_time_ = false;
+  while (pos != std::string::npos) {
+    std::string::size_type next = connection.find('&', pos + 1);
+    std::string option = connection.substr(pos + 1, next == std::string::npos ? next : next - pos - 1);
+    if (option == "time=native") {
+      native_time_ = true;
+    } else if (option != "time=text") {
+      throw sqlite_exception("unknown option: " + option);
+    }
+    pos = next;
+  }
+
   int ret = sqlite3_open(db.c_str(), &sqlite_db_);
   if (ret != SQLITE_OK) {
     throw sqlite_exception("couldn't open database: " + db);
@@ -83,6 +148,32 @@ statement* sqlite_database::create_statement()
   return new sqlite_statement(*this);
 }
 
+statement* sqlite_database::prepare_update(const prototype_node &node, std::size_t rows)
+{
+  std::unique_ptr<object> o(node.producer->create());
+
+  // INSERT INTO t (...) VALUES (...), (...) ON CONFLICT(id) DO UPDATE SET ...
+  sql s;
+  s.append(std::string("INSERT INTO ") + node.type + std::string(" ("));
+  query_insert values(s);
+  values.fields();
+  o->serialize(values);
+  s.append(") VALUES ");
+  for (std::size_t i = 0; i < rows; ++i) {
+    s.append(i ? ", (" : "(");
+    values.values();
+    o->serialize(values);
+    s.append(")");
+  }
+  s.append(" ON CONFLICT(id) DO UPDATE SET");
+  conflict_update update(s);
+  o->serialize(update);
+
+  std::unique_ptr<statement> stmt(create_statement());
+  stmt->prepare(s);
+  return stmt.release();
+}
+
 sqlite3* sqlite_database::operator()()
 {
   return sqlite_db_;
@@ -144,6 +235,32 @@ int sqlite_database::parse_result(void* param, int column_count, char** values,
   return 0;
 }
 
+std::string sqlite_database::explain(const std::string &sql)
+{
+  // unbound parameters are null and
+  // don't change the query plan
+  std::string query("EXPLAIN QUERY PLAN " + sql);
+  sqlite3_stmt *stmt = 0;
+  if (sqlite3_prepare_v2(sqlite_db_, query.c_str(), query.size(), &stmt, 0) != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    return "";
+  }
+  // the last column holds the detail
+  int detail = sqlite3_column_count(stmt) - 1;
+  std::string plan;
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    const unsigned char *text = sqlite3_column_text(stmt, detail);
+    if (text) {
+      if (!plan.empty()) {
+        plan += "\n";
+      }
+      plan += reinterpret_cast<const char*>(text);
+    }
+  }
+  sqlite3_finalize(stmt);
+  return plan;
+}
+
 const char* sqlite_database::type_string(data_type_t type) const
 {
   switch(type) {
@@ -176,9 +293,11 @@ const char* sqlite_database::type_string(data_type_t type) const
     case type_text:
       return "TEXT";
     case type_date:
-      return "REAL";
+      return native_time_ ? "INTEGER" : "REAL";
     case type_time:
-      return "TEXT";
+      return native_time_ ? "INTEGER" : "TEXT";
+    case type_blob:
+      return "BLOB";
     default:
       {
         std::stringstream msg;
@@ -189,6 +308,11 @@ const char* sqlite_database::type_string(data_type_t type) const
   }
 }
 
+bool sqlite_database::native_time() const
+{
+  return native_time_;
+}
+
 result *sqlite_database::create_result()
 {
   return nullptr;
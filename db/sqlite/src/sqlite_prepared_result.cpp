@@ -2,6 +2,9 @@
 
 #include "object/object.hpp"
 
+#include "tools/string.hpp"
+#include "tools/blob.hpp"
+
 #include <ostream>
 
 #include <sqlite3.h>
@@ -10,10 +13,29 @@ namespace oos {
 
 namespace sqlite {
 
-sqlite_prepared_result::sqlite_prepared_result(sqlite3_stmt *stmt, int ret)
+namespace {
+
+void set_microseconds(oos::time &x, long long usec)
+{
+  long long sec = usec / 1000000;
+  usec %= 1000000;
+  if (usec < 0) {
+    // times before epoch
+    --sec;
+    usec += 1000000;
+  }
+  struct timeval tv;
+  tv.tv_sec = (time_t)sec;
+  tv.tv_usec = (long)usec;
+  x.set(tv);
+}
+
+}
+
+sqlite_prepared_result::sqlite_prepared_result(sqlite3_stmt *stmt, int ret, size_type affected_rows)
   : ret_(ret)
   , first_(true)
-  , affected_rows_(0)
+  , affected_rows_(affected_rows)
   , rows(0)
   , fields_(0)
   , stmt_(stmt)
@@ -149,18 +171,27 @@ void sqlite_prepared_result::read(const char *, varchar_base &x)
   }
 }
 
-void sqlite_prepared_result::read(const char *id, oos::date &x)
+void sqlite_prepared_result::read(const char *, oos::date &x)
 {
-  double val = 0;
-  read(id, val);
-  x.set(static_cast<int>(val));
+  x.set(sqlite3_column_int(stmt_, result_index++));
 }
 
-void sqlite_prepared_result::read(const char *id, oos::time &x)
+void sqlite_prepared_result::read(const char *, oos::time &x)
 {
-  std::string val;
-  read(id, val);
-  x = oos::time::parse(val, "%F %T.%f");
+  // integers are native values, text is ISO8601;
+  // native mode writes text into columns declared
+  // as TEXT, so both are read in either mode
+  switch (sqlite3_column_type(stmt_, result_index)) {
+    case SQLITE_INTEGER:
+      set_microseconds(x, sqlite3_column_int64(stmt_, result_index++));
+      break;
+    case SQLITE_NULL:
+      ++result_index;
+      break;
+    default:
+      x = oos::time::parse((const char*)sqlite3_column_text(stmt_, result_index++), oos::time_format::ISO8601_MILLI);
+      break;
+  }
 }
 
 void sqlite_prepared_result::read(const char *, char *x, int s)
@@ -183,6 +214,17 @@ void sqlite_prepared_result::read(const char *, char *x, int s)
   }
 }
 
+void sqlite_prepared_result::read(const char *, oos::blob &x)
+{
+  const char *data = (const char*)sqlite3_column_blob(stmt_, result_index);
+  int s = sqlite3_column_bytes(stmt_, result_index++);
+  if (data == nullptr) {
+    x.clear();
+  } else {
+    x.assign(data, s);
+  }
+}
+
 void sqlite_prepared_result::read(const char *, object_base_ptr &x)
 {
   x.id((long)sqlite3_column_int(stmt_, result_index++));
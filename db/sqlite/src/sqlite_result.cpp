@@ -17,6 +17,9 @@
 
 #include <object/primary_key.hpp>
 #include "sqlite_result.hpp"
+#include "sqlite_exception.hpp"
+
+#include "tools/blob.hpp"
 
 namespace oos {
 
@@ -37,7 +40,7 @@ sqlite_result::~sqlite_result()
 
 const char* sqlite_result::column(sqlite_result::size_type c) const
 {
-  return rows_.at(pos_)->at<std::string>(c).c_str();
+  return rows_.at(pos_)->str(c).c_str();
 }
 
 bool sqlite_result::fetch()
@@ -154,6 +157,13 @@ void sqlite_result::read(const char *id, oos::time &x)
   read_column(id, x);
 }
 
+void sqlite_result::read(const char */*id*/, oos::blob &/*x*/)
+{
+  // sqlite3_exec delivers values as C strings,
+  // a blob would be cut at its first null byte
+  throw sqlite_exception("blob columns can only be read by a prepared statement");
+}
+
 void sqlite_result::read(const char */*id*/, object_base_ptr &/*x*/)
 {
 }
@@ -28,6 +28,8 @@
 #include "tools/string.hpp"
 #include "tools/varchar.hpp"
 #include "tools/date.hpp"
+#include "tools/time.hpp"
+#include "tools/blob.hpp"
 
 #include <sstream>
 #include <cstring>
@@ -64,8 +66,23 @@ result* sqlite_statement::execute()
 {
   // get next row
   int ret = sqlite3_step(stmt_);
-  
-  return new sqlite_prepared_result(stmt_, ret);
+
+  // a completed insert, update or delete
+  // reports the number of changed rows
+  sqlite_prepared_result::size_type affected_rows = 0;
+  if (ret == SQLITE_DONE && !sqlite3_stmt_readonly(stmt_)) {
+    affected_rows = sqlite3_changes(db_());
+  }
+  return new sqlite_prepared_result(stmt_, ret, affected_rows);
+}
+
+unsigned long sqlite_statement::execute_update()
+{
+  int ret = sqlite3_step(stmt_);
+  if (ret != SQLITE_DONE && ret != SQLITE_ROW) {
+    throw_error(ret, db_(), "sqlite3_step", str());
+  }
+  return sqlite3_stmt_readonly(stmt_) ? 0 : sqlite3_changes(db_());
 }
 
 void sqlite_statement::prepare(const sql &s)
@@ -79,6 +96,38 @@ void sqlite_statement::prepare(const sql &s)
   // prepare sqlite statement
   int ret = sqlite3_prepare_v2(db_(), str().c_str(), str().size(), &stmt_, 0);
   throw_error(ret, db_(), "sqlite3_prepare_v2", str());
+
+  text_columns_.clear();
+  if (db_.native_time()) {
+    collect_text_columns();
+  }
+}
+
+void sqlite_statement::collect_text_columns()
+{
+  // determine the written table
+  std::string::size_type begin = 0;
+  if (str().compare(0, 12, "INSERT INTO ") == 0) {
+    begin = 12;
+  } else if (str().compare(0, 7, "UPDATE ") == 0) {
+    begin = 7;
+  } else {
+    return;
+  }
+  std::string table = str().substr(begin, str().find(' ', begin) - begin);
+
+  std::string info = "PRAGMA table_info(" + table + ")";
+  sqlite3_stmt *stmt = 0;
+  int ret = sqlite3_prepare_v2(db_(), info.c_str(), info.size(), &stmt, 0);
+  throw_error(ret, db_(), "sqlite3_prepare_v2", info);
+  // columns are cid, name, type, ...
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    const char *type = (const char*)sqlite3_column_text(stmt, 2);
+    if (type && std::strcmp(type, "TEXT") == 0) {
+      text_columns_.insert((const char*)sqlite3_column_text(stmt, 1));
+    }
+  }
+  sqlite3_finalize(stmt);
 }
 
 void sqlite_statement::reset()
@@ -94,8 +143,10 @@ void sqlite_statement::clear()
   if (!stmt_) {
     return;
   }
-  int ret = sqlite3_finalize(stmt_);
-  throw_error(ret, db_(), "sqlite3_finalize");
+  // finalize repeats the error of the last failed
+  // step, which was already thrown; the statement
+  // is freed anyway
+  sqlite3_finalize(stmt_);
   stmt_ = 0;
   return;
 }
@@ -180,21 +231,45 @@ void sqlite_statement::write(const char*, const std::string &x)
 
 void sqlite_statement::write(const char*, const varchar_base &x)
 {
-  int ret = sqlite3_bind_text(stmt_, ++host_index, x.c_str(), x.size(), 0);
+  int ret = sqlite3_bind_text(stmt_, ++host_index, x.data(), x.size(), 0);
   throw_error(ret, db_(), "sqlite3_bind_text");
 }
 
 void sqlite_statement::write(const char *, const oos::date &x)
 {
   int ret = sqlite3_bind_int(stmt_, ++host_index, x.julian_date());
-  throw_error(ret, db_(), "sqlite3_bind_int");}
+  throw_error(ret, db_(), "sqlite3_bind_int");
+}
 
 void sqlite_statement::write(const char *id, const oos::time &x)
 {
-  // format time to ISO8601
-  auto time_string = std::make_shared<std::string>(oos::to_string(x, "%F %T.%f"));
-  write(id, *time_string);
-  host_strings_.push_back(time_string);
+  // a column created in text mode keeps
+  // text values in native mode as well
+  if (db_.native_time() && text_columns_.find(id) == text_columns_.end()) {
+    // microseconds since epoch
+    struct timeval tv = x.get_timeval();
+    int ret = sqlite3_bind_int64(stmt_, ++host_index, (sqlite3_int64)tv.tv_sec * 1000000 + tv.tv_usec);
+    throw_error(ret, db_(), "sqlite3_bind_int64");
+  } else {
+    // format time to ISO8601, sqlite keeps its own copy
+    char time_string[32];
+    std::size_t len = oos::to_string(x, time_string, sizeof(time_string), oos::time_format::ISO8601_MILLI);
+    int ret = sqlite3_bind_text(stmt_, ++host_index, time_string, len, SQLITE_TRANSIENT);
+    throw_error(ret, db_(), "sqlite3_bind_text");
+  }
+}
+
+void sqlite_statement::write(const char *, const oos::blob &x)
+{
+  int ret;
+  if (x.empty()) {
+    // a null pointer would bind NULL
+    ret = sqlite3_bind_zeroblob(stmt_, ++host_index, 0);
+  } else {
+    // the blob outlives the statement execution, no copy needed
+    ret = sqlite3_bind_blob(stmt_, ++host_index, x.data(), (int)x.size(), SQLITE_STATIC);
+  }
+  throw_error(ret, db_(), "sqlite3_bind_blob");
 }
 
 void sqlite_statement::write(const char *, const object_base_ptr &x)
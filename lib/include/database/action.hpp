@@ -32,12 +32,16 @@
 #endif
 
 #include <string>
+#include <cstddef>
+#include <iterator>
 #include <list>
+#include <vector>
 #include <object/object_proxy.hpp>
 
 namespace oos {
 
 class object;
+class prototype_node;
 
 class create_action;
 class insert_action;
@@ -173,9 +177,73 @@ public:
 class OOS_API insert_action : public action
 {
 public:
-  typedef std::list<object_proxy*> object_proxy_list_t;
-  typedef object_proxy_list_t::iterator iterator;
-  typedef object_proxy_list_t::const_iterator const_iterator;
+  typedef std::vector<object_proxy*> object_proxy_vector_t;
+
+  /**
+   * @brief Iterates the inserted object proxies
+   *
+   * Slots of removed objects are skipped.
+   */
+  class const_iterator : public std::iterator<std::forward_iterator_tag, object_proxy*>
+  {
+  public:
+    const_iterator()
+      : current_(nullptr)
+      , last_(nullptr)
+    {}
+
+    object_proxy* operator*() const
+    {
+      return *current_;
+    }
+
+    const_iterator& operator++()
+    {
+      ++current_;
+      skip();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &x) const
+    {
+      return current_ == x.current_;
+    }
+
+    bool operator!=(const const_iterator &x) const
+    {
+      return current_ != x.current_;
+    }
+
+  private:
+    friend class insert_action;
+
+    const_iterator(object_proxy *const *current, object_proxy *const *last)
+      : current_(current)
+      , last_(last)
+    {
+      skip();
+    }
+
+    void skip()
+    {
+      while (current_ != last_ && *current_ == nullptr) {
+        ++current_;
+      }
+    }
+
+  private:
+    object_proxy *const *current_;
+    object_proxy *const *last_;
+  };
+
+  typedef const_iterator iterator;
 
 public:
   /**
@@ -185,6 +253,14 @@ public:
    */
   explicit insert_action(const std::string &t);
 
+  /**
+   * Creates an insert_action for the
+   * objects of the given prototype node.
+   *
+   * @param node The prototype node of the expected objects
+   */
+  explicit insert_action(prototype_node *node);
+
   virtual ~insert_action();
   
   virtual void accept(action_visitor *av);
@@ -197,6 +273,15 @@ public:
    */
   std::string type() const;
 
+  /**
+   * Return the prototype node of the
+   * objects or nullptr if the action
+   * was created by type name.
+   *
+   * @return The prototype node of the action
+   */
+  prototype_node* node() const;
+
   iterator begin();
   const_iterator begin() const;
   
@@ -205,15 +290,40 @@ public:
 
   bool empty() const;
 
+  /**
+   * Returns the number of inserted
+   * objects of the action.
+   *
+   * @return The number of objects.
+   */
+  std::size_t size() const;
+
   iterator find(unsigned long id);
   const_iterator find(unsigned long id) const;
 
-  void push_back(object_proxy *proxy);
+  /**
+   * Adds an inserted object proxy and
+   * returns the slot of the proxy.
+   *
+   * @param proxy The inserted object proxy.
+   * @return The slot of the proxy.
+   */
+  std::size_t push_back(object_proxy *proxy);
+
+  /**
+   * Removes the object proxy of the
+   * given slot in constant time.
+   *
+   * @param slot The slot of the proxy.
+   */
+  void remove(std::size_t slot);
 
   iterator erase(iterator i);
 private:
   std::string type_;
-  object_proxy_list_t object_proxy_list_;
+  prototype_node *node_;
+  object_proxy_vector_t proxies_;
+  std::size_t size_;
 };
 
 
@@ -277,6 +387,15 @@ public:
    */
   delete_action(const char *classname, unsigned long id);
 
+  /**
+   * Creates an delete_action for an
+   * object of the given prototype node.
+   * 
+   * @param node The prototype node of the object.
+   * @param id The id of the deleted object.
+   */
+  delete_action(prototype_node *node, unsigned long id);
+
   virtual ~delete_action();
   
   virtual void accept(action_visitor *av);
@@ -289,6 +408,15 @@ public:
    */
   const char* classname() const;
 
+  /**
+   * Return the prototype node of the
+   * object or nullptr if the action
+   * was created by class name.
+   *
+   * @return The prototype node.
+   */
+  prototype_node* node() const;
+
   /**
    * The id of the object of the action.
    * 
@@ -298,6 +426,7 @@ public:
 
 private:
   std::string classname_;
+  prototype_node *node_;
   unsigned long id_;
 };
 
@@ -0,0 +1,220 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANGE_STREAM_HPP
+#define CHANGE_STREAM_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace oos {
+
+class object;
+class object_store;
+class transaction;
+
+/**
+ * @class change_stream
+ * @brief A bounded stream of committed object changes
+ *
+ * A change stream attached to a session receives
+ * one change for each object inserted, updated or
+ * deleted by a committed transaction. Rolled back
+ * transactions never appear in the stream.
+ *
+ * The changes are kept in a ring of fixed size.
+ * Any number of consumers read the stream with their
+ * own cursor at their own pace; reading never blocks
+ * the committing thread and never takes a lock. A
+ * consumer falling behind by more than the capacity
+ * of the ring skips the overwritten changes and the
+ * cursor counts them as lost.
+ *
+ * If an image capacity is given each insert and
+ * update carries the after-image of the object
+ * serialized with the object_serializer. The images
+ * are kept in a byte ring of the given size; an image
+ * overwritten before it was read is delivered empty.
+ *
+ * With asynchronous commit the changes are published
+ * by the writer thread once the group of transactions
+ * is committed to the database; a failed group is not
+ * published.
+ *
+ * There must only be one committing thread.
+ */
+class OOS_API change_stream
+{
+public:
+  /**
+   * The kinds of changes
+   */
+  typedef enum {
+    op_insert = 0,
+    op_update,
+    op_delete
+  } t_operation;
+
+  /**
+   * @brief One change read from the stream
+   */
+  struct change
+  {
+    std::uint64_t sequence;  /**< The position of the change in the stream. */
+    t_operation operation;   /**< The kind of the change. */
+    std::string type;        /**< The type of the changed object. */
+    unsigned long id;        /**< The id of the changed object. */
+    std::vector<char> image; /**< The serialized after-image or empty. */
+  };
+
+  /**
+   * @brief Reads a change_stream
+   */
+  class OOS_API cursor
+  {
+  public:
+    cursor();
+
+    /**
+     * Reads the next change. Returns false
+     * if there is no unread change.
+     *
+     * @param c The change to fill.
+     * @return True if a change was read.
+     */
+    bool next(change &c);
+
+    /**
+     * Returns the position of the
+     * last read change.
+     *
+     * @return The position of the last read change.
+     */
+    std::uint64_t position() const;
+
+    /**
+     * Returns the number of changes
+     * overwritten before they were read.
+     *
+     * @return The number of lost changes.
+     */
+    std::uint64_t lost() const;
+
+  private:
+    friend class change_stream;
+
+    cursor(const change_stream *stream, std::uint64_t position);
+
+    const change_stream *stream_;
+    std::uint64_t position_;
+    std::uint64_t lost_;
+  };
+
+public:
+  /**
+   * Creates a change stream.
+   *
+   * @param capacity The number of changes kept.
+   * @param image_capacity The bytes kept for after-images; 0 for none.
+   */
+  explicit change_stream(std::size_t capacity = 4096, std::size_t image_capacity = 0);
+  ~change_stream();
+
+  change_stream(const change_stream&) = delete;
+  change_stream& operator=(const change_stream&) = delete;
+
+  /**
+   * Returns a cursor reading all changes
+   * published from now on.
+   *
+   * @return A new cursor.
+   */
+  cursor subscribe() const;
+
+  /**
+   * Returns the position of the
+   * last published change.
+   *
+   * @return The position of the last change.
+   */
+  std::uint64_t head() const;
+
+  /**
+   * Returns the number of changes kept.
+   *
+   * @return The capacity of the stream.
+   */
+  std::size_t capacity() const;
+
+private:
+  friend class session;
+  friend class commit_pipeline;
+  friend class cursor;
+
+  class publisher;
+
+  struct slot
+  {
+    std::atomic<std::uint64_t> stamp;
+    std::atomic<int> operation;
+    std::atomic<const std::string*> type;
+    std::atomic<unsigned long> id;
+    std::atomic<std::uint64_t> image_begin;
+    std::atomic<std::uint32_t> image_size;
+  };
+
+  void publish(const transaction &tr, object_store &ostore);
+  void publish(t_operation op, const std::string &type, unsigned long id, const object *o);
+  std::uint32_t write_image(const object *o, std::uint64_t &begin);
+  bool read(std::uint64_t sequence, change &c) const;
+
+private:
+  std::size_t capacity_;
+  std::unique_ptr<slot[]> slots_;
+  std::atomic<std::uint64_t> head_;
+
+  std::size_t image_capacity_;
+  std::unique_ptr<std::atomic<char>[]> images_;
+  std::atomic<std::uint64_t> image_reserved_;
+  std::vector<char> image_buffer_;
+
+  // type names referenced by the slots; the
+  // stream owns them so they outlive the store
+  std::unordered_set<std::string> types_;
+};
+
+}
+
+#endif /* CHANGE_STREAM_HPP */
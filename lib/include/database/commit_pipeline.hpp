@@ -0,0 +1,188 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMIT_PIPELINE_HPP
+#define COMMIT_PIPELINE_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include "database/transaction.hpp"
+#include "database/commit_planner.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace oos {
+
+class session;
+class prototype_node;
+class object_proxy;
+
+/**
+ * @cond OOS_DEV
+ * @class commit_pipeline
+ * @brief Writes committed transactions in a background thread
+ *
+ * On commit the actions of a transaction are
+ * turned into a batch: the inserted and updated
+ * objects are serialized into the batch, so the
+ * objects may be modified right after the commit
+ * returned. The batch is queued and the committing
+ * thread gets a ticket.
+ *
+ * The writer thread takes all queued batches at
+ * once and writes them within one database
+ * transaction (group commit). An object written
+ * more than once within one group is only written
+ * once. When the database transaction is committed
+ * the changes of the group are published to the
+ * change streams of the session and the tickets of
+ * all batches of the group are made ready; on
+ * failure they carry the exception.
+ *
+ * If the queued batches exceed the given number of
+ * bytes a commit blocks until the writer caught up.
+ */
+class OOS_API commit_pipeline
+{
+public:
+  /**
+   * Creates a pipeline writing to the
+   * database of the given session and
+   * starts the writer thread.
+   *
+   * @param db The session to write to.
+   * @param max_queued_bytes The maximum size of the queued batches.
+   */
+  commit_pipeline(session &db, std::size_t max_queued_bytes);
+
+  /**
+   * Writes all queued batches and
+   * stops the writer thread.
+   */
+  ~commit_pipeline();
+
+  commit_pipeline(const commit_pipeline&) = delete;
+  commit_pipeline& operator=(const commit_pipeline&) = delete;
+
+  /**
+   * Queues the planned actions of a transaction.
+   * Blocks while the queue is full. Once a batch
+   * failed a database_exception is thrown until
+   * the error is taken with flush().
+   *
+   * @param plan The planned actions to queue.
+   * @return The ticket of the transaction.
+   */
+  commit_ticket push(const commit_planner::t_action_vector &plan);
+
+  /**
+   * Waits until all queued batches are written.
+   */
+  void wait();
+
+  /**
+   * Waits until all queued batches are
+   * written. If a batch failed since the
+   * last flush the error is rethrown.
+   */
+  void flush();
+
+  /**
+   * Returns true if a batch failed and
+   * the error wasn't taken yet.
+   *
+   * @return True if a batch failed.
+   */
+  bool failed() const;
+
+  /**
+   * Returns the size of the queued batches.
+   *
+   * @return The size of the queued batches.
+   */
+  std::size_t queued_bytes() const;
+
+private:
+  struct record
+  {
+    enum t_kind { INSERT, UPDATE, REMOVE };
+
+    t_kind kind;
+    std::string type;
+    unsigned long id;
+    prototype_node *node;
+  };
+
+  struct batch
+  {
+    batch() : bytes(0) {}
+
+    std::vector<record> records;
+    byte_buffer buffer;
+    std::size_t bytes;
+    std::promise<void> done;
+  };
+
+  typedef std::unique_ptr<batch> batch_ptr;
+  typedef std::deque<batch_ptr> t_batch_queue;
+
+  class record_collector;
+
+  void run();
+  void write(t_batch_queue &group);
+  void publish(const t_batch_queue &group, const std::vector<object_proxy*> &restored);
+
+private:
+  session &db_;
+  std::size_t max_queued_bytes_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable queued_;
+  std::condition_variable written_;
+  t_batch_queue queue_;
+  std::size_t queued_bytes_;
+  bool writing_;
+  bool stop_;
+  std::exception_ptr error_;
+
+  std::thread writer_;
+};
+/// @endcond
+
+}
+
+#endif /* COMMIT_PIPELINE_HPP */
@@ -0,0 +1,122 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMIT_PLANNER_HPP
+#define COMMIT_PLANNER_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace oos {
+
+class action;
+class object_store;
+class prototype_node;
+class transaction;
+
+/**
+ * @cond OOS_DEV
+ * @class commit_planner
+ * @brief Orders the actions of a transaction for commit
+ *
+ * The observers of a transaction produce its actions
+ * interleaved in the order of the modifications. The
+ * planner groups the actions by prototype and orders
+ * the prototypes so that a prototype follows all
+ * prototypes its objects refer to by object pointer
+ * or belong to as container items. The plan holds
+ * the inserts of all prototypes in this order, then
+ * the updates and finally the deletes in reverse order.
+ * Because each object has at most one action inside
+ * a transaction the plan is equivalent to the
+ * original order.
+ *
+ * Prototypes referring to each other keep the
+ * order of their first action.
+ */
+class OOS_API commit_planner
+{
+public:
+  typedef std::vector<action*> t_action_vector; /**< Shortcut for the planned actions. */
+  typedef std::vector<prototype_node*> t_node_vector; /**< Shortcut for a vector of prototype nodes. */
+
+  /**
+   * Creates a planner for the
+   * prototypes of the given store.
+   *
+   * @param ostore The object store of the prototypes.
+   */
+  explicit commit_planner(object_store &ostore);
+  ~commit_planner();
+
+  /**
+   * Plans the actions of the given transaction.
+   * The actions are still owned by the transaction.
+   *
+   * @param tr The transaction to plan.
+   * @param plan The vector receiving the ordered actions.
+   */
+  void plan(const transaction &tr, t_action_vector &plan);
+
+  /**
+   * Returns the prototypes whose objects must
+   * be inserted before the objects of the given
+   * prototype. The dependencies of a prototype
+   * are collected once and discarded when the
+   * prototypes of the store change.
+   *
+   * @param node The prototype node.
+   * @return The prototypes the node depends on.
+   */
+  const t_node_vector& dependencies(prototype_node *node);
+
+  /**
+   * Discards the collected dependencies.
+   */
+  void clear();
+
+private:
+  struct group;
+
+private:
+  object_store &ostore_;
+
+  // dependencies by dense node index
+  std::unordered_map<std::size_t, t_node_vector> dependencies_;
+  // generation of the prototype tree
+  // the dependencies were collected in
+  std::size_t generation_;
+};
+/// @endcond
+
+}
+
+#endif /* COMMIT_PLANNER_HPP */
@@ -35,6 +35,7 @@
 
 #include <string>
 #include <sstream>
+#include <vector>
 
 #ifdef _MSC_VER
 #include <memory>
@@ -62,7 +63,8 @@ public:
    * condition.
    */
   condition()
-    : valid_(false)
+    : count_(1)
+    , valid_(false)
   {}
   /**
    * Creates a new condition for
@@ -72,6 +74,7 @@ public:
    */
   condition(const std::string &c)
     : column_(c)
+    , count_(1)
     , valid_(false)
   {}
 
@@ -170,6 +173,34 @@ public:
     return *this;
   }
 
+  /**
+   * Evalutes the value of the column
+   * to be one of the given values. A
+   * prepared condition holds one host
+   * value for each given value.
+   * 
+   * @tparam T The type of the values.
+   * @param vals The values to compare.
+   * @return A reference to the condition.
+   */
+  template < class T >
+  condition& in(const std::vector<T> &vals)
+  {
+    op_ = " IN ";
+    type_ = type_traits<T>::data_type();
+    size_ = type_traits<T>::type_size();
+    std::stringstream list;
+    list << "(";
+    for (typename std::vector<T>::const_iterator i = vals.begin(); i != vals.end(); ++i) {
+      list << (i == vals.begin() ? "" : ", ") << *i;
+    }
+    list << ")";
+    value_ = list.str();
+    count_ = vals.size();
+    valid_ = !vals.empty();
+    return *this;
+  }
+
   /**
    * Evalutes the value of the column
    * to not null.
@@ -259,6 +290,17 @@ public:
     return size_;
   }
   
+  /**
+   * Returns the number of host
+   * values of the condition.
+   * 
+   * @return The number of host values.
+   */
+  unsigned long count() const
+  {
+    return count_;
+  }
+  
   /**
    * Returns the data type.
    * 
@@ -293,6 +335,7 @@ protected:
     op_ = op;
     type_ = type_traits<T>::data_type();
     size_ = type_traits<T>::type_size();
+    count_ = 1;
     value(val);
     valid_ = true;
   }
@@ -301,6 +344,7 @@ protected:
     op_ = op;
     type_ = type_traits<const char*>::data_type();
     size_ = type_traits<const char*>::type_size();
+    count_ = 1;
     value(std::string(val));
     valid_ = true;
   }
@@ -326,6 +370,7 @@ private:
   data_type_t type_;
   unsigned long size_;
   std::string value_;
+  unsigned long count_;
   std::string op_;
   std::string logic_;
   bool valid_;
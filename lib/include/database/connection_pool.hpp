@@ -0,0 +1,220 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONNECTION_POOL_HPP
+#define CONNECTION_POOL_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace oos {
+
+class session;
+class database;
+class result;
+class statement;
+class query;
+
+/**
+ * @class connection_pool
+ * @brief A pool of database connections of a session
+ *
+ * The connection pool opens a fixed number of
+ * additional connections to the database of
+ * its owning session. The connections are
+ * handed out to run read-only queries
+ * concurrently from several threads, while
+ * all modifications and commits still go
+ * through the owning session.
+ *
+ * Each connection keeps its prepared
+ * statements, so a statement prepared once
+ * on a connection is reused whenever the
+ * connection is acquired again.
+ *
+ * The connections are opened when the pool
+ * is created. Before a connection is handed
+ * out its health is checked and a broken
+ * connection is reopened.
+ */
+class OOS_API connection_pool
+{
+private:
+  struct entry;
+
+public:
+  /**
+   * @class connection
+   * @brief A connection acquired from the pool
+   *
+   * The connection is returned to the pool
+   * when it goes out of scope. A connection
+   * must only be used by one thread at a time.
+   */
+  class OOS_API connection
+  {
+  public:
+    connection();
+    connection(connection &&x);
+    connection& operator=(connection &&x);
+    ~connection();
+
+    connection(const connection&) = delete;
+    connection& operator=(const connection&) = delete;
+
+    /**
+     * Returns true if the connection
+     * is acquired from the pool.
+     *
+     * @return True if the connection is valid.
+     */
+    explicit operator bool() const;
+
+    /**
+     * Returns the connection to the pool.
+     * Afterwards the connection is invalid.
+     */
+    void release();
+
+    /**
+     * Returns the database of the connection.
+     *
+     * @return The database of the connection.
+     */
+    database& db();
+
+    /**
+     * Executes a sql string on the connection
+     * and returns the result. The caller takes
+     * the ownership of the result.
+     *
+     * @param sql The sql string to execute.
+     * @return The result of the query.
+     */
+    result* execute(const std::string &sql);
+
+    /**
+     * @brief Returns a prepared statement of the connection.
+     *
+     * If there is no statement with the given key
+     * on this connection, the query is built with
+     * the given function and prepared. Otherwise
+     * the cached statement is reset and returned.
+     * The statement is owned by the connection.
+     *
+     * @param key The unique key of the statement.
+     * @param build The function building the query.
+     * @return The prepared statement.
+     */
+    statement* prepare(const std::string &key, const std::function<void(query&)> &build);
+
+  private:
+    friend class connection_pool;
+
+    connection(connection_pool *pool, entry *e);
+
+  private:
+    connection_pool *pool_;
+    entry *entry_;
+  };
+
+  /**
+   * Creates a connection pool of the given
+   * size for the database of the session.
+   * All connections are opened. The memory
+   * database can't be pooled.
+   *
+   * @param owner The session owning the pool.
+   * @param size The number of connections.
+   */
+  connection_pool(session &owner, std::size_t size);
+  ~connection_pool();
+
+  connection_pool(const connection_pool&) = delete;
+  connection_pool& operator=(const connection_pool&) = delete;
+
+  /**
+   * Acquires a connection. If all connections
+   * are in use the call blocks until one
+   * is released.
+   *
+   * @return The acquired connection.
+   */
+  connection acquire();
+
+  /**
+   * Acquires a connection waiting at most the
+   * given time. If no connection becomes
+   * available an invalid connection is returned.
+   *
+   * @param timeout The time to wait.
+   * @return The acquired connection.
+   */
+  connection acquire(const std::chrono::milliseconds &timeout);
+
+  /**
+   * Returns the number of connections.
+   *
+   * @return The number of connections.
+   */
+  std::size_t size() const;
+
+  /**
+   * Returns the number of idle connections.
+   *
+   * @return The number of idle connections.
+   */
+  std::size_t available() const;
+
+private:
+  connection checked(entry *e);
+  void release(entry *e);
+  void clear();
+
+private:
+  session &owner_;
+
+  std::vector<std::unique_ptr<entry> > entries_;
+  std::vector<entry*> idle_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable released_;
+};
+
+}
+
+#endif /* CONNECTION_POOL_HPP */
@@ -37,10 +37,13 @@
 
 #include "tools/sequencer.hpp"
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <unordered_map>
 #include <map>
 #include <list>
+#include <vector>
 
 namespace oos {
 
@@ -51,6 +54,8 @@ class table;
 class result;
 class database_sequencer;
 class prototype_node;
+class statement_metrics;
+class slow_query_log;
 
 /// @cond OOS_DEV
 /**
@@ -108,17 +113,26 @@ public:
    */
   virtual bool is_open() const = 0;
 
+  /**
+   * Returns true if the database connection
+   * is alive. The default implementation
+   * returns true if the database is open.
+   *
+   * @return True on a working connection.
+   */
+  virtual bool ping();
+
   /**
    * Create all tables.
    */
-  void create();
+  virtual void create();
 
   /**
    * Create a table from the given object.
    *
    * @param o The object providing the table layout.
    */
-  void create(const prototype_node &node);
+  virtual void create(const prototype_node &node);
 
   /**
    * Drops table defined by the given
@@ -126,12 +140,12 @@ public:
    *
    * @param o The object providing the table layout.
    */
-  void drop(const prototype_node &node);
+  virtual void drop(const prototype_node &node);
 
   /**
    * Drop all tables.
    */
-  void drop();
+  virtual void drop();
 
   /**
    * Insert the object into the database
@@ -155,7 +169,7 @@ public:
    *
    * @param node The node representing the table to read
    */
-  void load(const prototype_node &node);
+  virtual void load(const prototype_node &node);
 
   /**
    * Checks if a specific table was loaded.
@@ -257,9 +271,100 @@ public:
 
   database_sequencer_ptr seq() const;
 
+  /**
+   * Starts collecting statement metrics.
+   * Already collected metrics are kept.
+   */
+  void enable_metrics();
+
+  /**
+   * Stops collecting statement metrics
+   * and discards the collected metrics.
+   */
+  void disable_metrics();
+
+  /**
+   * Returns the collected statement metrics
+   * or nullptr if metrics are disabled.
+   *
+   * @return The statement metrics or nullptr.
+   */
+  statement_metrics* metrics() const;
+
+  /**
+   * Starts logging statements taking at least
+   * the given threshold. A running log gets the
+   * new threshold and keeps its statements.
+   *
+   * @param threshold The minimum duration of a logged statement.
+   * @param capacity The maximum number of kept statements.
+   */
+  void enable_slow_query_log(std::chrono::nanoseconds threshold, std::size_t capacity = 128);
+
+  /**
+   * Stops logging slow statements and
+   * discards the logged statements.
+   */
+  void disable_slow_query_log();
+
+  /**
+   * Returns the slow query log or
+   * nullptr if it is disabled.
+   *
+   * @return The slow query log or nullptr.
+   */
+  slow_query_log* slow_queries() const;
+
+  /**
+   * @brief Logs a slow statement
+   *
+   * If the duration reaches the threshold of the
+   * slow query log the statement is logged. If
+   * enabled the query plan of the sql is captured
+   * on its first logged execution.
+   *
+   * @param sql The sql of the statement.
+   * @param parameters Summary of the bound parameters.
+   * @param rows Number of affected or loaded rows.
+   * @param duration The duration in nanoseconds.
+   */
+  void log_slow_query(const std::string &sql, const std::string &parameters, unsigned long rows, unsigned long long duration);
+
+  /**
+   * Returns the query plan of the given sql or
+   * an empty string if the backend can't explain
+   * it. Placeholders of a prepared sql are unbound.
+   *
+   * @param sql The sql to explain.
+   * @return The query plan.
+   */
+  virtual std::string explain(const std::string &sql);
+
+  /**
+   * Prepares a statement updating the given
+   * number of objects of a prototype at once.
+   * The objects are bound one after another.
+   * Returns nullptr if the database updates
+   * objects one by one.
+   *
+   * @param node The prototype node of the objects.
+   * @param rows The number of objects.
+   * @return The prepared statement or nullptr.
+   */
+  virtual statement* prepare_update(const prototype_node &node, std::size_t rows);
+
 protected:
   const session* db() const;
 
+  /**
+   * Returns the table of the given prototype
+   * node or nullptr if there is no table.
+   *
+   * @param node The prototype node of the table.
+   * @return The table or nullptr.
+   */
+  table* find_table(const prototype_node *node) const;
+
   session* db();
 
   virtual void on_open(const std::string &connection) = 0;
@@ -270,19 +375,51 @@ protected:
   virtual void on_rollback() = 0;
 
 
+private:
+  table_map_t::iterator bind_table(const prototype_node &node, const table_ptr &tbl);
+
+  /*
+   * executes the collected deletes of
+   * one table as batched statements
+   */
+  void flush_deletes();
+
+  /*
+   * executes the collected updates
+   * of one table
+   */
+  void flush_updates();
+
 private:
   friend class database_factory;
   friend class table;
   friend class table_reader;
   friend class query;
+  friend class connection_pool;
+  friend class commit_pipeline;
+  friend class database_sequencer;
 
   session *db_;
   bool commiting_;
+  bool pooled_;
 
   table_map_t table_map_;
+  // tables by dense prototype node index
+  std::vector<table*> table_index_;
+
+  // consecutive deletes of one table
+  table *delete_table_;
+  std::vector<long> delete_ids_;
+
+  // consecutive updates of one table
+  table *update_table_;
+  std::vector<object*> update_objects_;
 
   database_sequencer_ptr sequencer_;
   sequencer_impl_ptr sequencer_backup_;
+
+  std::unique_ptr<statement_metrics> metrics_;
+  std::unique_ptr<slow_query_log> slow_queries_;
 };
 
 /// @endcond
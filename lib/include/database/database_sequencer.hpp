@@ -24,6 +24,9 @@
 
 #include "tools/varchar.hpp"
 
+#include <atomic>
+#include <mutex>
+
 #ifdef _MSC_VER
   #ifdef oos_EXPORTS
     #define OOS_API __declspec(dllexport)
@@ -44,10 +47,33 @@ class statement;
 
 /// @cond OOS_DEV
 
+/**
+ * @class database_sequencer
+ * @brief Hands out ids from blocks reserved in the database
+ *
+ * The sequencer reserves a block of ids with one
+ * atomic update of the sequence row and hands out
+ * the ids of the block without further database
+ * access. Only when the block is exhausted the next
+ * block is reserved. Because the sequence row always
+ * holds the last reserved id several processes can
+ * share one database without id collisions. Ids of
+ * an unused block part are lost when the sequencer
+ * is closed.
+ *
+ * The sequencer is thread safe.
+ */
 class OOS_API database_sequencer : public sequencer_impl, public object_atomizable
 {
 public:
-  database_sequencer(database &db);
+  /**
+   * Creates a database sequencer reserving
+   * blocks of the given size.
+   *
+   * @param db The database of the sequence.
+   * @param block_size The number of ids reserved at once.
+   */
+  database_sequencer(database &db, long block_size = 64);
   virtual ~database_sequencer();
 
 public:
@@ -67,17 +93,59 @@ public:
   virtual void rollback();
   virtual void drop();
   virtual void destroy();
-  
+
+  /**
+   * Returns the number of ids
+   * reserved at once.
+   *
+   * @return The block size.
+   */
+  long block_size() const;
+
+  /**
+   * Sets the number of ids reserved
+   * at once. The size is applied when
+   * the next block is reserved.
+   *
+   * @param size The new block size.
+   */
+  void block_size(long size);
+
+  /**
+   * Returns the last id of the
+   * current block.
+   *
+   * @return The last reserved id.
+   */
+  long limit() const;
+
 protected:
   long backup_sequence() const;
   void backup_sequence(long backup);
 
+  /**
+   * Reserves the next count ids and returns
+   * the last reserved id.
+   *
+   * @param count The number of ids to reserve.
+   * @return The last reserved id.
+   */
+  virtual long reserve(long count);
+
+private:
+  long acquire();
+  void assign(long number);
+
 private:
   database &db_;
   long backup_;
-  long sequence_;
+  std::atomic<long> sequence_;
+  std::atomic<long> limit_;
+  long first_;
+  long block_size_;
+  std::mutex mutex_;
+  long number_;
   oos::varchar<64> name_;
-  statement *update_;
 };
 
 class dummy_database_sequencer : public database_sequencer
@@ -97,6 +165,9 @@ public:
   virtual void drop() {}
   virtual void destroy() {}
 
+protected:
+  virtual long reserve(long count) { return limit() + count; }
+
 private:
   long backup_;
 };
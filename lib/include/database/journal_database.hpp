@@ -0,0 +1,156 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOURNAL_DATABASE_HPP
+#define JOURNAL_DATABASE_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include "database/database.hpp"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace oos {
+
+/**
+ * @class journal_database
+ * @brief Makes the object store durable with a write-ahead journal
+ *
+ * The journal database keeps no tables. On commit
+ * the inserted, updated and deleted objects of the
+ * transaction are serialized into one frame which
+ * is appended to the journal file and synced to
+ * disk. Together with the asynchronous commit of
+ * the session consecutive transactions share one
+ * frame and one sync.
+ *
+ * Loading reads the last snapshot and replays the
+ * journal on top of it. A torn frame at the end of
+ * the journal is dropped when the journal is opened.
+ * Compaction writes all objects of the store into a
+ * fresh snapshot and empties the journal.
+ *
+ * The connection string names the journal file, the
+ * snapshot is stored next to it with the extension
+ * ".snapshot". With the option compact=<bytes> the
+ * journal is compacted on commit once it exceeds the
+ * given size:
+ *
+ * @code
+ * session db(ostore, "journal://store.journal?compact=16777216");
+ * @endcode
+ */
+class OOS_API journal_database : public database
+{
+public:
+  explicit journal_database(session *db);
+  virtual ~journal_database();
+
+  virtual bool is_open() const;
+
+  /**
+   * Creates an empty journal and snapshot.
+   */
+  virtual void create();
+  virtual void create(const prototype_node&) {}
+
+  /**
+   * Removes the journal and the snapshot.
+   */
+  virtual void drop();
+  virtual void drop(const prototype_node&) {}
+
+  /**
+   * Reads the snapshot and replays the journal
+   * into the object store. All types are loaded
+   * on the first call; further calls are ignored.
+   */
+  virtual void load(const prototype_node &node);
+
+  virtual void visit(insert_action *a);
+  virtual void visit(update_action *a);
+  virtual void visit(delete_action *a);
+
+  /**
+   * Writes all objects of the store into a
+   * fresh snapshot and empties the journal.
+   */
+  void compact();
+
+  /**
+   * Returns the current size of the journal.
+   *
+   * @return The size of the journal in bytes.
+   */
+  long journal_size() const;
+
+  virtual result* create_result() { return 0; }
+  virtual statement* create_statement() { return 0; }
+
+  virtual const char* type_string(data_type_t) const { return 0; }
+
+protected:
+  virtual void on_open(const std::string &connection);
+  virtual void on_close();
+  virtual result* on_execute(const std::string &) { return 0; }
+  virtual void on_begin();
+  virtual void on_commit();
+  virtual void on_rollback();
+
+private:
+  typedef std::vector<char> t_frame;
+
+  struct entry
+  {
+    std::string type;
+    std::vector<char> data;
+  };
+  typedef std::map<unsigned long, entry> t_entry_map;
+
+  void open_journal();
+  void append(unsigned char op, const std::string &type, unsigned long id, const object *o);
+  long write(std::FILE *file, t_frame &frame);
+  long read(const std::string &path, t_entry_map *entries, long &sequence) const;
+
+private:
+  std::string path_;
+  std::FILE *journal_;
+  long journal_size_;
+  long compact_size_;
+  bool open_;
+  bool loaded_;
+
+  t_frame frame_;
+};
+
+}
+
+#endif /* JOURNAL_DATABASE_HPP */
@@ -32,6 +32,7 @@ public:
   virtual void write(const char *id, const std::string &x);
 	virtual void write(const char *id, const date &x);
 	virtual void write(const char *id, const time &x);
+	virtual void write(const char *id, const blob &x);
 	virtual void write(const char *id, const object_base_ptr &x);
   virtual void write(const char *id, const object_container &x);
   virtual void write(const char *id, const primary_key_base &x);
@@ -54,6 +55,7 @@ public:
   }
   void write_field(const char *id, data_type_t type, const oos::date &x);
   void write_field(const char *id, data_type_t type, const oos::time &x);
+  void write_field(const char *id, data_type_t type, const blob &x);
   void write_field(const char *id, data_type_t type, const std::string &x);
   void write_field(const char *id, data_type_t type, const varchar_base &x);
   void write_field(const char *id, data_type_t type, const char *x);
@@ -81,7 +81,7 @@ public:
     return values_.at(pos).get<T>();
   }
 
-  std::string str(size_t pos)
+  const std::string& str(size_t pos) const
   {
     return values_.at(pos).val();
   }
@@ -37,11 +37,15 @@
 #include "tools/library.hpp"
 
 #include "database/transaction.hpp"
+#include "database/commit_planner.hpp"
 
+#include <chrono>
 #include <string>
 #include <stack>
 #include <map>
 #include <memory>
+#include <vector>
+#include <cstddef>
 
 namespace oos {
 
@@ -49,6 +53,10 @@ class object_store;
 class result;
 class statement;
 class database;
+class commit_pipeline;
+class change_stream;
+class statement_metrics;
+class slow_query_log;
 
 /**
  * @class session
@@ -250,10 +258,136 @@ public:
    */
   database& db();
 
+  /**
+   * @brief Commits transactions in a background thread
+   *
+   * From now on a committed transaction is queued
+   * and written to the database by a writer thread.
+   * Consecutive transactions are written within
+   * one database transaction. A commit blocks while
+   * the queued transactions exceed the given size.
+   *
+   * A commit returns once the object_store holds the
+   * committed state; the ticket of the transaction
+   * (see transaction::ticket()) tells when it is
+   * written. If writing fails the store is not rolled
+   * back and diverges from the database. The session
+   * then refuses further commits with a
+   * database_exception until flush() has thrown the
+   * error; reload the store to get in sync again.
+   *
+   * @param max_queued_bytes The maximum size of the queued transactions.
+   */
+  void enable_async_commit(std::size_t max_queued_bytes = 1 << 22);
+
+  /**
+   * Writes all queued transactions and
+   * commits synchronously again.
+   */
+  void disable_async_commit();
+
+  /**
+   * Returns true if transactions are
+   * committed asynchronously.
+   *
+   * @return True on asynchronous commit.
+   */
+  bool async_commit_enabled() const;
+
+  /**
+   * Returns true if writing a queued transaction
+   * failed and the error wasn't taken by flush().
+   *
+   * @return True if an asynchronous commit failed.
+   */
+  bool async_commit_failed() const;
+
+  /**
+   * @brief Waits until all queued transactions are written.
+   *
+   * If writing a queued transaction failed
+   * since the last flush the error is thrown.
+   */
+  void flush();
+
+  /**
+   * @brief Attaches a change stream to the session
+   *
+   * From now on the changes of all committed
+   * transactions are published to the stream.
+   * With asynchronous commit a change is published
+   * once its transaction is written to the database.
+   *
+   * @param stream The change stream to attach.
+   */
+  void attach(change_stream &stream);
+
+  /**
+   * Detaches a change stream from the session.
+   *
+   * @param stream The change stream to detach.
+   */
+  void detach(change_stream &stream);
+
+  /**
+   * @brief Starts collecting statement metrics
+   *
+   * From now on the database records calls, rows,
+   * bound bytes and latency histograms for each
+   * statement (see statement_metrics).
+   */
+  void enable_metrics();
+
+  /**
+   * Stops collecting statement metrics
+   * and discards the collected metrics.
+   */
+  void disable_metrics();
+
+  /**
+   * @brief Returns the collected statement metrics
+   *
+   * Returns nullptr if metrics are disabled.
+   * With asynchronous commit the metrics are
+   * complete after flush().
+   *
+   * @return The statement metrics or nullptr.
+   */
+  const statement_metrics* metrics() const;
+
+  /**
+   * @brief Starts logging slow statements
+   *
+   * From now on each statement taking at least
+   * the threshold is logged (see slow_query_log).
+   * A running log gets the new threshold.
+   *
+   * @param threshold The minimum duration of a logged statement.
+   * @param capacity The maximum number of kept statements.
+   */
+  void enable_slow_query_log(std::chrono::nanoseconds threshold, std::size_t capacity = 128);
+
+  /**
+   * Stops logging slow statements and
+   * discards the logged statements.
+   */
+  void disable_slow_query_log();
+
+  /**
+   * Returns the slow query log to read the logged
+   * statements, to enable capturing query plans or
+   * to set a sink. Returns nullptr if it is disabled.
+   *
+   * @return The slow query log or nullptr.
+   */
+  slow_query_log* slow_queries() const;
+
 private:
   friend class transaction;
   friend class statement;
   friend class query;
+  friend class connection_pool;
+  friend class commit_pipeline;
   
   void push_transaction(transaction *tr);
   void pop_transaction();
@@ -262,6 +396,8 @@ private:
 
   void begin(transaction &tr);
   void commit(transaction &tr);
+  commit_ticket commit_async(transaction &tr);
+  void publish(const transaction &tr);
   void rollback();
 
   /**
@@ -280,6 +416,13 @@ private:
   object_store &ostore_;
 
   std::stack<transaction*> transaction_stack_;
+
+  std::unique_ptr<commit_pipeline> pipeline_;
+
+  commit_planner planner_;
+  commit_planner::t_action_vector plan_;
+
+  std::vector<change_stream*> streams_;
 };
 
 }
@@ -0,0 +1,232 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SLOW_QUERY_LOG_HPP
+#define SLOW_QUERY_LOG_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oos {
+
+class object_atomizable;
+
+/**
+ * @brief One logged slow statement
+ */
+struct slow_query
+{
+  std::string sql;             /**< The prepared or ad-hoc sql of the statement. */
+  std::string parameters;      /**< Summary of the bound parameters. */
+  unsigned long rows;          /**< Number of affected or loaded rows. */
+  unsigned long long duration; /**< Duration in nanoseconds. */
+  std::string plan;            /**< The query plan or empty. */
+};
+
+/**
+ * @class slow_query_sink
+ * @brief Receives the logged slow statements
+ *
+ * A sink is called by the thread executing
+ * the statement while the log is locked.
+ * It must not access the log itself.
+ */
+class OOS_API slow_query_sink
+{
+public:
+  virtual ~slow_query_sink() {}
+
+  /**
+   * Called for each logged statement.
+   *
+   * @param query The slow statement.
+   */
+  virtual void log(const slow_query &query) = 0;
+};
+
+/**
+ * @class slow_query_log
+ * @brief Logs statements exceeding a threshold
+ *
+ * Each statement executed by the database that
+ * takes at least the threshold is logged with its
+ * sql, a summary of its bound parameters, its row
+ * count and its duration. The log keeps the last
+ * logged statements in a bounded ring and passes
+ * each one on to an optional sink.
+ *
+ * If explaining is enabled the database captures
+ * the query plan of each distinct sql once (SQLite:
+ * EXPLAIN QUERY PLAN, MySQL: EXPLAIN) and attaches
+ * it to every logged execution of the sql.
+ */
+class OOS_API slow_query_log
+{
+public:
+  typedef std::vector<slow_query> t_query_vector; /**< Shortcut for a vector of slow statements. */
+
+  /**
+   * Creates a slow query log.
+   *
+   * @param threshold The minimum duration of a logged statement.
+   * @param capacity The maximum number of kept statements.
+   */
+  explicit slow_query_log(std::chrono::nanoseconds threshold, std::size_t capacity = 128);
+  ~slow_query_log();
+
+  /**
+   * Returns the threshold in nanoseconds.
+   *
+   * @return The threshold in nanoseconds.
+   */
+  unsigned long long threshold() const;
+
+  /**
+   * Sets the threshold.
+   *
+   * @param threshold The new threshold.
+   */
+  void threshold(std::chrono::nanoseconds threshold);
+
+  /**
+   * Returns true if a statement of the
+   * given duration is logged.
+   *
+   * @param duration The duration in nanoseconds.
+   * @return True if the statement is slow.
+   */
+  bool is_slow(unsigned long long duration) const;
+
+  /**
+   * Returns true if query plans are captured.
+   *
+   * @return True if query plans are captured.
+   */
+  bool explain() const;
+
+  /**
+   * Enables or disables capturing query plans.
+   *
+   * @param enable True to capture query plans.
+   */
+  void explain(bool enable);
+
+  /**
+   * Sets the sink receiving each logged statement.
+   * A nullptr removes the current sink.
+   *
+   * @param s The sink or nullptr.
+   */
+  void sink(slow_query_sink *s);
+
+  /**
+   * Logs a slow statement.
+   *
+   * @param query The slow statement.
+   */
+  void log(const slow_query &query);
+
+  /**
+   * Returns the kept statements, the
+   * oldest statement first.
+   *
+   * @return The kept statements.
+   */
+  t_query_vector queries() const;
+
+  /**
+   * Returns the maximum number of kept statements.
+   *
+   * @return The capacity of the ring.
+   */
+  std::size_t capacity() const;
+
+  /**
+   * Returns the number of logged statements
+   * including the ones dropped from the ring.
+   *
+   * @return The number of logged statements.
+   */
+  unsigned long logged() const;
+
+  /**
+   * Removes all kept statements
+   * and captured query plans.
+   */
+  void clear();
+
+  /**
+   * Returns the captured plan of the given sql.
+   *
+   * @param sql The sql of the statement.
+   * @param plan The captured plan.
+   * @return True if there is a captured plan.
+   */
+  bool find_plan(const std::string &sql, std::string &plan) const;
+
+  /**
+   * Stores the captured plan of the given sql.
+   *
+   * @param sql The sql of the statement.
+   * @param plan The captured plan.
+   */
+  void add_plan(const std::string &sql, const std::string &plan);
+
+  /**
+   * Returns a summary of the attributes of the
+   * given object as bound to a statement. Long
+   * strings are shortened and blobs are reported
+   * by size.
+   *
+   * @param o The bound object.
+   * @return The parameter summary.
+   */
+  static std::string parameters(const object_atomizable *o);
+
+private:
+  mutable std::mutex mutex_;
+  std::atomic<unsigned long long> threshold_;
+  std::atomic<bool> explain_;
+  slow_query_sink *sink_;
+  std::size_t capacity_;
+  t_query_vector ring_;
+  std::size_t next_;
+  unsigned long logged_;
+  std::unordered_map<std::string, std::string> plans_;
+};
+
+}
+
+#endif /* SLOW_QUERY_LOG_HPP */
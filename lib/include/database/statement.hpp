@@ -54,10 +54,24 @@ public:
 
   virtual result* execute() = 0;
 
+  /*
+   * executes a statement returning no rows
+   * and returns the number of affected rows
+   * without creating a result
+   */
+  virtual unsigned long execute_update();
+
   virtual void reset() = 0;
   
   int bind(object_atomizable *o);
 
+  /*
+   * binds the object to the host values following
+   * the given position without resetting the
+   * statement and returns the next position
+   */
+  int bind(object_atomizable *o, int pos);
+
   template < class T >
   int bind(unsigned long i, const T &val)
   {
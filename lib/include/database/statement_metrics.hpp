@@ -0,0 +1,294 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATEMENT_METRICS_HPP
+#define STATEMENT_METRICS_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace oos {
+
+class object_atomizable;
+
+/**
+ * @class latency_histogram
+ * @brief Log bucketed histogram of durations
+ *
+ * Bucket i counts the durations d with
+ * 2^i <= d < 2^(i+1) nanoseconds, bucket zero
+ * additionally counts durations below one
+ * nanosecond and the last bucket counts all
+ * longer durations.
+ */
+class OOS_API latency_histogram
+{
+public:
+  static const std::size_t bucket_count = 40; /**< Number of buckets, the last one starts at ~9 minutes. */
+
+  latency_histogram();
+
+  /**
+   * Records one duration.
+   *
+   * @param nanoseconds The duration in nanoseconds.
+   */
+  void record(unsigned long long nanoseconds);
+
+  /**
+   * Returns the number of recorded durations.
+   *
+   * @return The number of recorded durations.
+   */
+  unsigned long count() const;
+
+  /**
+   * Returns the sum of all recorded durations.
+   *
+   * @return The sum in nanoseconds.
+   */
+  unsigned long long total() const;
+
+  /**
+   * Returns the shortest recorded duration
+   * or zero if nothing was recorded.
+   *
+   * @return The shortest duration in nanoseconds.
+   */
+  unsigned long long min() const;
+
+  /**
+   * Returns the longest recorded duration.
+   *
+   * @return The longest duration in nanoseconds.
+   */
+  unsigned long long max() const;
+
+  /**
+   * Returns the number of durations
+   * recorded in the given bucket.
+   *
+   * @param i The index of the bucket.
+   * @return The number of durations.
+   */
+  unsigned long bucket(std::size_t i) const;
+
+  /**
+   * Returns the exclusive upper bound of
+   * the durations counted in the given bucket.
+   *
+   * @param i The index of the bucket.
+   * @return The upper bound in nanoseconds.
+   */
+  static unsigned long long upper_bound(std::size_t i);
+
+  /**
+   * @brief Returns an estimated percentile.
+   *
+   * The percentile is estimated by the upper
+   * bound of the bucket it falls into, limited
+   * by the longest recorded duration.
+   *
+   * @param p The percentile between 0 and 100.
+   * @return The estimated duration in nanoseconds.
+   */
+  unsigned long long percentile(double p) const;
+
+private:
+  unsigned long count_;
+  unsigned long long total_;
+  unsigned long long min_;
+  unsigned long long max_;
+  unsigned long buckets_[bucket_count];
+};
+
+/**
+ * @class statement_metrics
+ * @brief Execution metrics of the database statements
+ *
+ * The metrics are collected per statement. The
+ * prepared CRUD statements of a table are keyed
+ * by "<table>.<operation>" (insert, update, delete
+ * and select), ad-hoc queries are keyed by their
+ * SQL text with the operation "execute".
+ *
+ * Each entry counts the calls, the affected or
+ * loaded rows and the bytes bound to the statement
+ * and holds one latency histogram per phase:
+ *
+ * - prepare: preparing the statement
+ * - bind: binding the object to the statement
+ * - execute: executing the statement in the backend
+ * - fetch: fetching the result rows
+ * - materialize: creating the loaded objects
+ *
+ * The metrics are collected by a database once they
+ * are enabled via session::enable_metrics(). Until
+ * then a statement costs one pointer check only.
+ */
+class OOS_API statement_metrics
+{
+public:
+  /**
+   * The measured phases of a statement
+   */
+  typedef enum {
+    PREPARE = 0,
+    BIND,
+    EXECUTE,
+    FETCH,
+    MATERIALIZE,
+    PHASE_COUNT
+  } t_phase;
+
+  /**
+   * The metrics of one statement
+   */
+  struct entry
+  {
+    entry();
+
+    std::string table;                    /**< The table or empty for ad-hoc queries. */
+    std::string operation;                /**< The operation of the statement. */
+    unsigned long calls;                  /**< Number of executions. */
+    unsigned long rows;                   /**< Number of affected or loaded rows. */
+    unsigned long long bytes_bound;       /**< Number of bytes bound to the statement. */
+    latency_histogram phases[PHASE_COUNT]; /**< One histogram per phase. */
+  };
+
+  typedef std::map<std::string, entry> t_entry_map;    /**< Shortcut for the entry map. */
+  typedef t_entry_map::const_iterator const_iterator; /**< Shortcut for the entry iterator. */
+
+  /**
+   * @brief Measures the duration of one phase
+   *
+   * The duration from construction until stop()
+   * is recorded into the histogram of the given
+   * phase. A timer without an entry reads no clock
+   * unless it is explicitly timed.
+   */
+  class OOS_API timer
+  {
+  public:
+    /**
+     * Starts a timer for the phase of the entry.
+     *
+     * @param e The entry or nullptr.
+     * @param phase The phase to measure.
+     * @param timed True to measure without an entry.
+     */
+    timer(entry *e, t_phase phase, bool timed = false);
+    ~timer();
+
+    /**
+     * Stops the timer and records the duration.
+     * Returns the duration or zero if the timer
+     * doesn't measure. Further calls return zero.
+     *
+     * @return The duration in nanoseconds.
+     */
+    unsigned long long stop();
+
+  private:
+    entry *entry_;
+    t_phase phase_;
+    bool timed_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+public:
+  statement_metrics();
+  ~statement_metrics();
+
+  /**
+   * Returns the entry of the given key. If there
+   * is no such entry it is created for the given
+   * table and operation.
+   *
+   * @param key The key of the statement.
+   * @param table The table of the statement.
+   * @param operation The operation of the statement.
+   * @return The entry of the statement.
+   */
+  entry* acquire(const std::string &key, const std::string &table, const std::string &operation);
+
+  /**
+   * Returns the entry of the given key
+   * or nullptr if there is no such entry.
+   *
+   * @param key The key of the statement.
+   * @return The entry or nullptr.
+   */
+  const entry* find(const std::string &key) const;
+
+  /**
+   * Returns the entry of the given table
+   * and operation or nullptr.
+   *
+   * @param table The table of the statement.
+   * @param operation The operation of the statement.
+   * @return The entry or nullptr.
+   */
+  const entry* find(const std::string &table, const std::string &operation) const;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  /**
+   * Returns the number of entries.
+   *
+   * @return The number of entries.
+   */
+  std::size_t size() const;
+
+  /**
+   * Removes all entries.
+   */
+  void clear();
+
+  /**
+   * Returns the number of bytes the
+   * attributes of the given object
+   * occupy when bound to a statement.
+   *
+   * @param o The object to measure.
+   * @return The number of bytes.
+   */
+  static unsigned long long bound_bytes(const object_atomizable *o);
+
+private:
+  t_entry_map entries_;
+};
+
+}
+
+#endif /* STATEMENT_METRICS_HPP */
@@ -37,11 +37,13 @@
 
 #include "database/statement.hpp"
 #include "database/database.hpp"
+#include "database/statement_metrics.hpp"
 
 #include <memory>
 #include <unordered_map>
 #include <map>
 #include <list>
+#include <vector>
 
 namespace oos {
 
@@ -73,8 +75,10 @@ public:
   void load(object_store &ostore);
   void insert(object *obj);
   void update(object *obj);
+  void update(const std::vector<object*> &objs);
   void remove(object *obj);
   void remove(long id);
+  void remove(const std::vector<long> &ids);
   void drop();
 
   bool is_loaded() const;
@@ -85,6 +89,18 @@ protected:
   virtual database& db() { return db_; }
   virtual const database& db() const { return db_; }
 
+  /*
+   * returns the metrics entry of the given
+   * operation or nullptr if metrics are disabled
+   */
+  statement_metrics::entry* metrics(const char *operation) const;
+
+  /*
+   * executes a bound statement and records its
+   * metrics and its execution if it is slow
+   */
+  void execute(statement &stmt, statement_metrics::entry *m, const object *obj, long id);
+
 private:
   friend class relation_filler;
   friend class table_reader;
@@ -98,6 +114,15 @@ private:
   statement_ptr delete_;
   statement_ptr select_;
 
+  // batched deletes, prepared on first use
+  static const std::size_t delete_batch_sizes[3];
+  statement_ptr delete_batch_[3];
+
+  // multi row update if the database supports it
+  static const std::size_t update_batch_size;
+  statement_ptr update_batch_;
+  bool update_batch_prepared_;
+
   bool prepared_;
 
   bool is_loaded_;
@@ -35,6 +35,8 @@
 
 #include "tools/byte_buffer.hpp"
 
+#include <cstddef>
+#include <future>
 #include <unordered_map>
 #include <memory>
 #include <list>
@@ -48,6 +50,12 @@ class object_store;
 class object_proxy;
 class action;
 
+/**
+ * A commit ticket becomes ready when the
+ * transaction is written to the database.
+ */
+typedef std::shared_future<void> commit_ticket;
+
 /**
  * @class transaction
  * @brief The transaction class
@@ -101,10 +109,38 @@ public:
    *
    * Commit the started transaction. All object
    * insertions, modifications and deletions are
-   * written to the database.
+   * written to the database. If the session commits
+   * asynchronously the transaction is queued and
+   * ticket() tells when it is written.
+   *
+   * If the transaction couldn't be committed or
+   * queued an exception is thrown and the
+   * transaction stays open to be rolled back.
    */
   void commit();
 
+  /**
+   * @brief Commit the started transaction asynchronously.
+   *
+   * If the session commits asynchronously the
+   * transaction is queued and the returned ticket
+   * becomes ready once it is written to the
+   * database. Otherwise the transaction is written
+   * immediately and the ticket is ready.
+   *
+   * @return The ticket of the transaction.
+   */
+  commit_ticket commit_async();
+
+  /**
+   * Returns the ticket of the last asynchronous
+   * commit. The ticket is invalid if the last
+   * commit was written synchronously.
+   *
+   * @return The ticket of the last commit.
+   */
+  commit_ticket ticket() const;
+
   /**
    * @brief Abort and rollback the started transaction.
    *
@@ -134,10 +170,23 @@ public:
 
 private:
   typedef std::set<long> id_set_t;
-  typedef std::unordered_map<long, iterator> id_iterator_map_t;
+
+  /*
+   * the action of an object and for
+   * an inserted object its slot
+   * inside the insert action
+   */
+  struct action_slot
+  {
+    iterator action;
+    std::size_t slot;
+  };
+  typedef std::unordered_map<long, action_slot> id_iterator_map_t;
 
   friend class object_store;
   friend class session;
+  friend class change_stream;
+  friend class commit_planner;
   
   void backup(action *a, const object *o);
   void restore(action *a);
@@ -155,6 +204,8 @@ private:
   action_list_t action_list_;
 
   byte_buffer object_buffer_;
+
+  commit_ticket ticket_;
 };
 
 }
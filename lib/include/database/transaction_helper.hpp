@@ -89,11 +89,20 @@ public:
     : action_list_(action_list)
     , proxy_(0)
     , inserted_(false)
+    , slot_(0)
   {}
   virtual ~action_inserter() {}
 
   transaction::iterator insert(object_proxy *proxy);
 
+  /**
+   * Returns the slot of the last inserted
+   * proxy inside its insert action.
+   *
+   * @return The slot of the proxy.
+   */
+  std::size_t slot() const { return slot_; }
+
   virtual void visit(create_action*) {}
   virtual void visit(insert_action *a);
   virtual void visit(update_action *a);
@@ -104,6 +113,7 @@ private:
   transaction::action_list_t &action_list_;
   object_proxy *proxy_;
   bool inserted_;
+  std::size_t slot_;
 };
 
 class action_remover : public action_visitor
@@ -111,11 +121,24 @@ class action_remover : public action_visitor
 public:
   action_remover(transaction::action_list_t &action_list)
     : action_list_(action_list)
+    , proxy_(0)
     , id_(0)
+    , slot_(0)
+    , cancelled_(false)
   {}
   virtual ~action_remover() {}
 
-  bool remove(transaction::iterator i, object_proxy *proxy);
+  /**
+   * Removes the object of the given proxy from
+   * the action. An insert of the object is
+   * cancelled, an update is replaced by a delete.
+   *
+   * @param i The action of the object.
+   * @param proxy The proxy of the removed object.
+   * @param slot The slot of the proxy inside an insert action.
+   * @return True if the insert of the object was cancelled.
+   */
+  bool remove(transaction::iterator i, object_proxy *proxy, std::size_t slot);
 
   virtual void visit(create_action*) {}
   virtual void visit(insert_action *a);
@@ -128,6 +151,8 @@ private:
   transaction::iterator iter_;
   object_proxy *proxy_;
   unsigned long id_;
+  std::size_t slot_;
+  bool cancelled_;
 };
 /// @endcond
 
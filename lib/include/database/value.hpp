@@ -37,7 +37,7 @@ public:
   {}
   virtual ~value_base() {}
 
-  std::string val() const
+  const std::string& val() const
   {
     return val_;
   }
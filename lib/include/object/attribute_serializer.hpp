@@ -106,6 +106,7 @@ private:
   }
   void read_value(const char*, date&) {}
   void read_value(const char*, time&) {}
+  void read_value(const char*, blob&) {}
   void read_value(const char*, object_container&) {}
 
 private:
@@ -185,6 +186,8 @@ private:
     x.serialize(id, *this);
   }
 
+  void write_value(const char*, const blob&) {}
+
   void write_value(const char *id, const char *from, int)
   {
     if (id_ != id) {
@@ -261,6 +264,7 @@ public:
 
   void write_value(const char*, const date&) {}
   void write_value(const char*, const time&) {}
+  void write_value(const char*, const blob&) {}
   void write_value(const char*, const object_container&) {}
   void write_value(const char*, const primary_key_base &) {}
 
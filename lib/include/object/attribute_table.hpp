@@ -0,0 +1,317 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ATTRIBUTE_TABLE_HPP
+#define ATTRIBUTE_TABLE_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include "tools/convert.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace oos {
+
+class object;
+class object_base_ptr;
+class object_container;
+class varchar_base;
+class date;
+class time;
+class blob;
+
+/**
+ * @cond OOS_DEV
+ * @class attribute_table
+ * @brief Named access to the attributes of a type
+ *
+ * The attribute table of a type maps each attribute
+ * name to the location and the kind of the attribute
+ * inside an object of this type. The table is built
+ * once when the prototype of the type is inserted
+ * and is owned by the prototype node.
+ * Getting or setting an attribute by name is then
+ * a single lookup followed by a direct conversion
+ * instead of a complete (de)serialization of the
+ * object.
+ */
+class OOS_API attribute_table
+{
+public:
+  /**
+   * The kinds of attributes
+   */
+  typedef enum {
+    type_char = 0,
+    type_float,
+    type_double,
+    type_short,
+    type_int,
+    type_long,
+    type_unsigned_char,
+    type_unsigned_short,
+    type_unsigned_int,
+    type_unsigned_long,
+    type_bool,
+    type_char_pointer,
+    type_string,
+    type_varchar,
+    type_date,
+    type_time,
+    type_blob,
+    type_object_ptr,
+    type_container
+  } t_kind;
+
+  /**
+   * Location and kind of one attribute
+   */
+  struct attribute
+  {
+    std::ptrdiff_t offset; /**< Offset of the attribute from the object */
+    t_kind kind;           /**< Kind of the attribute */
+    int size;              /**< Capacity of a character array attribute */
+  };
+
+private:
+  typedef std::unordered_map<std::string, attribute> t_attribute_map;
+
+public:
+  attribute_table() {}
+  ~attribute_table() {}
+
+  /**
+   * @brief Builds the attribute table of a type.
+   *
+   * The attributes of the given object are collected.
+   * If one attribute isn't located inside the
+   * object or an attribute name isn't unique no
+   * table is built and the type is accessed by
+   * (de)serialization.
+   *
+   * @param o An object of the type.
+   * @param size The size of the type.
+   * @return The new attribute table or nullptr.
+   */
+  static attribute_table* build(object *o, std::size_t size);
+
+  /**
+   * Returns the attribute with the given name
+   * or nullptr if there is no such attribute.
+   *
+   * @param name The name of the attribute.
+   * @return The attribute or nullptr.
+   */
+  const attribute* find(const std::string &name) const;
+
+  /**
+   * Returns the number of attributes.
+   *
+   * @return The number of attributes.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Sets the value of a named attribute.
+   *
+   * The value is converted into the attribute
+   * of the given object.
+   *
+   * @tparam T The type of the value.
+   * @param o The object to modify.
+   * @param name The name of the attribute.
+   * @param from The value to set.
+   * @return True if the attribute was found and set.
+   */
+  template < class T >
+  bool set(object *o, const std::string &name, const T &from) const
+  {
+    const attribute *attr = find(name);
+    if (!attr) {
+      return false;
+    }
+    void *to = reinterpret_cast<char*>(o) + attr->offset;
+    switch (attr->kind) {
+      case type_char:
+        convert(from, *static_cast<char*>(to));
+        break;
+      case type_float:
+        convert(from, *static_cast<float*>(to));
+        break;
+      case type_double:
+        convert(from, *static_cast<double*>(to));
+        break;
+      case type_short:
+        convert(from, *static_cast<short*>(to));
+        break;
+      case type_int:
+        convert(from, *static_cast<int*>(to));
+        break;
+      case type_long:
+        convert(from, *static_cast<long*>(to));
+        break;
+      case type_unsigned_char:
+        convert(from, *static_cast<unsigned char*>(to));
+        break;
+      case type_unsigned_short:
+        convert(from, *static_cast<unsigned short*>(to));
+        break;
+      case type_unsigned_int:
+        convert(from, *static_cast<unsigned int*>(to));
+        break;
+      case type_unsigned_long:
+        convert(from, *static_cast<unsigned long*>(to));
+        break;
+      case type_bool:
+        convert(from, *static_cast<bool*>(to));
+        break;
+      case type_char_pointer:
+        convert(from, static_cast<char*>(to), attr->size);
+        break;
+      case type_string:
+        convert(from, *static_cast<std::string*>(to));
+        break;
+      case type_varchar:
+        convert(from, *static_cast<varchar_base*>(to));
+        break;
+      case type_object_ptr:
+        convert(from, *static_cast<object_base_ptr*>(to));
+        break;
+      default:
+        // date, time, blobs and containers can't be set
+        return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Gets the value of a named attribute.
+   *
+   * The attribute of the given object is
+   * converted into the value.
+   *
+   * @tparam T The type of the value.
+   * @param o The object to read.
+   * @param name The name of the attribute.
+   * @param to The value to assign.
+   * @param precision The precision of the value.
+   * @return True if the attribute was found.
+   */
+  template < class T >
+  bool get(const object *o, const std::string &name, T &to, int precision = -1) const
+  {
+    const attribute *attr = find(name);
+    if (!attr) {
+      return false;
+    }
+    const void *from = reinterpret_cast<const char*>(o) + attr->offset;
+    switch (attr->kind) {
+      case type_char:
+        get(*static_cast<const char*>(from), to, precision);
+        break;
+      case type_float:
+        get(*static_cast<const float*>(from), to, precision);
+        break;
+      case type_double:
+        get(*static_cast<const double*>(from), to, precision);
+        break;
+      case type_short:
+        get(*static_cast<const short*>(from), to, precision);
+        break;
+      case type_int:
+        get(*static_cast<const int*>(from), to, precision);
+        break;
+      case type_long:
+        get(*static_cast<const long*>(from), to, precision);
+        break;
+      case type_unsigned_char:
+        get(*static_cast<const unsigned char*>(from), to, precision);
+        break;
+      case type_unsigned_short:
+        get(*static_cast<const unsigned short*>(from), to, precision);
+        break;
+      case type_unsigned_int:
+        get(*static_cast<const unsigned int*>(from), to, precision);
+        break;
+      case type_unsigned_long:
+        get(*static_cast<const unsigned long*>(from), to, precision);
+        break;
+      case type_bool:
+        get(*static_cast<const bool*>(from), to, precision);
+        break;
+      case type_char_pointer:
+        get(static_cast<const char*>(from), to, precision);
+        break;
+      case type_string:
+        get(*static_cast<const std::string*>(from), to, precision);
+        break;
+      case type_varchar:
+        get(*static_cast<const varchar_base*>(from), to, precision);
+        break;
+      case type_date:
+        get(*static_cast<const date*>(from), to, precision);
+        break;
+      case type_time:
+        get(*static_cast<const time*>(from), to, precision);
+        break;
+      case type_blob:
+        // blobs can't be converted
+        return false;
+      case type_object_ptr:
+        get(*static_cast<const object_base_ptr*>(from), to, precision);
+        break;
+      case type_container:
+        get(*static_cast<const object_container*>(from), to, precision);
+        break;
+    }
+    return true;
+  }
+
+private:
+  template < class V, class T >
+  static void get(const V &from, T &to, int precision)
+  {
+    if (precision < 0) {
+      convert(from, to);
+    } else {
+      convert(from, to, precision);
+    }
+  }
+
+private:
+  friend class attribute_scanner;
+
+  t_attribute_map attributes_;
+};
+/// @endcond
+
+}
+
+#endif /* ATTRIBUTE_TABLE_HPP */
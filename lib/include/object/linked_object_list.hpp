@@ -34,6 +34,10 @@
 #include "object/object_container.hpp"
 #include "object/prototype_node.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 /*
  *   linked_object_list layout:
  * 
@@ -734,6 +738,152 @@ public:
     return first;
   }
 
+  /**
+   * @brief Moves all elements of the other list before pos.
+   *
+   * All elements of the other list are moved
+   * before the given position. The items are
+   * only relinked, not recreated.
+   *
+   * @param pos The position where to insert the elements.
+   * @param other The list to take the elements from.
+   */
+  void splice(iterator pos, linked_object_list &other)
+  {
+    splice(pos, other, other.begin(), other.end());
+  }
+
+  /**
+   * @brief Moves one element of the other list before pos.
+   *
+   * The element at the given iterator of the other
+   * list is moved before the given position. The item
+   * is only relinked, not recreated.
+   *
+   * @param pos The position where to insert the element.
+   * @param other The list to take the element from.
+   * @param i The element to move.
+   */
+  void splice(iterator pos, linked_object_list &other, iterator i)
+  {
+    iterator last = i;
+    splice(pos, other, i, ++last);
+  }
+
+  /**
+   * @brief Moves a range of the other list before pos.
+   *
+   * The elements of the range [first, last) of the
+   * other list are moved before the given position.
+   * The items are only relinked, not recreated. The
+   * other list may be this list. In this case only
+   * the surrounding items are modified, otherwise the
+   * list references of each moved item are updated
+   * as well.
+   *
+   * @param pos The position where to insert the elements.
+   * @param other The list to take the elements from.
+   * @param first The first element of the range.
+   * @param last The end of the range.
+   */
+  void splice(iterator pos, linked_object_list &other, iterator first, iterator last)
+  {
+    if (!ostore() || ostore() != other.ostore()) {
+      throw object_exception("invalid object_store pointer");
+    }
+    if (first == last || (&other == this && (pos == first || pos == last))) {
+      return;
+    }
+    item_ptr node = pos.optr();
+    item_ptr head = first.optr();
+    item_ptr tail = (--last).optr();
+
+    // mark all items whose links will change
+    mark_modified(proxy(head->prev()));
+    mark_modified(proxy(tail->next()));
+    mark_modified(proxy(node->prev()));
+    mark_modified(proxy(node));
+
+    if (&other != this) {
+      // move items into this list
+      mark_modified(owner());
+      mark_modified(other.owner());
+      typename item_type::container_ref container(owner());
+      object_proxy *node_proxy = proxy(head);
+      object_proxy *tail_proxy = proxy(tail);
+      while (true) {
+        mark_modified(node_proxy);
+        item_type *item = static_cast<item_type*>(node_proxy->obj);
+        item->first_.reset(proxy(first_));
+        item->last_.reset(proxy(last_));
+        item->container(container);
+        if (node_proxy == tail_proxy) {
+          break;
+        }
+        node_proxy = proxy(item->next_);
+      }
+    } else {
+      mark_modified(proxy(head));
+      mark_modified(proxy(tail));
+    }
+
+    // unlink range from other list
+    head->prev()->next_ = tail->next();
+    tail->next()->prev_ = head->prev();
+
+    // link range before given position
+    head->prev_ = node->prev();
+    head->prev()->next_ = head;
+    tail->next_ = node;
+    node->prev_ = tail;
+  }
+
+  /**
+   * @brief Reverses the order of the elements.
+   *
+   * The items are only relinked, not recreated.
+   */
+  void reverse()
+  {
+    proxy_vector_t nodes;
+    collect(nodes);
+    std::reverse(nodes.begin(), nodes.end());
+    relink(nodes);
+  }
+
+  /**
+   * @brief Sorts the elements in ascending order.
+   *
+   * The elements are compared by their values.
+   * The items are only relinked, not recreated.
+   */
+  void sort()
+  {
+    sort(std::less<value_type>());
+  }
+
+  /**
+   * @brief Sorts the elements with the given comparator.
+   *
+   * The elements are compared by their values. The
+   * sort is stable. The items are only relinked, not
+   * recreated and only items whose neighbours changed
+   * are marked as modified.
+   *
+   * @tparam Compare The type of the comparator.
+   * @param comp The comparator.
+   */
+  template < class Compare >
+  void sort(Compare comp)
+  {
+    proxy_vector_t nodes;
+    collect(nodes);
+    std::stable_sort(nodes.begin(), nodes.end(), [&comp](object_proxy *a, object_proxy *b) {
+      return comp(static_cast<item_type*>(a->obj)->value(), static_cast<item_type*>(b->obj)->value());
+    });
+    relink(nodes);
+  }
+
 protected:
   /**
    * @brief Executes the given function object for all elements.
@@ -759,6 +909,55 @@ protected:
 ///@endcond
 
 private:
+  typedef std::vector<object_proxy*> proxy_vector_t;
+
+  /*
+   * collect the proxies of all items
+   * between the first and last item
+   */
+  void collect(proxy_vector_t &nodes) const
+  {
+    object_proxy *node = proxy(first_->next_);
+    object_proxy *end = proxy(last_);
+    while (node != end) {
+      nodes.push_back(node);
+      node = proxy(static_cast<item_type*>(node->obj)->next_);
+    }
+  }
+
+  /*
+   * link the items in the given order
+   * between the first and last item and
+   * mark only items with changed links
+   */
+  void relink(const proxy_vector_t &nodes)
+  {
+    if (!ostore()) {
+      throw object_exception("invalid object_store pointer");
+    }
+    object_proxy *prev = proxy(first_);
+    object_proxy *curr = prev;
+    for (proxy_vector_t::size_type i = 0; i <= nodes.size(); ++i) {
+      object_proxy *next = (i < nodes.size() ? nodes[i] : proxy(last_));
+      item_type *item = static_cast<item_type*>(curr->obj);
+      if ((curr != prev && proxy(item->prev_) != prev) || proxy(item->next_) != next) {
+        mark_modified(curr);
+        if (curr != prev) {
+          item->prev_.reset(prev);
+        }
+        item->next_.reset(next);
+      }
+      prev = curr;
+      curr = next;
+    }
+    // finally the last item
+    item_type *item = static_cast<item_type*>(curr->obj);
+    if (proxy(item->prev_) != prev) {
+      mark_modified(curr);
+      item->prev_.reset(prev);
+    }
+  }
+
   virtual void append_proxy(object_proxy *) {};
 
   virtual void install(object_store *os)
@@ -32,6 +32,7 @@
 #endif
 
 #include "object/attribute_serializer.hpp"
+#include "object/attribute_table.hpp"
 #include "object/object_atomizer.hpp"
 #include "object/object_atomizable.hpp"
 #include "object/primary_key.hpp"
@@ -145,6 +146,10 @@ public:
   template < class T >
   bool set(const std::string &name, const T &val)
   {
+    const attribute_table *table = attributes();
+    if (table) {
+      return table->set(this, name, val);
+    }
     attribute_reader<T> reader(name, val);
     deserialize(reader);
     return reader.success();
@@ -163,6 +168,10 @@ public:
   template < class T >
   bool get(const std::string &name, T &val)
   {
+    const attribute_table *table = attributes();
+    if (table) {
+      return table->get(this, name, val);
+    }
     attribute_writer<T> writer(name, val);
     serialize(writer);
     return writer.success();
@@ -182,6 +191,10 @@ public:
   template < class T >
   bool get(const std::string &name, T &val, int precision)
   {
+    const attribute_table *table = attributes();
+    if (table) {
+      return table->get(this, name, val, precision);
+    }
     attribute_writer<T> writer(name, val, precision);
     serialize(writer);
     return writer.success();
@@ -308,8 +321,17 @@ protected:
    */
 //	void mark_modified();
 
+private:
+  /*
+   * returns the attribute table of the objects
+   * prototype or nullptr if the object isn't
+   * inserted or its type has no table
+   */
+  const attribute_table* attributes() const;
+
 private:
 	friend class object_store;
+  friend class object_proxy;
   friend class object_deleter;
   friend class object_base_ptr;
   friend class object_serializer;
@@ -321,7 +343,7 @@ private:
   friend class database;
 
 	primary_key<unsigned long> id_;
-//  object_proxy *proxy_;
+  object_proxy *proxy_;
 };
 
 }
@@ -40,6 +40,7 @@ class object_base_ptr;
 class primary_key_base;
 class date;
 class time;
+class blob;
 
 /**
  * @class object_writer
@@ -248,6 +249,18 @@ public:
    */
 	virtual void write(const char*, const time&) = 0;
 
+  /**
+   * @fn virtual void write(const char *id, const blob &x)
+   * @brief Write a blob to the atomizer.
+   *
+   * Write a blob to the atomizer
+   * identified by a unique name.
+   *
+   * @param id Unique id of the data.
+   * @param x The data to read from.
+   */
+	virtual void write(const char*, const blob&) = 0;
+
   /**
    * @fn virtual void write(const char *id, const object_base_ptr &x)
    * @brief Write a object_base_ptr to the atomizer.
@@ -316,6 +329,7 @@ public:
 	virtual void write(const char *id, const varchar_base &x) { generic_writer_->write_value(id, x); }
 	virtual void write(const char *id, const date &x) { generic_writer_->write_value(id, x); }
 	virtual void write(const char *id, const time &x) { generic_writer_->write_value(id, x); }
+	virtual void write(const char *id, const blob &x) { generic_writer_->write_value(id, x); }
 	virtual void write(const char *id, const object_base_ptr &x) { generic_writer_->write_value(id, x); }
   virtual void write(const char *id, const object_container &x) { generic_writer_->write_value(id, x); }
   virtual void write(const char *id, const primary_key_base &x) { generic_writer_->write_value(id, x); }
@@ -532,6 +546,18 @@ public:
   */
   virtual void read(const char*, time&) = 0;
 
+  /**
+  * @fn virtual void read(const char *id, blob &x)
+  * @brief Read a blob from the atomizer.
+  *
+  * Read a blob from the atomizer
+  * identified by a unique name.
+  *
+  * @param id Unique id of the data.
+  * @param x The data to write to.
+  */
+  virtual void read(const char*, blob&) = 0;
+
   /**
    * @fn virtual void read(const char *id, object_base_ptr &x)
    * @brief Read an object_base_ptr from the atomizer.
@@ -601,6 +627,7 @@ public:
 	virtual void read(const char *id, object_base_ptr &x) { generic_reader_->read_value(id, x); }
 	virtual void read(const char *id, date &x) { generic_reader_->read_value(id, x); }
 	virtual void read(const char *id, time &x) { generic_reader_->read_value(id, x); }
+	virtual void read(const char *id, blob &x) { generic_reader_->read_value(id, x); }
   virtual void read(const char *id, object_container &x) { generic_reader_->read_value(id, x); }
   virtual void read(const char *id, primary_key_base &x) { generic_reader_->read_value(id, x); }
 
@@ -156,6 +156,16 @@ public:
     return container_;
   }
 
+  /**
+   * Sets a new reference to the container
+   *
+   * @param c The new container reference
+   */
+  void container(const container_ref &c)
+  {
+    this->modify(container_, c);
+  }
+
 private:
   container_ref container_;
 };
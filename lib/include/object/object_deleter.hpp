@@ -36,7 +36,8 @@
 #include "primary_key.hpp"
 #include "object_proxy.hpp"
 
-#include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace oos {
 
@@ -66,14 +67,17 @@ private:
     unsigned long ref_count;
     unsigned long ptr_count;
     bool ignore;
+    bool visited;
   } t_object_count;
 
 private:
-  typedef std::map<unsigned long, t_object_count> t_object_count_map;
+  typedef std::vector<t_object_count> t_object_count_vector;
+  typedef std::unordered_map<unsigned long, t_object_count_vector::size_type> t_object_index_map;
+  typedef std::vector<object_proxy*> t_proxy_stack;
 
 public:
-  typedef t_object_count_map::iterator iterator;             /**< Shortcut the object map iterator */
-  typedef t_object_count_map::const_iterator const_iterator; /**< Shortcut the object map const_iterator */
+  typedef t_object_count_vector::iterator iterator;             /**< Shortcut the object count iterator */
+  typedef t_object_count_vector::const_iterator const_iterator; /**< Shortcut the object count const_iterator */
 
   /**
    * Creates an instance of the object_deleter
@@ -104,7 +108,8 @@ public:
    * @brief Returns the first deletable object.
    *
    * If the check was made and was successful this
-   * returns the first deletable object.
+   * returns the first deletable object. The objects
+   * are returned in the order they were found.
    */
   iterator begin();
 
@@ -129,7 +134,15 @@ public:
   bool check_object_count_map() const;
 
 private:
-  t_object_count_map object_count_map;
+  void clear();
+  t_object_count& acquire(object_proxy *proxy, bool ignore);
+  void visit(t_object_count &count);
+  void process();
+
+private:
+  t_object_count_vector object_count_vector_;
+  t_object_index_map object_index_map_;
+  t_proxy_stack proxy_stack_;
 };
 /// @endcond
 }
@@ -15,6 +15,9 @@
 #define OOS_API
 #endif
 
+#include <cstddef>
+#include <typeinfo>
+
 namespace oos {
 /**
 * @class object_base_producer
@@ -47,6 +50,14 @@ class OOS_API object_base_producer{
   * @return The classname of the object.
   */
   virtual const char *classname() const = 0;
+
+  /**
+  * Returns the size of the produced
+  * object type or zero if it is unknown.
+  *
+  * @return The size of the object type.
+  */
+  virtual std::size_t size() const { return 0; }
 };
 
 /**
@@ -83,6 +94,16 @@ public:
   {
     return typeid(T).name();
   }
+
+  /**
+  * Returns the size of the produced class
+  *
+  * @return the size of the produced class
+  */
+  virtual std::size_t size() const
+  {
+    return sizeof(T);
+  }
 };
 
 }
@@ -35,6 +35,7 @@
 #include <set>
 #include <list>
 #include <map>
+#include <cstddef>
 
 #include <memory>
 
@@ -220,6 +221,7 @@ public:
 
   object_store *ostore;    /**< The object_store to which the object_proxy belongs. */
   prototype_node *node;    /**< The prototype_node containing the type of the object. */
+  std::size_t node_index;  /**< The position inside the proxy directory of the prototype_node. */
 
   typedef std::set<object_base_ptr*> ptr_set_t; /**< Shortcut to the object_base_ptr_set. */
   ptr_set_t ptr_set_;      /**< This set contains every object_base_ptr pointing to this object_proxy. */
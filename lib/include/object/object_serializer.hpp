@@ -91,6 +91,8 @@ public:
    * @param o The object to deserialize.
    * @param buffer The byte_buffer to deserialize from.
    * @param ostore The object_store where the object resides.
+   *               Without a store object pointers keep
+   *               their id and containers stay empty.
    * @return True on success.
    */
   bool deserialize(object *o, byte_buffer *buffer, object_store *ostore);
@@ -107,6 +109,7 @@ public:
   void write_value(const char*, const varchar_base &s);
 	void write_value(const char* id, const date &x);
 	void write_value(const char* id, const time &x);
+	void write_value(const char* id, const blob &x);
 	void write_value(const char* id, const object_base_ptr &x);
 	void write_value(const char* id, const object_container &x);
 	void write_value(const char* id, const primary_key_base &);
@@ -122,6 +125,7 @@ public:
   void read_value(const char*, varchar_base &s);
   void read_value(const char* id, date &x);
   void read_value(const char* id, time &x);
+  void read_value(const char* id, blob &x);
   void read_value(const char* id, object_base_ptr &x);
 	void read_value(const char* id, object_container &x);
 	void read_value(const char* id, primary_key_base &x);
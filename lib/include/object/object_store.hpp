@@ -25,8 +25,11 @@
 #include "object/object_exception.hpp"
 
 #include "tools/sequencer.hpp"
+#include "tools/shared_mutex.hpp"
 
+#include <iterator>
 #include <memory>
+#include <type_traits>
 #include <unordered_map>
 
 #include <string>
@@ -197,12 +200,12 @@ public:
   template < class T >
   prototype_iterator find_prototype()
   {
-    return find_prototype(typeid(T).name());
+    return prototype_tree_.find<T>();
   }
   template < class T >
   const_prototype_iterator find_prototype() const
   {
-    return find_prototype(typeid(T).name());
+    return prototype_tree_.find<T>();
   }
 
   /**
@@ -319,13 +322,30 @@ public:
    */
   void remove(object_container &oc);
 
-  /*
-  template < class InputIterator >
-  void insert(InputIterator first, InputIterator last)
+  /**
+   * Inserts all objects of the given range of object
+   * pointers as one batch. The internal proxy map is
+   * resized once for the complete range. For each inserted
+   * object an object_ptr is written to the output iterator.
+   *
+   * @tparam ForwardIterator Iterator type of the object range.
+   * @tparam OutputIterator Iterator type receiving the object_ptr.
+   * @param first The first object of the range.
+   * @param last The end of the range.
+   * @param out The output iterator receiving the object_ptr.
+   * @return The output iterator past the last written object_ptr.
+   */
+  template < class ForwardIterator, class OutputIterator >
+  OutputIterator insert(ForwardIterator first, ForwardIterator last, OutputIterator out)
   {
-   // std::iterator_traits<InputIterator>::value_type *o = *first;
+    typedef typename std::remove_pointer<typename std::iterator_traits<ForwardIterator>::value_type>::type value_type;
+
+    object_map_.reserve(object_map_.size() + std::distance(first, last));
+    while (first != last) {
+      *out++ = object_ptr<value_type>(insert_object(*first++, true));
+    }
+    return out;
   }
-  */
   
   /**
    * @brief Register an observer with the object store
@@ -341,6 +361,26 @@ public:
    */
   void unregister_observer(object_observer *observer);
 
+  /**
+   * @brief Returns the reader/writer mutex of the store
+   *
+   * The store itself doesn't lock. To share a store
+   * between threads, readers hold the mutex shared
+   * (oos::shared_lock) while they iterate views and
+   * resolve object pointers. The one writer holds the
+   * mutex exclusively (std::lock_guard) while it inserts,
+   * modifies or removes objects. Object pointers
+   * copied by readers must be released before the
+   * shared lock is released.
+   *
+   * Readers must access objects through const object
+   * pointers; non const access marks the object modified
+   * and notifies the observers.
+   *
+   * @return The reader/writer mutex.
+   */
+  shared_mutex& mutex() const;
+
   /**
    * @brief Creates and inserts an object proxy object.
    * 
@@ -447,6 +487,8 @@ private:
   t_observer_list observer_list_;
 
   object_deleter object_deleter_;
+
+  mutable shared_mutex mutex_;
 };
 
 }
@@ -28,6 +28,7 @@
 #include "tools/conditional.hpp"
 
 #include <functional>
+#include <iterator>
 
 #include <vector>
 
@@ -213,6 +214,47 @@ public:
     return object_vector_.size();
   }
 
+  /**
+   * Reserves storage for at least n elements.
+   *
+   * @param n The number of elements to reserve storage for.
+   */
+  void reserve(size_type n)
+  {
+    object_vector_.reserve(n);
+  }
+
+  /**
+   * Returns the number of elements the vector
+   * can hold without reallocation.
+   *
+   * @return The capacity of the vector.
+   */
+  size_type capacity() const
+  {
+    return object_vector_.capacity();
+  }
+
+  /**
+   * Writes the ids of all item objects of the
+   * vector to the given output iterator. No
+   * value object_ptr is created.
+   *
+   * @tparam OutputIterator The type of the output iterator.
+   * @param out The output iterator receiving the ids.
+   * @return The output iterator past the last written id.
+   */
+  template < class OutputIterator >
+  OutputIterator ids(OutputIterator out) const
+  {
+    const_iterator first = object_vector_.begin();
+    const_iterator last = object_vector_.end();
+    while (first != last) {
+      *out++ = (first++)->id();
+    }
+    return out;
+  }
+
   /**
    * @brief Inserts a new element.
    * 
@@ -596,6 +638,53 @@ public:
     }
   }
 
+  /**
+   * @brief Inserts a range of elements.
+   *
+   * Inserts all elements of the given range at the
+   * given position. The parent object is marked modified
+   * once and the indices of all successor elements are
+   * adjusted once for the whole range.
+   *
+   * @tparam ForwardIterator The type of the range iterator.
+   * @param pos The position where to insert.
+   * @param first The first element of the range.
+   * @param last The end of the range.
+   * @return The position of the first inserted element.
+   */
+  template < class ForwardIterator >
+  iterator insert(iterator pos, ForwardIterator first, ForwardIterator last)
+  {
+    if (!object_container::ostore()) {
+      throw object_exception("invalid object_store pointer");
+    }
+    // mark list object as modified
+    this->mark_modified(this->owner());
+    for (ForwardIterator i = first; i != last; ++i) {
+      ref_setter(*i->get(), parent_ref(this->owner()));
+    }
+    pos = this->vector().insert(pos, first, last);
+    // adjust index
+    this->adjust_index(pos);
+    return pos;
+  }
+
+  /**
+   * Replaces the content of the vector with
+   * the elements of the given range.
+   *
+   * @tparam ForwardIterator The type of the range iterator.
+   * @param first The first element of the range.
+   * @param last The end of the range.
+   */
+  template < class ForwardIterator >
+  void assign(ForwardIterator first, ForwardIterator last)
+  {
+    this->clear();
+    this->reserve(std::distance(first, last));
+    insert(this->end(), first, last);
+  }
+
   virtual iterator erase(iterator i)
   {
     if (!this->ostore()) {
@@ -758,6 +847,87 @@ public:
     }
   }
 
+  /**
+   * @brief Inserts a range of elements.
+   *
+   * Inserts all elements of the given range at the
+   * given position. All item objects are inserted into
+   * the object_store as one batch, the parent object is
+   * marked modified once and the indices of all successor
+   * items are adjusted once for the whole range.
+   *
+   * @tparam ForwardIterator The type of the range iterator.
+   * @param pos The position where to insert.
+   * @param first The first element of the range.
+   * @param last The end of the range.
+   * @return The position of the first inserted element.
+   */
+  template < class ForwardIterator >
+  iterator insert(iterator pos, ForwardIterator first, ForwardIterator last)
+  {
+    if (!object_container::ostore()) {
+      throw object_exception("invalid object_store pointer");
+    }
+    size_type offset = pos - this->vector().begin();
+    size_type count = std::distance(first, last);
+    // determine index
+    typename item_type::size_type index = this->vector().size();
+    if (index && pos != this->vector().end()) {
+      index = (*pos)->index();
+    }
+    // create all items and insert them into
+    // the object_store as one batch
+    std::vector<item_type*> items;
+    items.reserve(count);
+    std::vector<item_holder> holders;
+    holders.reserve(count);
+    try {
+      while (first != last) {
+        items.push_back(new item_type(parent_ref(this->owner()), index++, *first++));
+      }
+      this->ostore()->insert(items.begin(), items.end(), std::back_inserter(holders));
+      // add the inserted items in place
+      pos = this->vector().insert(this->vector().begin() + offset, holders.begin(), holders.end());
+    } catch (...) {
+      // remove the inserted items from the store
+      for (typename std::vector<item_holder>::iterator i = holders.begin(); i != holders.end(); ++i) {
+        this->ostore()->remove(*i);
+      }
+      // delete the items the store didn't take; the
+      // store assigns the id once it owns the item
+      for (size_type i = holders.size(); i < items.size(); ++i) {
+        if (items[i]->id() == 0) {
+          delete items[i];
+        }
+      }
+      throw;
+    }
+    // mark list object as modified
+    this->mark_modified(this->owner());
+    // adjust indices of successor items
+    iterator i = pos + count;
+    iterator end = this->vector().end();
+    while (i != end) {
+      (*i++)->index(index++);
+    }
+    return pos;
+  }
+
+  /**
+   * Replaces the content of the vector with
+   * the elements of the given range.
+   *
+   * @tparam ForwardIterator The type of the range iterator.
+   * @param first The first element of the range.
+   * @param last The end of the range.
+   */
+  template < class ForwardIterator >
+  void assign(ForwardIterator first, ForwardIterator last)
+  {
+    this->clear();
+    insert(this->end(), first, last);
+  }
+
   virtual iterator erase(iterator i)
   {
     // erase object from object store
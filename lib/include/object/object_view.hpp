@@ -566,7 +566,11 @@ public:
    * @return The size of the generic_view.
    */
   size_t size() const {
-    return std::distance(begin(), end());
+    if (skip_siblings_) {
+      return node_->proxies.size();
+    } else {
+      return std::distance(begin(), end());
+    }
   }
   
   /**
@@ -750,7 +754,11 @@ public:
    * @return The size of the object_view.
    */
   size_t size() const {
-    return std::distance(begin(), end());
+    if (skip_siblings_) {
+      return node_->proxies.size();
+    } else {
+      return std::distance(begin(), end());
+    }
   }
   
   /**
@@ -798,7 +806,7 @@ public:
    */
   const prototype_node* node() const
   {
-    return node_;
+    return node_.get();
   }
 
 private:
@@ -34,6 +34,7 @@
 
 #include <map>
 #include <list>
+#include <vector>
 #include <memory>
 #include <string>
 #include "prototype_tree.hpp"
@@ -42,6 +43,7 @@ namespace oos {
 
 class object_base_producer;
 class object;
+class attribute_table;
 class prototype_tree;
 class object_proxy;
 
@@ -58,6 +60,11 @@ class object_proxy;
  * This list is defined by three marker: the beginning
  * of the list, the end of the own objects and the end of
  * the last child objects.
+ *
+ * Additionally the node holds a dense directory of
+ * all its own object proxies. The order of the directory
+ * is arbitrary (removal swaps in the last proxy) but it
+ * allows random access and cache friendly iteration.
  */ 
 class OOS_API prototype_node
 {
@@ -113,6 +120,32 @@ public:
    */
   unsigned long size() const;
   
+  /**
+   * Appends the given object proxy to the
+   * proxy directory of this node.
+   *
+   * @param proxy The object proxy to append.
+   */
+  void append_proxy(object_proxy *proxy);
+
+  /**
+   * Removes the given object proxy from the
+   * proxy directory of this node. The last
+   * proxy of the directory takes its place.
+   *
+   * @param proxy The object proxy to remove.
+   */
+  void remove_proxy(object_proxy *proxy);
+
+  /**
+   * Returns the object proxy at the given
+   * position of the proxy directory.
+   *
+   * @param i The position of the object proxy.
+   * @return The requested object proxy.
+   */
+  object_proxy* proxy_at(std::size_t i) const;
+
   /**
    * Appends the given prototype node to the list of children.
    * 
@@ -180,6 +213,7 @@ public:
 
   typedef std::pair<prototype_node*, std::string> prototype_field_info_t;    /**< Shortcut for prototype fieldname pair. */
   typedef std::map<std::string, prototype_field_info_t> field_prototype_map_t; /**< Holds the fieldname and the prototype_node. */
+  typedef std::vector<object_proxy*> proxy_vector_t; /**< Shortcut for the object proxy directory. */
 
   // tree links
   prototype_node *parent; /**< The parent node */
@@ -202,11 +236,16 @@ public:
   object_proxy *op_first;  /**< The marker of the first list node. */
   object_proxy *op_marker; /**< The marker of the last list node of the own elements. */
   object_proxy *op_last;   /**< The marker of the last list node of all elements. */
+
+  proxy_vector_t proxies;  /**< The dense directory of all own object proxies. */
   
   unsigned int depth;  /**< The depth of the node inside of the tree. */
+  std::size_t index;   /**< The dense index of the node inside of the tree. */
   unsigned long count; /**< The total count of elements. */
 
   std::string type;	   /**< The type name of the object */
+
+  attribute_table *attributes; /**< The named attribute access table or nullptr */
   
   bool abstract;       /**< Indicates wether this node holds a producer of an abstract object */
   bool initialized;    /**< Indicates wether this node is complete initialized or not */
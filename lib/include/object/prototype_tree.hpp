@@ -37,6 +37,8 @@
 #include "object/object_producer.hpp"
 
 #include <string>
+#include <typeinfo>
+#include <typeindex>
 #include <unordered_map>
 
 namespace oos {
@@ -388,6 +390,22 @@ public:
   iterator find(const char *type);
   const_iterator find(const char *type) const;
 
+  /**
+  * @brief Finds prototype node by type info.
+  *
+  * Finds and returns prototype node iterator identified
+  * by the given type info. Types with one prototype
+  * are registered by their type index on insert, so
+  * the lookup is a single hash probe.
+  * If the prototype couldn't be found prototype_iterator
+  * end is returned.
+  *
+  * @param ti Type info of the prototype
+  * @return Returns a prototype iterator.
+  */
+  iterator find(const std::type_info &ti);
+  const_iterator find(const std::type_info &ti) const;
+
   /**
   * @brief Finds prototype node by template type.
   * @tparam Template type.
@@ -401,12 +419,12 @@ public:
   template < class T >
   iterator find()
   {
-    return find(typeid(T).name());
+    return find(typeid(T));
   }
   template < class T >
   const_iterator find() const
   {
-    return find(typeid(T).name());
+    return find(typeid(T));
   }
 
   /**
@@ -432,6 +450,16 @@ public:
    */
   size_t prototype_count() const;
 
+  /**
+   * Returns the generation of the tree. The
+   * generation changes whenever a prototype is
+   * inserted or removed, so cached prototype
+   * information can be checked for validity.
+   *
+   * @return The generation of the tree.
+   */
+  std::size_t generation() const;
+
   /**
   * Clears a prototype node. All objects will be deleted. If
   * the recursive flag is set all objects from the children nodea
@@ -518,6 +546,8 @@ private:
   typedef std::unordered_map<std::string, prototype_node*> t_prototype_map;
   // typeid -> [name -> prototype]
   typedef std::unordered_map<std::string, t_prototype_map> t_typeid_prototype_map;
+  // type index -> prototype (unique types only)
+  typedef std::unordered_map<std::type_index, prototype_node*> t_type_index_map;
 
 private:
   /**
@@ -536,6 +566,21 @@ private:
    */
   prototype_node* find_prototype_node(const char *type) const;
 
+  /**
+   * @internal
+   *
+   * Searches a prototype by type info.
+   * The lookup doesn't modify the tree.
+   * Returns a valid prototype node or
+   * nullptr on unknown type
+   * or throws an exception on error
+   *
+   * @param ti Type info of the prototype node to search
+   * @return The requested prototype node or nullptr
+   * @throws oos::object_exception if in error occurrs
+   */
+  prototype_node* find_prototype_node(const std::type_info &ti) const;
+
   /**
    * @internal
    *
@@ -582,6 +627,15 @@ private:
   t_prototype_map prototype_map_;
 
   t_typeid_prototype_map typeid_prototype_map_;
+
+  // filled by insert, read only on lookup
+  t_type_index_map type_index_map_;
+
+  // index of the next inserted node
+  std::size_t next_index_;
+
+  // changes on insert and remove
+  std::size_t generation_;
 };
 
 }
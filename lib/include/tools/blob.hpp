@@ -32,27 +32,52 @@
 #endif
 
 #include <cstring>
+#include <iosfwd>
+#include <type_traits>
 #include <vector>
 
 namespace oos {
 
-/// @cond OOS_DEV
+/**
+ * @class blob
+ * @brief A binary large object.
+ *
+ * A blob holds an arbitrary sequence of bytes
+ * including embedded null characters. It is
+ * stored in a binary column of the database
+ * and is written to and read from the
+ * database in chunks where the backend
+ * supports it.
+ */
 class OOS_API blob
 {
 public:
-  typedef std::size_t size_type;
+  typedef std::size_t size_type; /**< Shortcut for size type */
 
 public:
+  /**
+   * Creates an empty blob.
+   */
   blob();
+
+  /**
+   * Creates a blob holding a copy
+   * of the given data.
+   *
+   * @param data The data to copy.
+   * @param size The size of the data.
+   */
+  blob(const char *data, size_type size);
+
   ~blob();
   
   /**
    * @brief Assign data to blob.
    * 
-   * Assign data to blob. If data is to
-   * big for blob it isn't assigned and
-   * false is returned. Current data is
-   * cleared.
+   * Assign the bytes of the value to blob.
+   * If data is to big for blob it isn't
+   * assigned and false is returned.
+   * Current data is cleared.
    * 
    * @tparam T The type of the data.
    * @param val The value to assign.
@@ -61,15 +86,30 @@ public:
   template < typename T >
   bool assign(const T &val)
   {
-    return false;
+    static_assert(std::is_trivially_copyable<T>::value, "blob data must be trivially copyable");
+    return assign(reinterpret_cast<const char*>(&val), sizeof(T));
   }
 
+  /**
+   * @brief Assign data to blob.
+   *
+   * Assign data to blob. If data is to
+   * big for blob it isn't assigned and
+   * false is returned. Current data is
+   * cleared.
+   *
+   * @param data The data to assign.
+   * @param size The size of the data.
+   * @return True if data could be assigned.
+   */
+  bool assign(const char *data, size_type size);
+
   /**
    * @brief Append data to blob.
    * 
-   * Append data to blob. If data is to
-   * big for blob it isn't appended and
-   * false is returned.
+   * Append the bytes of the value to blob.
+   * If data is to big for blob it isn't
+   * appended and false is returned.
    * 
    * @tparam T The type of the data.
    * @param val The value to append.
@@ -78,19 +118,114 @@ public:
   template < typename T >
   bool append(const T &val)
   {
-    return false;
+    static_assert(std::is_trivially_copyable<T>::value, "blob data must be trivially copyable");
+    return append(reinterpret_cast<const char*>(&val), sizeof(T));
   }
 
+  /**
+   * @brief Append data to blob.
+   *
+   * Append data to blob. If data is to
+   * big for blob it isn't appended and
+   * false is returned.
+   *
+   * @param data The data to append.
+   * @param size The size of the data.
+   * @return True if data could be appended.
+   */
+  bool append(const char *data, size_type size);
+
+  /**
+   * Clears the blob.
+   */
+  void clear();
+
+  /**
+   * Resizes the blob. New bytes
+   * are set to zero. This is used to
+   * read data directly into the blob.
+   *
+   * @param size The new size of the blob.
+   */
+  void resize(size_type size);
+
+  /**
+   * Reserves memory for at least
+   * the given number of bytes.
+   *
+   * @param size The number of bytes to reserve.
+   */
+  void reserve(size_type size);
+
+  /**
+   * Returns the number of bytes.
+   *
+   * @return The number of bytes.
+   */
   size_type size() const;
 
+  /**
+   * Returns the number of bytes the
+   * blob can hold without reallocation.
+   *
+   * @return The capacity of the blob.
+   */
   size_type capacity() const;
 
+  /**
+   * Returns true if the blob is empty.
+   *
+   * @return True if the blob is empty.
+   */
+  bool empty() const;
+
+  /**
+   * Returns the data of the blob. If the
+   * blob is empty nullptr may be returned.
+   *
+   * @return The data of the blob.
+   */
   const char* data() const;
 
+  /**
+   * Returns the data of the blob. If the
+   * blob is empty nullptr may be returned.
+   *
+   * @return The data of the blob.
+   */
+  char* data();
+
+  /**
+   * Returns true if both blobs
+   * contain the same bytes.
+   *
+   * @param x The blob to compare with.
+   * @return True if both blobs are equal.
+   */
+  bool operator==(const blob &x) const;
+
+  /**
+   * Returns true if the blobs differ.
+   *
+   * @param x The blob to compare with.
+   * @return True if both blobs differ.
+   */
+  bool operator!=(const blob &x) const;
+
+  /**
+   * Writes the bytes of the blob as
+   * hexadecimal digits to the stream.
+   *
+   * @param out The stream to write on.
+   * @param x The blob to write.
+   * @return The modified stream.
+   */
+  friend OOS_API std::ostream& operator<<(std::ostream &out, const blob &x);
+
 private:
   std::vector<char> data_;
 };
-/// @endcond
+
 }
 
 #endif /* BLOB_HPP */
@@ -7,4 +7,7 @@ void jd2gc(int jday, int &day, int &month, int &year);
 int time2seconds(unsigned int hour, unsigned int minute, unsigned int second);
 void seconds2time(unsigned int seconds, unsigned int &hour, unsigned int &minute, unsigned int &second);
 
+int days_from_civil(int year, int month, int day);
+void civil_from_days(int days, int &year, int &month, int &day);
+
 #endif /* CALENDAR_H */
@@ -31,6 +31,7 @@
   #define OOS_API
 #endif
 
+#include <atomic>
 #include <memory>
 
 namespace oos {
@@ -119,6 +120,57 @@ public:
 private:
   long number_;
 };
+
+/**
+ * @class atomic_sequencer
+ * @brief Thread safe sequencer without locks
+ *
+ * The next id is taken from an atomic counter.
+ * To avoid contention on the counter each thread
+ * takes a range of ids at once and hands them out
+ * from a thread local cache. Thus ids handed out by
+ * different threads aren't ascending and the current
+ * number is the last id taken into any cache.
+ *
+ * Resetting the sequencer or updating it with an
+ * id not beyond the current number invalidates
+ * all thread local caches.
+ */
+class OOS_API atomic_sequencer : public sequencer_impl
+{
+public:
+  /**
+   * Creates an atomic sequencer taking the
+   * given number of ids into a thread cache.
+   *
+   * @param cache_size The number of ids taken at once.
+   */
+  explicit atomic_sequencer(long cache_size = 64);
+  virtual ~atomic_sequencer();
+
+  virtual long init();
+
+  virtual long reset(long id);
+
+  virtual long next();
+  virtual long current() const;
+
+  virtual long update(long id);
+
+  /**
+   * Returns the number of ids
+   * taken into a thread cache.
+   *
+   * @return The cache size.
+   */
+  long cache_size() const;
+
+private:
+  const unsigned long id_;
+  const long cache_size_;
+  std::atomic<long> number_;
+  std::atomic<unsigned long> generation_;
+};
 /// @endcond
 
 /**
@@ -0,0 +1,136 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHARED_MUTEX_HPP
+#define SHARED_MUTEX_HPP
+
+#ifdef _MSC_VER
+  #ifdef oos_EXPORTS
+    #define OOS_API __declspec(dllexport)
+    #define EXPIMP_TEMPLATE
+  #else
+    #define OOS_API __declspec(dllimport)
+    #define EXPIMP_TEMPLATE extern
+  #endif
+  #pragma warning(disable: 4251)
+#else
+  #define OOS_API
+#endif
+
+#include <mutex>
+#include <condition_variable>
+
+namespace oos {
+
+/**
+ * @class shared_mutex
+ * @brief A mutex with shared and exclusive ownership
+ *
+ * Many threads may hold the mutex shared
+ * (reader) while only one thread may hold it
+ * exclusively (writer). A waiting writer blocks
+ * new readers, so a steady stream of readers
+ * can't starve the writer.
+ *
+ * The exclusive interface fits std::lock_guard
+ * and std::unique_lock, the shared interface
+ * fits oos::shared_lock.
+ */
+class OOS_API shared_mutex
+{
+public:
+  shared_mutex();
+  ~shared_mutex();
+
+  shared_mutex(const shared_mutex&) = delete;
+  shared_mutex& operator=(const shared_mutex&) = delete;
+
+  /**
+   * Locks the mutex exclusively. Blocks
+   * until all readers and the current
+   * writer released the mutex.
+   */
+  void lock();
+
+  /**
+   * Tries to lock the mutex exclusively.
+   *
+   * @return True if the mutex was locked.
+   */
+  bool try_lock();
+
+  /**
+   * Releases the exclusive lock.
+   */
+  void unlock();
+
+  /**
+   * Locks the mutex shared. Blocks
+   * while a writer holds or waits
+   * for the mutex.
+   */
+  void lock_shared();
+
+  /**
+   * Tries to lock the mutex shared.
+   *
+   * @return True if the mutex was locked.
+   */
+  bool try_lock_shared();
+
+  /**
+   * Releases one shared lock.
+   */
+  void unlock_shared();
+
+private:
+  std::mutex mutex_;
+  std::condition_variable readers_;
+  std::condition_variable writers_;
+  unsigned long reader_count_;
+  unsigned long waiting_writers_;
+  bool writer_;
+};
+
+/**
+ * @class shared_lock
+ * @brief Holds a shared_mutex shared for its lifetime
+ */
+class shared_lock
+{
+public:
+  explicit shared_lock(shared_mutex &m)
+    : mutex_(m)
+  {
+    mutex_.lock_shared();
+  }
+
+  ~shared_lock()
+  {
+    mutex_.unlock_shared();
+  }
+
+  shared_lock(const shared_lock&) = delete;
+  shared_lock& operator=(const shared_lock&) = delete;
+
+private:
+  shared_mutex &mutex_;
+};
+
+}
+
+#endif /* SHARED_MUTEX_HPP */
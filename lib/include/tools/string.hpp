@@ -44,11 +44,46 @@ struct date_format
 struct time_format
 {
   static constexpr const char* ISO8601 = "%F %T";
+  static constexpr const char* ISO8601_MILLI = "%F %T.%f";
+  static constexpr const char* ISO8601_MICRO = "%F %T.%6f";
 };
 
 OOS_API std::string to_string(const oos::time &x, const char *format = time_format::ISO8601);
 OOS_API std::string to_string(const oos::date &x, const char *format = date_format::ISO8601);
 
+/**
+ * Formats a time into the given buffer. The
+ * tokens %Y, %m, %d, %H, %M, %S, %F, %T and
+ * %% are formatted without allocating memory.
+ * %f (or %3f) writes the milliseconds and %6f
+ * the microseconds. Other tokens are formatted
+ * by strftime. The string is null terminated.
+ *
+ * @param x The time to format.
+ * @param buffer The buffer to write to.
+ * @param size The size of the buffer.
+ * @param format The format string.
+ * @return The length of the formatted string.
+ * @throws std::logic_error If the buffer is too small.
+ */
+OOS_API std::size_t to_string(const oos::time &x, char *buffer, std::size_t size, const char *format = time_format::ISO8601);
+
+/**
+ * Formats a date into the given buffer. The
+ * tokens %Y, %m, %d, %F and %% are formatted
+ * without allocating memory. Other tokens are
+ * formatted by strftime. The string is null
+ * terminated.
+ *
+ * @param x The date to format.
+ * @param buffer The buffer to write to.
+ * @param size The size of the buffer.
+ * @param format The format string.
+ * @return The length of the formatted string.
+ * @throws std::logic_error If the buffer is too small.
+ */
+OOS_API std::size_t to_string(const oos::date &x, char *buffer, std::size_t size, const char *format = date_format::ISO8601);
+
 }
 
 #endif /* STRING_HPP */
@@ -58,6 +58,7 @@ public:
   static bool is_valid_time(int hour, int min, int sec, long millis);
 
   static time parse(const std::string &tstr, const char *format);
+  static time parse(const char *tstr, const char *format);
 
   void set(int year, int month, int day, int hour, int min, int sec, long millis);
   void set(time_t t, long millis);
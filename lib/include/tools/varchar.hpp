@@ -31,6 +31,7 @@
   #define OOS_API
 #endif
 
+#include <cstring>
 #include <string>
 #include <stdexcept>
 
@@ -69,23 +70,34 @@ public:
 
   void assign(const char *s);
 
+  void append(const char *s, size_t n);
+
+  void clear();
+
   std::string str() const;
 
   const char* c_str() const;
 
+  const char* data() const;
+
   size_type size() const;
 
   size_type capacity() const;
 
+  bool empty() const;
+
   friend OOS_API std::ostream& operator<<(std::ostream &out, const varchar_base &val);
 
 protected:
+  varchar_base(char *buffer, size_type capacity);
+
   void ok(const std::string &x);
-  void trim();
 
-protected:
+private:
   size_type capacity_;
-  std::string data_;
+  size_type size_;
+  char *data_;
+  bool owner_;
 };
 /// @endcond
 
@@ -98,8 +110,11 @@ protected:
  * SQL VARCHAR type in mind. The capacity of
  * the string is given within the template
  * parameter of type unsigned int.
- * The real string is represented internaly
- * by a std::string.
+ * The string is stored inside the varchar
+ * in a character array of the given capacity,
+ * so creating, copying and assigning a varchar
+ * never allocates memory. Strings exceeding
+ * the capacity are truncated.
  */
 template < unsigned int C >
 class varchar : public varchar_base
@@ -110,8 +125,10 @@ public:
    * with the given capacity
    */
   varchar()
-    : varchar_base(C)
-  {}
+    : varchar_base(buffer_, C)
+  {
+    buffer_[0] = '\0';
+  }
 
   /**
    * Copies the string data
@@ -120,9 +137,9 @@ public:
    * @param x The varchar to copy.
    */
   varchar(const varchar &x)
-    : varchar_base(C)
+    : varchar_base(buffer_, C)
   {
-    data_ = x.data_;
+    assign(x.data(), x.size());
   }
 
   /**
@@ -132,9 +149,9 @@ public:
    * @param x The string value to set.
    */
   explicit varchar(const std::string &x)
-    : varchar_base(C)
+    : varchar_base(buffer_, C)
   {
-    data_ = x;
+    assign(x.data(), x.size());
   }
 
   /**
@@ -144,9 +161,9 @@ public:
    * @param x The string value to set.
    */
   explicit varchar(const char *x)
-    : varchar_base(C)
+    : varchar_base(buffer_, C)
   {
-    data_.assign(x);
+    assign(x);
   }
 
   /**
@@ -157,9 +174,7 @@ public:
    */
   varchar& operator=(const varchar &x)
   {
-    
-    capacity_ = C;
-    data_ = x.data_;
+    varchar_base::operator=(x);
     return *this;
   }
 
@@ -171,7 +186,7 @@ public:
    */
   varchar& operator=(const std::string &x)
   {
-    data_ = x;
+    varchar_base::operator=(x);
     return *this;
   }
 
@@ -186,6 +201,9 @@ public:
     varchar_base::operator=(x);
     return *this;
   }
+
+private:
+  char buffer_[C + 1];
 };
 
 /**
@@ -199,7 +217,7 @@ public:
 template < unsigned int C1, unsigned int C2 >
 bool operator==(const varchar<C1> &l, const varchar<C2> &r)
 {
-  return l.str() == r.str();
+  return l.varchar_base::operator==(r);
 }
 
 /**
@@ -212,7 +230,7 @@ bool operator==(const varchar<C1> &l, const varchar<C2> &r)
 template < unsigned int C >
 bool operator==(const varchar<C> &l, const char *r)
 {
-  return l.str() == r;
+  return std::strcmp(l.c_str(), r) == 0;
 }
 
 /**
@@ -226,7 +244,7 @@ bool operator==(const varchar<C> &l, const char *r)
 template < unsigned int C1, unsigned int C2 >
 bool operator!=(const varchar<C1> &l, const varchar<C2> &r)
 {
-  return l.str() != r.str();
+  return l.varchar_base::operator!=(r);
 }
 
 /**
@@ -239,7 +257,7 @@ bool operator!=(const varchar<C1> &l, const varchar<C2> &r)
 template < unsigned int C >
 bool operator!=(const varchar<C> &l, const char *r)
 {
-  return l.str() != r;
+  return std::strcmp(l.c_str(), r) != 0;
 }
 
 }
@@ -258,6 +258,15 @@ public:
    */
   std::string caption() const;
 
+  /**
+   * Returns the name of the executed test
+   * method. It is already set when
+   * initialize() is called.
+   *
+   * @return The name of the executed test.
+   */
+  std::string current_test() const;
+
   /**
    * @brief Executes each test method.
    *
@@ -17,6 +17,7 @@
 
 #include "database/action.hpp"
 #include "object/object.hpp"
+#include "object/prototype_node.hpp"
 
 #include <algorithm>
 
@@ -25,6 +26,14 @@ namespace oos
 
 insert_action::insert_action(const std::string &t)
   : type_(t)
+  , node_(nullptr)
+  , size_(0)
+{}
+
+insert_action::insert_action(prototype_node *node)
+  : type_(node->type)
+  , node_(node)
+  , size_(0)
 {}
 
 insert_action::~insert_action()
@@ -40,29 +49,39 @@ std::string insert_action::type() const
   return type_;
 }
 
+prototype_node* insert_action::node() const
+{
+  return node_;
+}
+
 insert_action::iterator insert_action::begin()
 {
-  return object_proxy_list_.begin();
+  return iterator(proxies_.data(), proxies_.data() + proxies_.size());
 }
 
 insert_action::const_iterator insert_action::begin() const
 {
-  return object_proxy_list_.begin();
+  return const_iterator(proxies_.data(), proxies_.data() + proxies_.size());
 }
 
 insert_action::iterator insert_action::end()
 {
-  return object_proxy_list_.end();
+  return iterator(proxies_.data() + proxies_.size(), proxies_.data() + proxies_.size());
 }
 
 insert_action::const_iterator insert_action::end() const
 {
-  return object_proxy_list_.end();
+  return const_iterator(proxies_.data() + proxies_.size(), proxies_.data() + proxies_.size());
 }
 
 bool insert_action::empty() const
 {
-  return object_proxy_list_.empty();
+  return size_ == 0;
+}
+
+std::size_t insert_action::size() const
+{
+  return size_;
 }
 
 struct object_by_id : public std::unary_function<unsigned long, bool>
@@ -80,22 +99,33 @@ struct object_by_id : public std::unary_function<unsigned long, bool>
 
 insert_action::iterator insert_action::find(unsigned long id)
 {
-  return std::find_if(object_proxy_list_.begin(), object_proxy_list_.end(), object_by_id(id));
+  return std::find_if(begin(), end(), object_by_id(id));
 }
 
 insert_action::const_iterator insert_action::find(unsigned long id) const
 {
-  return std::find_if(object_proxy_list_.begin(), object_proxy_list_.end(), object_by_id(id));
+  return std::find_if(begin(), end(), object_by_id(id));
+}
+
+std::size_t insert_action::push_back(object_proxy *proxy)
+{
+  proxies_.push_back(proxy);
+  ++size_;
+  return proxies_.size() - 1;
 }
 
-void insert_action::push_back(object_proxy *proxy)
+void insert_action::remove(std::size_t slot)
 {
-  object_proxy_list_.push_back(proxy);
+  if (slot < proxies_.size() && proxies_[slot]) {
+    proxies_[slot] = nullptr;
+    --size_;
+  }
 }
 
 insert_action::iterator insert_action::erase(insert_action::iterator i)
 {
-  return object_proxy_list_.erase(i);
+  remove(i.current_ - proxies_.data());
+  return ++i;
 }
 
 object_proxy* update_action::proxy()
@@ -110,6 +140,12 @@ const object_proxy* update_action::proxy() const
 
 delete_action::delete_action(const char *classname, unsigned long id)
   : classname_(classname)
+  , node_(nullptr)
+  , id_(id)
+{}
+
+delete_action::delete_action(prototype_node *node, unsigned long id)
+  : node_(node)
   , id_(id)
 {}
 
@@ -123,7 +159,12 @@ void delete_action::accept(action_visitor *av)
 
 const char* delete_action::classname() const
 {
-  return classname_.c_str();
+  return node_ ? node_->type.c_str() : classname_.c_str();
+}
+
+prototype_node* delete_action::node() const
+{
+  return node_;
 }
 
 unsigned long delete_action::id() const
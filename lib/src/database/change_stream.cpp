@@ -0,0 +1,252 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "database/change_stream.hpp"
+#include "database/transaction.hpp"
+#include "database/action.hpp"
+
+#include "object/object.hpp"
+#include "object/object_proxy.hpp"
+#include "object/object_store.hpp"
+#include "object/object_serializer.hpp"
+#include "object/prototype_node.hpp"
+
+#include "tools/byte_buffer.hpp"
+
+namespace oos {
+
+/*
+ * publishes one change for each object
+ * of the actions of a committed transaction
+ */
+class change_stream::publisher : public action_visitor
+{
+public:
+  publisher(change_stream &stream, object_store &ostore)
+    : stream_(stream)
+    , ostore_(ostore)
+  {}
+  virtual ~publisher() {}
+
+  virtual void visit(create_action *) {}
+  virtual void visit(drop_action *) {}
+
+  virtual void visit(insert_action *a)
+  {
+    for (insert_action::const_iterator i = a->begin(); i != a->end(); ++i) {
+      const object_proxy *proxy = *i;
+      if (proxy->obj && proxy->node) {
+        stream_.publish(op_insert, proxy->node->type, proxy->id(), proxy->obj);
+      }
+    }
+  }
+
+  virtual void visit(update_action *a)
+  {
+    const object_proxy *proxy = a->proxy();
+    if (proxy->obj && proxy->node) {
+      stream_.publish(op_update, proxy->node->type, proxy->id(), proxy->obj);
+    }
+  }
+
+  virtual void visit(delete_action *a)
+  {
+    if (a->node()) {
+      stream_.publish(op_delete, a->node()->type, a->id(), nullptr);
+      return;
+    }
+    prototype_iterator node = ostore_.find_prototype(a->classname());
+    if (node != ostore_.end()) {
+      stream_.publish(op_delete, node->type, a->id(), nullptr);
+    }
+  }
+
+private:
+  change_stream &stream_;
+  object_store &ostore_;
+};
+
+change_stream::cursor::cursor()
+  : stream_(nullptr)
+  , position_(0)
+  , lost_(0)
+{}
+
+change_stream::cursor::cursor(const change_stream *stream, std::uint64_t position)
+  : stream_(stream)
+  , position_(position)
+  , lost_(0)
+{}
+
+bool change_stream::cursor::next(change &c)
+{
+  if (!stream_) {
+    return false;
+  }
+  std::uint64_t head = stream_->head_.load(std::memory_order_acquire);
+  while (position_ < head) {
+    // skip the overwritten changes
+    std::uint64_t oldest = head >= stream_->capacity_ ? head - stream_->capacity_ + 1 : 1;
+    if (position_ + 1 < oldest) {
+      lost_ += oldest - position_ - 1;
+      position_ = oldest - 1;
+    }
+    if (stream_->read(position_ + 1, c)) {
+      ++position_;
+      return true;
+    }
+    // the slot was overwritten while reading
+    head = stream_->head_.load(std::memory_order_acquire);
+  }
+  return false;
+}
+
+std::uint64_t change_stream::cursor::position() const
+{
+  return position_;
+}
+
+std::uint64_t change_stream::cursor::lost() const
+{
+  return lost_;
+}
+
+change_stream::change_stream(std::size_t capacity, std::size_t image_capacity)
+  : capacity_(capacity > 0 ? capacity : 1)
+  , slots_(new slot[capacity_])
+  , head_(0)
+  , image_capacity_(image_capacity)
+  , image_reserved_(0)
+{
+  for (std::size_t i = 0; i < capacity_; ++i) {
+    slots_[i].stamp.store(0, std::memory_order_relaxed);
+  }
+  if (image_capacity_ > 0) {
+    images_.reset(new std::atomic<char>[image_capacity_]);
+  }
+}
+
+change_stream::~change_stream()
+{}
+
+change_stream::cursor change_stream::subscribe() const
+{
+  return cursor(this, head_.load(std::memory_order_acquire));
+}
+
+std::uint64_t change_stream::head() const
+{
+  return head_.load(std::memory_order_acquire);
+}
+
+std::size_t change_stream::capacity() const
+{
+  return capacity_;
+}
+
+void change_stream::publish(const transaction &tr, object_store &ostore)
+{
+  publisher p(*this, ostore);
+  for (transaction::const_iterator i = tr.action_list_.begin(); i != tr.action_list_.end(); ++i) {
+    (*i)->accept(&p);
+  }
+}
+
+void change_stream::publish(t_operation op, const std::string &type, unsigned long id, const object *o)
+{
+  // interned names are never erased, readers
+  // may still hold a pointer to them
+  const std::string *name = &*types_.insert(type).first;
+
+  std::uint64_t begin = 0;
+  std::uint32_t size = (o && images_) ? write_image(o, begin) : 0;
+
+  std::uint64_t n = head_.load(std::memory_order_relaxed) + 1;
+  slot &s = slots_[n % capacity_];
+
+  // an odd stamp marks the slot as being written
+  s.stamp.store((n << 1) | 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  s.operation.store(op, std::memory_order_relaxed);
+  s.type.store(name, std::memory_order_relaxed);
+  s.id.store(id, std::memory_order_relaxed);
+  s.image_begin.store(begin, std::memory_order_relaxed);
+  s.image_size.store(size, std::memory_order_relaxed);
+  s.stamp.store(n << 1, std::memory_order_release);
+
+  head_.store(n, std::memory_order_release);
+}
+
+std::uint32_t change_stream::write_image(const object *o, std::uint64_t &begin)
+{
+  byte_buffer buffer;
+  object_serializer serializer;
+  serializer.serialize(o, &buffer);
+  std::size_t size = buffer.size();
+  if (size == 0 || size > image_capacity_) {
+    return 0;
+  }
+  image_buffer_.resize(size);
+  buffer.release(image_buffer_.data(), size);
+
+  // readers check the reserved bytes
+  // to detect overwritten images
+  begin = image_reserved_.load(std::memory_order_relaxed);
+  image_reserved_.store(begin + size, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (std::size_t i = 0; i < size; ++i) {
+    images_[(begin + i) % image_capacity_].store(image_buffer_[i], std::memory_order_relaxed);
+  }
+  return (std::uint32_t)size;
+}
+
+bool change_stream::read(std::uint64_t sequence, change &c) const
+{
+  const slot &s = slots_[sequence % capacity_];
+  std::uint64_t stamp = s.stamp.load(std::memory_order_acquire);
+  if (stamp != (sequence << 1)) {
+    return false;
+  }
+  int op = s.operation.load(std::memory_order_relaxed);
+  const std::string *type = s.type.load(std::memory_order_relaxed);
+  unsigned long id = s.id.load(std::memory_order_relaxed);
+  std::uint64_t begin = s.image_begin.load(std::memory_order_relaxed);
+  std::uint32_t size = s.image_size.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (s.stamp.load(std::memory_order_relaxed) != stamp) {
+    return false;
+  }
+
+  c.sequence = sequence;
+  c.operation = (t_operation)op;
+  c.type = *type;
+  c.id = id;
+  c.image.resize(size);
+  for (std::uint32_t i = 0; i < size; ++i) {
+    c.image[i] = images_[(begin + i) % image_capacity_].load(std::memory_order_relaxed);
+  }
+  if (size > 0) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (image_reserved_.load(std::memory_order_relaxed) - begin > image_capacity_) {
+      // the image was overwritten
+      c.image.clear();
+    }
+  }
+  return true;
+}
+
+}
@@ -0,0 +1,313 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "database/commit_pipeline.hpp"
+#include "database/session.hpp"
+#include "database/database.hpp"
+#include "database/action.hpp"
+#include "database/change_stream.hpp"
+#include "database/database_exception.hpp"
+
+#include "object/object.hpp"
+#include "object/object_proxy.hpp"
+#include "object/object_producer.hpp"
+#include "object/object_store.hpp"
+#include "object/object_serializer.hpp"
+#include "object/prototype_node.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace oos {
+
+/*
+ * turns the actions of a transaction into
+ * records and serializes the inserted and
+ * updated objects into the batch buffer
+ */
+class commit_pipeline::record_collector : public action_visitor
+{
+public:
+  record_collector(batch &b, object_store &ostore)
+    : batch_(b)
+    , ostore_(ostore)
+  {}
+  virtual ~record_collector() {}
+
+  virtual void visit(create_action *) {}
+  virtual void visit(drop_action *) {}
+
+  virtual void visit(insert_action *a)
+  {
+    for (insert_action::const_iterator i = a->begin(); i != a->end(); ++i) {
+      add(record::INSERT, *i);
+    }
+  }
+
+  virtual void visit(update_action *a)
+  {
+    add(record::UPDATE, a->proxy());
+  }
+
+  virtual void visit(delete_action *a)
+  {
+    prototype_node *node = a->node();
+    if (!node) {
+      // resolve the type here, the store
+      // mustn't be read by the writer thread
+      prototype_iterator i = ostore_.find_prototype(a->classname());
+      if (i != ostore_.end()) {
+        node = i.get();
+      }
+    }
+    record r = { record::REMOVE, node ? node->type : a->classname(), a->id(), node };
+    batch_.records.push_back(r);
+  }
+
+private:
+  void add(record::t_kind kind, const object_proxy *proxy)
+  {
+    if (!proxy->obj || !proxy->node) {
+      return;
+    }
+    record r = { kind, proxy->node->type, proxy->id(), proxy->node };
+    batch_.records.push_back(r);
+    serializer_.serialize(proxy->obj, &batch_.buffer);
+  }
+
+private:
+  batch &batch_;
+  object_store &ostore_;
+  object_serializer serializer_;
+};
+
+commit_pipeline::commit_pipeline(session &db, std::size_t max_queued_bytes)
+  : db_(db)
+  , max_queued_bytes_(max_queued_bytes)
+  , queued_bytes_(0)
+  , writing_(false)
+  , stop_(false)
+{
+  writer_ = std::thread(&commit_pipeline::run, this);
+}
+
+commit_pipeline::~commit_pipeline()
+{
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stop_ = true;
+  }
+  queued_.notify_one();
+  writer_.join();
+}
+
+commit_ticket commit_pipeline::push(const commit_planner::t_action_vector &plan)
+{
+  batch_ptr b(new batch);
+  record_collector collector(*b, db_.ostore());
+  for (commit_planner::t_action_vector::const_iterator i = plan.begin(); i != plan.end(); ++i) {
+    (*i)->accept(&collector);
+  }
+  b->bytes = b->buffer.size() + b->records.size() * sizeof(record);
+  commit_ticket ticket = b->done.get_future().share();
+
+  std::unique_lock<std::mutex> l(mutex_);
+  // an oversized batch is queued once the queue is empty
+  written_.wait(l, [&]() { return error_ || queue_.empty() || queued_bytes_ + b->bytes <= max_queued_bytes_; });
+  if (error_) {
+    // the database lags behind the store
+    // until the error is taken
+    throw database_exception("commit_pipeline", "a queued transaction failed");
+  }
+  queued_bytes_ += b->bytes;
+  queue_.push_back(std::move(b));
+  l.unlock();
+  queued_.notify_one();
+  return ticket;
+}
+
+void commit_pipeline::wait()
+{
+  std::unique_lock<std::mutex> l(mutex_);
+  written_.wait(l, [this]() { return queue_.empty() && !writing_; });
+}
+
+void commit_pipeline::flush()
+{
+  std::unique_lock<std::mutex> l(mutex_);
+  written_.wait(l, [this]() { return queue_.empty() && !writing_; });
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+bool commit_pipeline::failed() const
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  return error_ != nullptr;
+}
+
+std::size_t commit_pipeline::queued_bytes() const
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  return queued_bytes_;
+}
+
+void commit_pipeline::run()
+{
+  std::unique_lock<std::mutex> l(mutex_);
+  while (true) {
+    queued_.wait(l, [this]() { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      // stopped and all batches are written
+      break;
+    }
+    // take all queued batches as one group
+    t_batch_queue group;
+    group.swap(queue_);
+    queued_bytes_ = 0;
+    writing_ = true;
+    l.unlock();
+    written_.notify_all();
+
+    write(group);
+
+    l.lock();
+    writing_ = false;
+    written_.notify_all();
+  }
+}
+
+void commit_pipeline::write(t_batch_queue &group)
+{
+  typedef std::unique_ptr<object_proxy> proxy_ptr;
+
+  database &impl = db_.db();
+  std::vector<proxy_ptr> proxies;
+  std::vector<object_proxy*> restored;
+  try {
+    // restore the serialized objects
+    object_serializer serializer;
+    for (t_batch_queue::iterator i = group.begin(); i != group.end(); ++i) {
+      batch &b = **i;
+      for (std::vector<record>::const_iterator r = b.records.begin(); r != b.records.end(); ++r) {
+        if (r->kind == record::REMOVE) {
+          restored.push_back(nullptr);
+          continue;
+        }
+        proxy_ptr proxy(new object_proxy(r->node->producer->create(), nullptr));
+        serializer.deserialize(proxy->obj, &b.buffer, nullptr);
+        proxy->node = r->node;
+        restored.push_back(proxy.get());
+        proxies.push_back(std::move(proxy));
+      }
+    }
+
+    // an object written more than once is written
+    // with its last state before the next remove
+    // of its id only
+    std::vector<object_proxy*> last(restored.size(), nullptr);
+    std::unordered_map<unsigned long, object_proxy*> latest;
+    std::size_t k = restored.size();
+    for (t_batch_queue::reverse_iterator i = group.rbegin(); i != group.rend(); ++i) {
+      for (std::vector<record>::const_reverse_iterator r = (*i)->records.rbegin(); r != (*i)->records.rend(); ++r) {
+        --k;
+        if (r->kind == record::REMOVE) {
+          latest.erase(r->id);
+        } else {
+          last[k] = latest.insert(std::make_pair(r->id, restored[k])).first->second;
+        }
+      }
+    }
+
+    std::unordered_set<unsigned long> written;
+    impl.begin();
+    for (t_batch_queue::iterator i = group.begin(); i != group.end(); ++i) {
+      for (std::vector<record>::const_iterator r = (*i)->records.begin(); r != (*i)->records.end(); ++r, ++k) {
+        if (r->kind == record::REMOVE) {
+          // a later record of the id
+          // is written again
+          written.erase(r->id);
+          if (r->node) {
+            delete_action a(r->node, r->id);
+            a.accept(&impl);
+          } else {
+            delete_action a(r->type.c_str(), r->id);
+            a.accept(&impl);
+          }
+        } else if (written.insert(r->id).second) {
+          if (r->kind == record::INSERT) {
+            insert_action a(r->node);
+            a.push_back(last[k]);
+            a.accept(&impl);
+          } else {
+            update_action a(last[k]);
+            a.accept(&impl);
+          }
+        }
+      }
+    }
+    impl.commit();
+  } catch (...) {
+    if (impl.commiting_) {
+      impl.on_rollback();
+      impl.commiting_ = false;
+    }
+    std::exception_ptr error = std::current_exception();
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (!error_) {
+        error_ = error;
+      }
+    }
+    for (t_batch_queue::iterator i = group.begin(); i != group.end(); ++i) {
+      (*i)->done.set_exception(error);
+    }
+    return;
+  }
+  publish(group, restored);
+  for (t_batch_queue::iterator i = group.begin(); i != group.end(); ++i) {
+    (*i)->done.set_value();
+  }
+}
+
+void commit_pipeline::publish(const t_batch_queue &group, const std::vector<object_proxy*> &restored)
+{
+  const std::vector<change_stream*> &streams = db_.streams_;
+  if (streams.empty()) {
+    return;
+  }
+  std::vector<object_proxy*>::const_iterator proxy = restored.begin();
+  for (t_batch_queue::const_iterator i = group.begin(); i != group.end(); ++i) {
+    for (std::vector<record>::const_iterator r = (*i)->records.begin(); r != (*i)->records.end(); ++r, ++proxy) {
+      change_stream::t_operation op = change_stream::op_delete;
+      if (r->kind == record::INSERT) {
+        op = change_stream::op_insert;
+      } else if (r->kind == record::UPDATE) {
+        op = change_stream::op_update;
+      }
+      const object *o = *proxy ? (*proxy)->obj : nullptr;
+      for (std::vector<change_stream*>::const_iterator s = streams.begin(); s != streams.end(); ++s) {
+        (*s)->publish(op, r->type, r->id, o);
+      }
+    }
+  }
+}
+
+}
@@ -0,0 +1,299 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "database/commit_planner.hpp"
+#include "database/action.hpp"
+#include "database/transaction.hpp"
+
+#include "object/object.hpp"
+#include "object/object_atomizer.hpp"
+#include "object/object_exception.hpp"
+#include "object/object_ptr.hpp"
+#include "object/object_store.hpp"
+#include "object/primary_key.hpp"
+#include "object/prototype_node.hpp"
+
+#include "tools/blob.hpp"
+#include "tools/varchar.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace oos {
+
+namespace {
+
+/*
+ * collects the types of all
+ * object pointers of an object
+ */
+class reference_collector : public object_writer
+{
+public:
+  reference_collector() {}
+  virtual ~reference_collector() {}
+
+  virtual void write(const char*, char) {}
+  virtual void write(const char*, float) {}
+  virtual void write(const char*, double) {}
+  virtual void write(const char*, short) {}
+  virtual void write(const char*, int) {}
+  virtual void write(const char*, long) {}
+  virtual void write(const char*, unsigned char) {}
+  virtual void write(const char*, unsigned short) {}
+  virtual void write(const char*, unsigned int) {}
+  virtual void write(const char*, unsigned long) {}
+  virtual void write(const char*, bool) {}
+  virtual void write(const char*, const char*, int) {}
+  virtual void write(const char*, const std::string&) {}
+  virtual void write(const char*, const varchar_base&) {}
+  virtual void write(const char*, const date&) {}
+  virtual void write(const char*, const time&) {}
+  virtual void write(const char*, const blob&) {}
+  virtual void write(const char*, const object_base_ptr &x) { types.push_back(x.type()); }
+  virtual void write(const char*, const object_container&) {}
+  virtual void write(const char *id, const primary_key_base &x) { x.serialize(id, *this); }
+
+  std::vector<const char*> types;
+};
+
+/*
+ * finds the prototype node
+ * of the objects of an action
+ */
+class node_resolver : public action_visitor
+{
+public:
+  explicit node_resolver(object_store &ostore)
+    : ostore_(ostore)
+    , node_(nullptr)
+  {}
+  virtual ~node_resolver() {}
+
+  prototype_node* resolve(action *a)
+  {
+    node_ = nullptr;
+    a->accept(this);
+    return node_;
+  }
+
+  virtual void visit(create_action*) {}
+  virtual void visit(insert_action *a)
+  {
+    node_ = a->node() ? a->node() : find(a->type().c_str());
+  }
+  virtual void visit(update_action *a)
+  {
+    node_ = a->proxy()->node;
+  }
+  virtual void visit(delete_action *a)
+  {
+    node_ = a->node() ? a->node() : find(a->classname());
+  }
+  virtual void visit(drop_action*) {}
+
+private:
+  prototype_node* find(const char *type)
+  {
+    prototype_iterator i = ostore_.find_prototype(type);
+    return i == ostore_.end() ? nullptr : i.get();
+  }
+
+private:
+  object_store &ostore_;
+  prototype_node *node_;
+};
+
+/*
+ * sorts an action into
+ * the list of its kind
+ */
+class action_sorter : public action_visitor
+{
+public:
+  action_sorter(commit_planner::t_action_vector &inserts,
+                commit_planner::t_action_vector &updates,
+                commit_planner::t_action_vector &deletes)
+    : inserts_(inserts)
+    , updates_(updates)
+    , deletes_(deletes)
+  {}
+  virtual ~action_sorter() {}
+
+  virtual void visit(create_action*) {}
+  virtual void visit(insert_action *a) { inserts_.push_back(a); }
+  virtual void visit(update_action *a) { updates_.push_back(a); }
+  virtual void visit(delete_action *a) { deletes_.push_back(a); }
+  virtual void visit(drop_action*) {}
+
+private:
+  commit_planner::t_action_vector &inserts_;
+  commit_planner::t_action_vector &updates_;
+  commit_planner::t_action_vector &deletes_;
+};
+
+}
+
+struct commit_planner::group
+{
+  explicit group(prototype_node *n)
+    : node(n)
+    , pending(0)
+    , planned(false)
+  {}
+
+  prototype_node *node;
+  t_action_vector inserts;
+  t_action_vector updates;
+  t_action_vector deletes;
+  // groups depending on this group
+  std::vector<std::size_t> dependents;
+  std::size_t pending;
+  bool planned;
+};
+
+commit_planner::commit_planner(object_store &ostore)
+  : ostore_(ostore)
+  , generation_(ostore.prototypes().generation())
+{}
+
+commit_planner::~commit_planner()
+{}
+
+void commit_planner::plan(const transaction &tr, t_action_vector &plan)
+{
+  plan.clear();
+  plan.reserve(tr.action_list_.size());
+
+  // group the actions by prototype in
+  // the order of their first appearance
+  std::vector<group> groups;
+  std::unordered_map<prototype_node*, std::size_t> index;
+  node_resolver resolver(ostore_);
+  for (transaction::const_iterator i = tr.action_list_.begin(); i != tr.action_list_.end(); ++i) {
+    prototype_node *node = resolver.resolve(*i);
+    std::pair<std::unordered_map<prototype_node*, std::size_t>::iterator, bool> g = index.insert(std::make_pair(node, groups.size()));
+    if (g.second) {
+      groups.push_back(group(node));
+    }
+    group &grp = groups[g.first->second];
+    action_sorter sorter(grp.inserts, grp.updates, grp.deletes);
+    (*i)->accept(&sorter);
+  }
+
+  // link each group to the groups
+  // depending on it
+  for (std::size_t i = 0; i < groups.size(); ++i) {
+    if (!groups[i].node) {
+      continue;
+    }
+    const t_node_vector &deps = dependencies(groups[i].node);
+    for (t_node_vector::const_iterator j = deps.begin(); j != deps.end(); ++j) {
+      std::unordered_map<prototype_node*, std::size_t>::const_iterator k = index.find(*j);
+      if (k != index.end() && k->second != i) {
+        groups[k->second].dependents.push_back(i);
+        ++groups[i].pending;
+      }
+    }
+  }
+
+  // order the groups topologically, among the
+  // ready groups the first appearing comes first
+  std::vector<std::size_t> order;
+  order.reserve(groups.size());
+  while (order.size() < groups.size()) {
+    std::size_t next = groups.size();
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+      if (!groups[i].planned && groups[i].pending == 0) {
+        next = i;
+        break;
+      }
+    }
+    if (next == groups.size()) {
+      // a cycle, take the first unplanned group
+      for (next = 0; groups[next].planned; ++next) {}
+    }
+    groups[next].planned = true;
+    order.push_back(next);
+    for (std::vector<std::size_t>::const_iterator i = groups[next].dependents.begin(); i != groups[next].dependents.end(); ++i) {
+      if (groups[*i].pending > 0) {
+        --groups[*i].pending;
+      }
+    }
+  }
+
+  // inserts and updates referred objects first,
+  // deletes referring objects first
+  for (std::vector<std::size_t>::const_iterator i = order.begin(); i != order.end(); ++i) {
+    plan.insert(plan.end(), groups[*i].inserts.begin(), groups[*i].inserts.end());
+  }
+  for (std::vector<std::size_t>::const_iterator i = order.begin(); i != order.end(); ++i) {
+    plan.insert(plan.end(), groups[*i].updates.begin(), groups[*i].updates.end());
+  }
+  for (std::vector<std::size_t>::const_reverse_iterator i = order.rbegin(); i != order.rend(); ++i) {
+    plan.insert(plan.end(), groups[*i].deletes.begin(), groups[*i].deletes.end());
+  }
+}
+
+const commit_planner::t_node_vector& commit_planner::dependencies(prototype_node *node)
+{
+  // the cached nodes and relations are
+  // stale once the prototypes changed
+  if (generation_ != ostore_.prototypes().generation()) {
+    clear();
+  }
+  std::unordered_map<std::size_t, t_node_vector>::iterator i = dependencies_.find(node->index);
+  if (i != dependencies_.end()) {
+    return i->second;
+  }
+  t_node_vector &deps = dependencies_[node->index];
+
+  // referred prototypes
+  if (node->producer && !node->abstract) {
+    std::unique_ptr<object> o(node->producer->create());
+    reference_collector collector;
+    o->serialize(collector);
+    for (std::vector<const char*>::const_iterator j = collector.types.begin(); j != collector.types.end(); ++j) {
+      prototype_iterator p;
+      try {
+        p = ostore_.find_prototype(*j);
+      } catch (object_exception &) {
+        // the type is ambiguous
+        continue;
+      }
+      if (p != ostore_.end() && p.get() != node && std::find(deps.begin(), deps.end(), p.get()) == deps.end()) {
+        deps.push_back(p.get());
+      }
+    }
+  }
+  // owning containers
+  for (prototype_node::field_prototype_map_t::const_iterator j = node->relations.begin(); j != node->relations.end(); ++j) {
+    prototype_node *owner = j->second.first;
+    if (owner && owner != node && std::find(deps.begin(), deps.end(), owner) == deps.end()) {
+      deps.push_back(owner);
+    }
+  }
+  return deps;
+}
+
+void commit_planner::clear()
+{
+  dependencies_.clear();
+  generation_ = ostore_.prototypes().generation();
+}
+
+}
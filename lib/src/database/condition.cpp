@@ -21,7 +21,14 @@ condition& condition::and_(const condition &cond)
 std::ostream& condition::print(std::ostream &out, bool prepared) const
 {
   out << column_ << op_;
-  if (prepared && !value_.empty()) {
+  if (prepared && !value_.empty() && op_ == " IN ") {
+    // one host value for each value of the list
+    out << "(";
+    for (unsigned long i = 0; i < count_; ++i) {
+      out << (i ? ", ?" : "?");
+    }
+    out << ")";
+  } else if (prepared && !value_.empty()) {
     out << "?";
   } else {
     out << value_;
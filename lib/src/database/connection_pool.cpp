@@ -0,0 +1,215 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "database/connection_pool.hpp"
+#include "database/session.hpp"
+#include "database/database.hpp"
+#include "database/database_factory.hpp"
+#include "database/database_exception.hpp"
+#include "database/statement.hpp"
+#include "database/query.hpp"
+
+namespace oos {
+
+struct connection_pool::entry
+{
+  explicit entry(database *d) : db(d) {}
+
+  database *db;
+
+  typedef std::map<std::string, std::unique_ptr<statement> > t_statement_map;
+  t_statement_map statements;
+};
+
+connection_pool::connection::connection()
+  : pool_(0)
+  , entry_(0)
+{}
+
+connection_pool::connection::connection(connection_pool *pool, entry *e)
+  : pool_(pool)
+  , entry_(e)
+{}
+
+connection_pool::connection::connection(connection &&x)
+  : pool_(x.pool_)
+  , entry_(x.entry_)
+{
+  x.pool_ = 0;
+  x.entry_ = 0;
+}
+
+connection_pool::connection& connection_pool::connection::operator=(connection &&x)
+{
+  if (this != &x) {
+    release();
+    pool_ = x.pool_;
+    entry_ = x.entry_;
+    x.pool_ = 0;
+    x.entry_ = 0;
+  }
+  return *this;
+}
+
+connection_pool::connection::~connection()
+{
+  release();
+}
+
+connection_pool::connection::operator bool() const
+{
+  return entry_ != 0;
+}
+
+void connection_pool::connection::release()
+{
+  if (entry_) {
+    pool_->release(entry_);
+    pool_ = 0;
+    entry_ = 0;
+  }
+}
+
+database& connection_pool::connection::db()
+{
+  if (!entry_) {
+    throw database_exception("connection_pool", "connection isn't acquired");
+  }
+  return *entry_->db;
+}
+
+result* connection_pool::connection::execute(const std::string &sql)
+{
+  return db().execute(sql);
+}
+
+statement* connection_pool::connection::prepare(const std::string &key, const std::function<void(query&)> &build)
+{
+  database &d = db();
+  entry::t_statement_map::iterator i = entry_->statements.find(key);
+  if (i == entry_->statements.end()) {
+    query q(d);
+    build(q);
+    i = entry_->statements.insert(std::make_pair(key, std::unique_ptr<statement>(q.prepare()))).first;
+  } else {
+    i->second->reset();
+  }
+  return i->second.get();
+}
+
+connection_pool::connection_pool(session &owner, std::size_t size)
+  : owner_(owner)
+{
+  if (owner_.type_ == "memory" || owner_.type_ == "journal") {
+    throw database_exception("connection_pool", "memory and journal databases can't be pooled");
+  }
+  try {
+    for (std::size_t i = 0; i < size; ++i) {
+      std::unique_ptr<entry> e(new entry(database_factory::instance().create(owner_.type_, &owner_)));
+      // pooled connections don't take over the sequencer of the store
+      e->db->pooled_ = true;
+      entries_.push_back(std::move(e));
+      entries_.back()->db->open(owner_.connection_);
+      idle_.push_back(entries_.back().get());
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+connection_pool::~connection_pool()
+{
+  clear();
+}
+
+connection_pool::connection connection_pool::acquire()
+{
+  entry *e = 0;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    released_.wait(lock, [this]() { return !idle_.empty(); });
+    // the most recently released connection is reused first
+    e = idle_.back();
+    idle_.pop_back();
+  }
+  return checked(e);
+}
+
+connection_pool::connection connection_pool::acquire(const std::chrono::milliseconds &timeout)
+{
+  entry *e = 0;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!released_.wait_for(lock, timeout, [this]() { return !idle_.empty(); })) {
+      return connection();
+    }
+    e = idle_.back();
+    idle_.pop_back();
+  }
+  return checked(e);
+}
+
+std::size_t connection_pool::size() const
+{
+  return entries_.size();
+}
+
+std::size_t connection_pool::available() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_.size();
+}
+
+connection_pool::connection connection_pool::checked(entry *e)
+{
+  try {
+    if (!e->db->ping()) {
+      // reopen a broken connection, its statements are lost
+      e->statements.clear();
+      e->db->close();
+      e->db->open(owner_.connection_);
+    }
+  } catch (...) {
+    release(e);
+    throw;
+  }
+  return connection(this, e);
+}
+
+void connection_pool::release(entry *e)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_.push_back(e);
+  }
+  released_.notify_one();
+}
+
+void connection_pool::clear()
+{
+  while (!entries_.empty()) {
+    entry *e = entries_.back().get();
+    e->statements.clear();
+    e->db->close();
+    database_factory::instance().destroy(owner_.type_, e->db);
+    entries_.pop_back();
+  }
+  idle_.clear();
+}
+
+}
@@ -21,8 +21,11 @@
 #include "database/database_sequencer.hpp"
 #include "database/transaction.hpp"
 #include "database/statement.hpp"
+#include "database/statement_metrics.hpp"
+#include "database/slow_query_log.hpp"
 #include "database/table.hpp"
 #include "database/action.hpp"
+#include "database/result.hpp"
 
 #include "object/object_store.hpp"
 #include "object/prototype_node.hpp"
@@ -34,6 +37,9 @@ namespace oos {
 database::database(session *db, database_sequencer *seq)
   : db_(db)
   , commiting_(false)
+  , pooled_(false)
+  , delete_table_(nullptr)
+  , update_table_(nullptr)
   , sequencer_(seq)
 {
 }
@@ -54,16 +60,24 @@ void database::open(const std::string &connection)
     prototype_iterator last = db_->ostore().end();
     while (first != last) {
       if (!first->abstract) {
-        table_map_.insert(std::make_pair(first->type, table_ptr(new table(*this, *first))));
+        bind_table(*first, table_ptr(new table(*this, *first)));
       }
       ++first;
     }
 
-    // setup sequencer
-    sequencer_backup_ = db_->ostore().exchange_sequencer(sequencer_);
+    // setup sequencer, a pooled connection
+    // leaves the sequencer to its session
+    if (!pooled_) {
+      sequencer_backup_ = db_->ostore().exchange_sequencer(sequencer_);
+    }
   }
 }
 
+bool database::ping()
+{
+  return is_open();
+}
+
 void database::close()
 {
   if (!is_open()) {
@@ -74,6 +88,7 @@ void database::close()
     }
     sequencer_->destroy();
     
+    table_index_.clear();
     table_map_.clear();
     
     // close database backend
@@ -98,32 +113,28 @@ void database::create(const prototype_node &node)
   table_map_t::iterator i = table_map_.find(node.type);
   if (i == table_map_.end()) {
     // create table
-    table_ptr tbl(new table(*this, node));
-    
-    i = table_map_.insert(std::make_pair(node.type, tbl)).first;
+    i = bind_table(node, table_ptr(new table(*this, node)));
   }
   i->second->create();
 }
 
 object* database::insert(object_proxy *proxy)
 {
-  table_map_t::iterator i = table_map_.find(proxy->node->type);
-  if (i == table_map_.end()) {
+  table *tbl = find_table(proxy->node);
+  if (!tbl) {
     throw database_exception("db::insert", "unknown type");
-  } else {
-    i->second->insert(proxy->obj);
   }
+  tbl->insert(proxy->obj);
   return proxy->obj;
 }
 
 object* database::update(object_proxy *proxy)
 {
-  table_map_t::iterator i = table_map_.find(proxy->node->type);
-  if (i == table_map_.end()) {
+  table *tbl = find_table(proxy->node);
+  if (!tbl) {
     throw database_exception("db::update", "unknown type");
-  } else {
-    i->second->update(proxy->obj);
   }
+  tbl->update(proxy->obj);
   return proxy->obj;
 }
 
@@ -132,9 +143,7 @@ void database::load(const prototype_node &node)
   table_map_t::iterator i = table_map_.find(node.type);
   if (i == table_map_.end()) {
     // create table
-    table_ptr tbl(new table(*this, node));
-    
-    i = table_map_.insert(std::make_pair(node.type, tbl)).first;
+    i = bind_table(node, table_ptr(new table(*this, node)));
   }
   
   i->second->load(db_->ostore());
@@ -156,7 +165,22 @@ bool database::is_loaded(const std::string &name) const
 
 result* database::execute(const std::string &sql)
 {
-  return on_execute(sql);
+  // ad-hoc queries are keyed by their sql
+  statement_metrics::entry *m = metrics_ ? metrics_->acquire(sql, "", "execute") : nullptr;
+  statement_metrics::timer execute_timer(m, statement_metrics::EXECUTE, slow_queries_ != nullptr);
+  result *res = on_execute(sql);
+  unsigned long long duration = execute_timer.stop();
+  // selected rows or changed rows
+  unsigned long rows = 0;
+  if (res) {
+    rows = res->result_rows() > 0 ? res->result_rows() : res->affected_rows();
+  }
+  if (m) {
+    ++m->calls;
+    m->rows += rows;
+  }
+  log_slow_query(sql, "", rows, duration);
+  return res;
 }
 
 void database::drop()
@@ -186,12 +210,19 @@ void database::prepare()
 
 void database::begin()
 {
+  delete_table_ = nullptr;
+  delete_ids_.clear();
+  update_table_ = nullptr;
+  update_objects_.clear();
   on_begin();
   commiting_ = true;
 }
 
 void database::commit()
 {
+  flush_updates();
+  flush_deletes();
+
   // write sequence to db
   sequencer_->commit();
 
@@ -202,6 +233,11 @@ void database::commit()
 
 void database::rollback()
 {
+  delete_table_ = nullptr;
+  delete_ids_.clear();
+  update_table_ = nullptr;
+  update_objects_.clear();
+
   sequencer_->rollback();
 
   if (commiting_) {
@@ -215,10 +251,87 @@ database::database_sequencer_ptr database::seq() const
   return sequencer_;
 }
 
+void database::enable_metrics()
+{
+  if (!metrics_) {
+    metrics_.reset(new statement_metrics);
+  }
+}
+
+void database::disable_metrics()
+{
+  metrics_.reset();
+}
+
+statement_metrics* database::metrics() const
+{
+  return metrics_.get();
+}
+
+void database::enable_slow_query_log(std::chrono::nanoseconds threshold, std::size_t capacity)
+{
+  if (slow_queries_) {
+    slow_queries_->threshold(threshold);
+  } else {
+    slow_queries_.reset(new slow_query_log(threshold, capacity));
+  }
+}
+
+void database::disable_slow_query_log()
+{
+  slow_queries_.reset();
+}
+
+slow_query_log* database::slow_queries() const
+{
+  return slow_queries_.get();
+}
+
+void database::log_slow_query(const std::string &sql, const std::string &parameters, unsigned long rows, unsigned long long duration)
+{
+  if (!slow_queries_ || !slow_queries_->is_slow(duration)) {
+    return;
+  }
+  slow_query query;
+  query.sql = sql;
+  query.parameters = parameters;
+  query.rows = rows;
+  query.duration = duration;
+  if (slow_queries_->explain() && !slow_queries_->find_plan(sql, query.plan)) {
+    // a failing explain mustn't
+    // fail the statement itself
+    try {
+      query.plan = explain(sql);
+    } catch (std::exception &) {
+      query.plan.clear();
+    }
+    slow_queries_->add_plan(sql, query.plan);
+  }
+  slow_queries_->log(query);
+}
+
+std::string database::explain(const std::string &)
+{
+  return "";
+}
+
+statement* database::prepare_update(const prototype_node &, std::size_t)
+{
+  return nullptr;
+}
+
 void database::visit(insert_action *a)
 {
-  table_map_t::iterator i = table_map_.find(a->type());
-  if (i == table_map_.end()) {
+  table *tbl = nullptr;
+  if (a->node()) {
+    tbl = find_table(a->node());
+  } else {
+    table_map_t::iterator i = table_map_.find(a->type());
+    if (i != table_map_.end()) {
+      tbl = i->second.get();
+    }
+  }
+  if (!tbl) {
     /*
      * TODO: add prototype node to insert action
      * to create the table
@@ -229,35 +342,99 @@ void database::visit(insert_action *a)
     throw database_exception("db", "table not found");
   }
   
-  
+  flush_updates();
+  flush_deletes();
+
   insert_action::const_iterator first = a->begin();
   insert_action::const_iterator last = a->end();
   while (first != last) {
     object_proxy *proxy = (*first++);
     
-    i->second->insert(proxy->obj);
+    tbl->insert(proxy->obj);
   }
 }
 
 void database::visit(update_action *a)
 {
-  table_map_t::iterator i = table_map_.find(a->proxy()->node->type);
-  if (i == table_map_.end()) {
+  table *tbl = find_table(a->proxy()->node);
+  if (!tbl) {
     throw database_exception("db", "table not found");
   }
 
-  i->second->update(a->proxy()->obj);
+  flush_deletes();
+
+  // updates are collected until an action of
+  // another kind or table follows
+  if (tbl != update_table_) {
+    flush_updates();
+    update_table_ = tbl;
+  }
+  update_objects_.push_back(a->proxy()->obj);
 }
 
 void database::visit(delete_action *a)
 {
-  table_map_t::iterator i = table_map_.find(a->classname());
-  if (i == table_map_.end()) {
+  table *tbl = nullptr;
+  if (a->node()) {
+    tbl = find_table(a->node());
+  } else {
+    table_map_t::iterator i = table_map_.find(a->classname());
+    if (i != table_map_.end()) {
+      tbl = i->second.get();
+    }
+  }
+  if (!tbl) {
     throw database_exception("db", "table not found");
   }
 
-  i->second->remove(a->id());
+  flush_updates();
+
+  // deletes are collected until an action of
+  // another kind or table follows
+  if (tbl != delete_table_) {
+    flush_deletes();
+    delete_table_ = tbl;
+  }
+  delete_ids_.push_back(a->id());
+}
+
+void database::flush_deletes()
+{
+  if (!delete_table_) {
+    return;
+  }
+  table *tbl = delete_table_;
+  delete_table_ = nullptr;
+  tbl->remove(delete_ids_);
+  delete_ids_.clear();
+}
+
+void database::flush_updates()
+{
+  if (!update_table_) {
+    return;
+  }
+  table *tbl = update_table_;
+  update_table_ = nullptr;
+  tbl->update(update_objects_);
+  update_objects_.clear();
+}
+
+table* database::find_table(const prototype_node *node) const
+{
+  if (!node || node->index >= table_index_.size()) {
+    return nullptr;
+  }
+  return table_index_[node->index];
+}
 
+database::table_map_t::iterator database::bind_table(const prototype_node &node, const table_ptr &tbl)
+{
+  if (node.index >= table_index_.size()) {
+    table_index_.resize(node.index + 1, nullptr);
+  }
+  table_index_[node.index] = tbl.get();
+  return table_map_.insert(std::make_pair(node.type, tbl)).first;
 }
 
 const session* database::db() const
@@ -20,15 +20,22 @@
 #include "database/query.hpp"
 #include "database/statement.hpp"
 #include "database/result.hpp"
+#include "database/database.hpp"
+#include "database/session.hpp"
+
+#include <sstream>
 
 namespace oos {
 
-database_sequencer::database_sequencer(database &db)
+database_sequencer::database_sequencer(database &db, long block_size)
   : db_(db)
   , backup_(0)
   , sequence_(0)
+  , limit_(0)
+  , first_(0)
+  , block_size_(block_size)
+  , number_(0)
   , name_("object")
-  , update_(0)
 {
 }
 
@@ -40,13 +47,13 @@ database_sequencer::~database_sequencer()
 void database_sequencer::deserialize(object_reader &r)
 {
   r.read("name", name_);
-  r.read("number", sequence_);
+  r.read("number", number_);
 }
 
 void database_sequencer::serialize(object_writer &w) const
 {
   w.write("name", name_);
-  w.write("number", sequence_);
+  w.write("number", number_);
 }
 
 long database_sequencer::init()
@@ -56,13 +63,22 @@ long database_sequencer::init()
 
 long database_sequencer::reset(long id)
 {
-  sequence_ = id;
+  std::lock_guard<std::mutex> l(mutex_);
+  // ids of former blocks may belong to
+  // another process by now
+  sequence_ = (id < first_ ? first_ : id);
   return sequence_;
 }
 
 long database_sequencer::next()
 {
-  return ++sequence_;
+  long id = sequence_.load(std::memory_order_relaxed);
+  while (id < limit_.load(std::memory_order_acquire)) {
+    if (sequence_.compare_exchange_weak(id, id + 1)) {
+      return id + 1;
+    }
+  }
+  return acquire();
 }
 
 long database_sequencer::current() const
@@ -72,10 +88,13 @@ long database_sequencer::current() const
 
 long database_sequencer::update(long id)
 {
-  if (id > sequence_) {
-    sequence_ = id;
+  long current = sequence_.load(std::memory_order_relaxed);
+  while (id > current) {
+    if (sequence_.compare_exchange_weak(current, id)) {
+      return id;
+    }
   }
-  return sequence_;
+  return current;
 }
 
 void database_sequencer::create()
@@ -89,15 +108,16 @@ void database_sequencer::create()
 
   if (res->fetch()) {
     // get sequence number
-    res->get(1, sequence_);
+    res->get(1, number_);
   } else {
     // TODO: check result
+    number_ = 0;
     result *res2 = q.reset().insert(this, "oos_sequence").execute();
     delete res2;
   }
   delete res;
 
-  update_ = q.reset().update("oos_sequence", this).where("name='object'").prepare();
+  assign(number_);
 }
 
 void database_sequencer::load()
@@ -107,16 +127,14 @@ void database_sequencer::load()
 
   if (res->fetch()) {
     // get sequence number
-    res->get(1, sequence_);
+    res->get(1, number_);
   } else {
     delete res;
     throw database_exception("database::sequencer", "couldn't fetch sequence");
   }
   delete res;
 
-  if (!update_) {
-    update_ = q.reset().update("oos_sequence", this).where("name='object'").prepare();
-  }
+  assign(number_);
 }
 
 void database_sequencer::begin()
@@ -127,11 +145,8 @@ void database_sequencer::begin()
 
 void database_sequencer::commit()
 {
-  update_->bind(this);
-  // TODO: check result
-  result *res = update_->execute();
-  delete res;
-  update_->reset();
+  // the handed out ids were reserved
+  // when their block was reserved
 }
 
 void database_sequencer::rollback()
@@ -149,11 +164,106 @@ void database_sequencer::drop()
 
 void database_sequencer::destroy()
 {
-  if (update_) {
-    delete update_;
-    update_ = 0;
+}
+
+long database_sequencer::block_size() const
+{
+  return block_size_;
+}
+
+void database_sequencer::block_size(long size)
+{
+  if (size < 1) {
+    throw database_exception("database::sequencer", "invalid block size");
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  block_size_ = size;
+}
+
+long database_sequencer::limit() const
+{
+  return limit_;
+}
+
+long database_sequencer::reserve(long count)
+{
+  // a queued asynchronous commit
+  // uses the same connection
+  if (db_.db()) {
+    db_.db()->flush();
+  }
+
+  std::stringstream sql;
+  sql << "UPDATE oos_sequence SET number=number+" << count << " WHERE name='object'";
+
+  // the row stays locked until the reserved
+  // number is read back
+  bool own = !db_.commiting_;
+  if (own) {
+    db_.on_begin();
+  }
+  try {
+    result *res = db_.execute(sql.str());
+    delete res;
+
+    query q(db_);
+    res = q.select(this).from("oos_sequence").where("name='object'").execute();
+    bool found = res->fetch();
+    if (found) {
+      res->get(1, number_);
+    }
+    delete res;
+    if (!found) {
+      throw database_exception("database::sequencer", "couldn't fetch sequence");
+    }
+    if (own) {
+      db_.on_commit();
+    }
+  } catch (...) {
+    if (own) {
+      db_.on_rollback();
+    }
+    throw;
+  }
+  return number_;
+}
+
+long database_sequencer::acquire()
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  while (true) {
+    long id = sequence_.load(std::memory_order_relaxed);
+    if (id < limit_.load(std::memory_order_acquire)) {
+      // another thread reserved a block meanwhile
+      if (sequence_.compare_exchange_weak(id, id + 1)) {
+        return id + 1;
+      }
+      continue;
+    }
+    long count = block_size_;
+    long last = reserve(count);
+    if (last <= id) {
+      // ids were updated beyond the reserved
+      // numbers, move the sequence row past them
+      count = id - last + block_size_;
+      last = reserve(count);
+    }
+    // close the current block before
+    // the new block is opened
+    first_ = (last - count < id ? id : last - count);
+    limit_.store(first_, std::memory_order_release);
+    update(first_);
+    limit_.store(last, std::memory_order_release);
   }
 }
 
+void database_sequencer::assign(long number)
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  // all ids up to the number are reserved
+  first_ = number;
+  sequence_ = number;
+  limit_ = number;
+}
 
 }
@@ -0,0 +1,436 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "database/journal_database.hpp"
+#include "database/database_sequencer.hpp"
+#include "database/database_exception.hpp"
+#include "database/session.hpp"
+#include "database/action.hpp"
+
+#include "object/object.hpp"
+#include "object/object_store.hpp"
+#include "object/object_serializer.hpp"
+#include "object/prototype_node.hpp"
+
+#include "tools/byte_buffer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace oos {
+
+namespace {
+
+/*
+ * a frame is the size and the checksum of its
+ * payload followed by the payload: the sequence
+ * number and the records of one commit
+ */
+const std::size_t FRAME_HEADER_SIZE = 2 * sizeof(std::uint32_t);
+
+enum { OP_INSERT = 1, OP_UPDATE = 2, OP_DELETE = 3 };
+
+std::uint32_t checksum(const char *data, std::size_t size)
+{
+  // FNV-1a
+  std::uint32_t hash = 2166136261u;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+template < class T >
+void put(std::vector<char> &frame, T value)
+{
+  const char *bytes = reinterpret_cast<const char*>(&value);
+  frame.insert(frame.end(), bytes, bytes + sizeof(T));
+}
+
+template < class T >
+bool get(const char *&first, const char *last, T &value)
+{
+  if (last - first < (std::ptrdiff_t)sizeof(T)) {
+    return false;
+  }
+  std::memcpy(&value, first, sizeof(T));
+  first += sizeof(T);
+  return true;
+}
+
+void sync_file(std::FILE *file)
+{
+  std::fflush(file);
+#ifdef _MSC_VER
+  _commit(_fileno(file));
+#else
+  fsync(fileno(file));
+#endif
+}
+
+void truncate_file(std::FILE *file, long size)
+{
+  std::fflush(file);
+#ifdef _MSC_VER
+  _chsize(_fileno(file), size);
+#else
+  if (ftruncate(fileno(file), size) != 0) {
+    throw database_exception("journal", "couldn't truncate journal");
+  }
+#endif
+}
+
+bool read_file(const std::string &path, std::vector<char> &data)
+{
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+  std::fseek(file, 0, SEEK_END);
+  long size = std::ftell(file);
+  std::fseek(file, 0, SEEK_SET);
+  data.resize(size > 0 ? size : 0);
+  std::size_t n = data.empty() ? 0 : std::fread(&data[0], 1, data.size(), file);
+  std::fclose(file);
+  data.resize(n);
+  return true;
+}
+
+}
+
+journal_database::journal_database(session *db)
+  : database(db, new dummy_database_sequencer(*this))
+  , journal_(nullptr)
+  , journal_size_(0)
+  , compact_size_(0)
+  , open_(false)
+  , loaded_(false)
+{}
+
+journal_database::~journal_database()
+{
+  close();
+}
+
+bool journal_database::is_open() const
+{
+  return open_;
+}
+
+void journal_database::on_open(const std::string &connection)
+{
+  // parse file[?option=value[&option=value]]
+  std::string::size_type pos = connection.find('?');
+  path_ = connection.substr(0, pos);
+
+  compact_size_ = 0;
+  while (pos != std::string::npos) {
+    std::string::size_type next = connection.find('&', pos + 1);
+    std::string option = connection.substr(pos + 1, next == std::string::npos ? next : next - pos - 1);
+    if (option.compare(0, 8, "compact=") == 0) {
+      compact_size_ = std::strtol(option.c_str() + 8, nullptr, 10);
+    } else {
+      throw database_exception("journal", ("unknown option: " + option).c_str());
+    }
+    pos = next;
+  }
+
+  open_journal();
+
+  // drop a torn frame at the end
+  long sequence = 0;
+  long valid = read(path_, nullptr, sequence);
+  if (valid < journal_size_) {
+    truncate_file(journal_, valid);
+    journal_size_ = valid;
+  }
+
+  open_ = true;
+  loaded_ = false;
+}
+
+void journal_database::on_close()
+{
+  if (journal_) {
+    std::fclose(journal_);
+    journal_ = nullptr;
+  }
+  open_ = false;
+}
+
+void journal_database::open_journal()
+{
+  journal_ = std::fopen(path_.c_str(), "ab");
+  if (!journal_) {
+    throw database_exception("journal", ("couldn't open journal: " + path_).c_str());
+  }
+  std::fseek(journal_, 0, SEEK_END);
+  journal_size_ = std::ftell(journal_);
+}
+
+void journal_database::create()
+{
+  drop();
+  open_journal();
+}
+
+void journal_database::drop()
+{
+  if (journal_) {
+    std::fclose(journal_);
+    journal_ = nullptr;
+  }
+  std::remove(path_.c_str());
+  std::remove((path_ + ".snapshot").c_str());
+  journal_size_ = 0;
+}
+
+void journal_database::load(const prototype_node &)
+{
+  if (loaded_) {
+    return;
+  }
+  loaded_ = true;
+
+  long sequence = 0;
+  t_entry_map entries;
+  read(path_ + ".snapshot", &entries, sequence);
+  read(path_, &entries, sequence);
+
+  object_store &ostore = db()->ostore();
+
+  // insert all objects first, so
+  // that the object pointers and
+  // containers can be resolved
+  std::vector<object_proxy*> proxies;
+  proxies.reserve(entries.size());
+  for (t_entry_map::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+    object *o = ostore.create(i->second.type.c_str());
+    if (!o) {
+      throw database_exception("journal", ("unknown type: " + i->second.type).c_str());
+    }
+    o->id(i->first);
+    object_proxy *proxy = new object_proxy(o, nullptr);
+    ostore.insert_proxy(proxy);
+    proxies.push_back(proxy);
+  }
+
+  object_serializer serializer;
+  byte_buffer buffer;
+  std::vector<object_proxy*>::const_iterator proxy = proxies.begin();
+  for (t_entry_map::const_iterator i = entries.begin(); i != entries.end(); ++i, ++proxy) {
+    const std::vector<char> &data = i->second.data;
+    buffer.append(data.data(), data.size());
+    serializer.deserialize((*proxy)->obj, &buffer, &ostore);
+    buffer.clear();
+  }
+
+  seq()->update(sequence);
+
+  if (compact_size_ > 0 && journal_size_ > compact_size_) {
+    compact();
+  }
+}
+
+void journal_database::visit(insert_action *a)
+{
+  for (insert_action::const_iterator i = a->begin(); i != a->end(); ++i) {
+    append(OP_INSERT, a->type(), (*i)->id(), (*i)->obj);
+  }
+}
+
+void journal_database::visit(update_action *a)
+{
+  append(OP_UPDATE, a->proxy()->node->type, a->proxy()->id(), a->proxy()->obj);
+}
+
+void journal_database::visit(delete_action *a)
+{
+  append(OP_DELETE, a->classname(), a->id(), nullptr);
+}
+
+void journal_database::compact()
+{
+  db()->flush();
+
+  const std::string snapshot = path_ + ".snapshot";
+  const std::string tmp = snapshot + ".tmp";
+
+  // all objects as one frame of inserts
+  frame_.assign(FRAME_HEADER_SIZE, 0);
+  put<std::int64_t>(frame_, seq()->current());
+  prototype_iterator root = db()->ostore().begin();
+  for (const object_proxy *proxy = root->op_first; proxy; proxy = proxy->next) {
+    if (proxy->obj && proxy->node) {
+      append(OP_INSERT, proxy->node->type, proxy->id(), proxy->obj);
+    }
+  }
+
+  std::FILE *file = std::fopen(tmp.c_str(), "wb");
+  if (!file) {
+    throw database_exception("journal", ("couldn't create snapshot: " + tmp).c_str());
+  }
+  write(file, frame_);
+  std::fclose(file);
+  frame_.clear();
+
+#ifdef _MSC_VER
+  std::remove(snapshot.c_str());
+#endif
+  if (std::rename(tmp.c_str(), snapshot.c_str()) != 0) {
+    throw database_exception("journal", ("couldn't replace snapshot: " + snapshot).c_str());
+  }
+
+  // the snapshot holds everything now
+  if (journal_) {
+    truncate_file(journal_, 0);
+    sync_file(journal_);
+  }
+  journal_size_ = 0;
+}
+
+long journal_database::journal_size() const
+{
+  return journal_size_;
+}
+
+void journal_database::on_begin()
+{
+  frame_.assign(FRAME_HEADER_SIZE, 0);
+}
+
+void journal_database::on_commit()
+{
+  if (frame_.size() == FRAME_HEADER_SIZE) {
+    // nothing to write
+    frame_.clear();
+    return;
+  }
+  // the sequence goes in front of the records
+  std::vector<char> sequence;
+  put<std::int64_t>(sequence, seq()->current());
+  frame_.insert(frame_.begin() + FRAME_HEADER_SIZE, sequence.begin(), sequence.end());
+
+  if (!journal_) {
+    open_journal();
+  }
+  journal_size_ += write(journal_, frame_);
+  frame_.clear();
+
+  if (compact_size_ > 0 && journal_size_ > compact_size_ && !db()->async_commit_enabled()) {
+    compact();
+  }
+}
+
+void journal_database::on_rollback()
+{
+  frame_.clear();
+}
+
+void journal_database::append(unsigned char op, const std::string &type, unsigned long id, const object *o)
+{
+  put<unsigned char>(frame_, op);
+  put<std::uint32_t>(frame_, (std::uint32_t)type.size());
+  frame_.insert(frame_.end(), type.begin(), type.end());
+  put<std::uint64_t>(frame_, id);
+  if (!o) {
+    put<std::uint32_t>(frame_, 0);
+    return;
+  }
+  byte_buffer buffer;
+  object_serializer serializer;
+  serializer.serialize(o, &buffer);
+  std::size_t size = buffer.size();
+  put<std::uint32_t>(frame_, (std::uint32_t)size);
+  std::size_t offset = frame_.size();
+  frame_.resize(offset + size);
+  buffer.release(&frame_[offset], size);
+}
+
+long journal_database::write(std::FILE *file, t_frame &frame)
+{
+  std::uint32_t size = (std::uint32_t)(frame.size() - FRAME_HEADER_SIZE);
+  std::uint32_t sum = checksum(frame.data() + FRAME_HEADER_SIZE, size);
+  std::memcpy(&frame[0], &size, sizeof(size));
+  std::memcpy(&frame[sizeof(size)], &sum, sizeof(sum));
+  if (std::fwrite(frame.data(), 1, frame.size(), file) != frame.size()) {
+    throw database_exception("journal", "couldn't write frame");
+  }
+  sync_file(file);
+  return (long)frame.size();
+}
+
+long journal_database::read(const std::string &path, t_entry_map *entries, long &sequence) const
+{
+  std::vector<char> data;
+  if (!read_file(path, data) || data.empty()) {
+    return 0;
+  }
+  const char *begin = data.data();
+  const char *first = begin;
+  const char *last = begin + data.size();
+  while (first != last) {
+    const char *frame = first;
+    std::uint32_t size = 0, sum = 0;
+    if (!get(first, last, size) || !get(first, last, sum) ||
+        last - first < (std::ptrdiff_t)size ||
+        checksum(first, size) != sum) {
+      // torn or broken frame
+      return (long)(frame - begin);
+    }
+    const char *end = first + size;
+    std::int64_t seq = 0;
+    get(first, end, seq);
+    if (seq > sequence) {
+      sequence = (long)seq;
+    }
+    while (first < end) {
+      unsigned char op = 0;
+      std::uint32_t len = 0;
+      std::uint64_t id = 0;
+      get(first, end, op);
+      get(first, end, len);
+      std::string type(first, len);
+      first += len;
+      get(first, end, id);
+      get(first, end, len);
+      if (entries) {
+        if (op == OP_DELETE) {
+          entries->erase((unsigned long)id);
+        } else {
+          entry &e = (*entries)[(unsigned long)id];
+          e.type = type;
+          e.data.assign(first, first + len);
+        }
+      }
+      first += len;
+    }
+    first = end;
+  }
+  return (long)data.size();
+}
+
+}
@@ -8,6 +8,7 @@
 #include <object/primary_key.hpp>
 #include <tools/date.hpp>
 #include <tools/time.hpp>
+#include <tools/blob.hpp>
 
 namespace oos {
 
@@ -98,6 +99,11 @@ void query_insert::write(const char *id, const time &x)
   write_field(id, type_time, x);
 }
 
+void query_insert::write(const char *id, const blob &x)
+{
+  write_field(id, type_blob, x);
+}
+
 void query_insert::write(const char *id, const object_base_ptr &x)
 {
   write_field(id, type_long, x.id());
@@ -145,6 +151,22 @@ void query_insert::write_field(const char *id, data_type_t type, const oos::time
   }
 }
 
+void query_insert::write_field(const char *id, data_type_t type, const blob &x)
+{
+  if (first) {
+    first = false;
+  } else {
+    dialect.append(", ");
+  }
+  if (fields_) {
+    dialect.append(id);
+  } else {
+    std::stringstream valstr;
+    valstr << "X'" << x << "'";
+    dialect.append(id, type, valstr.str());
+  }
+}
+
 void query_insert::write_field(const char *id, data_type_t type, const std::string &x)
 {
   if (first) {
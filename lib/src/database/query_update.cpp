@@ -1,6 +1,7 @@
 #include <object/primary_key.hpp>
 #include <tools/date.hpp>
 #include <tools/time.hpp>
+#include <tools/blob.hpp>
 #include "database/query_update.hpp"
 
 #include "object/object_ptr.hpp"
@@ -96,6 +97,11 @@ void query_update::write(const char *id, const time &x)
   write_pair(id, type_time, x);
 }
 
+void query_update::write(const char *id, const blob &x)
+{
+  write_pair(id, type_blob, x);
+}
+
 void query_update::write(const char *id, const object_base_ptr &x)
 {
   write_pair(id, type_long, x.id());
@@ -137,6 +143,19 @@ void query_update::write_pair(const char *id, data_type_t type, const oos::time
   dialect.append(id, type, valstr.str());
 }
 
+void query_update::write_pair(const char *id, data_type_t type, const blob &x)
+{
+  if (first) {
+    first = false;
+  } else {
+    dialect.append(", ");
+  }
+  dialect.append(std::string(id) + "=");
+  std::stringstream valstr;
+  valstr << "X'" << x << "'";
+  dialect.append(id, type, valstr.str());
+}
+
 void query_update::write_pair(const char *id, data_type_t type, const std::string &x)
 {
     if (first) {
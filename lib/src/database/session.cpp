@@ -22,11 +22,15 @@
 #include "database/action.hpp"
 #include "database/transaction.hpp"
 #include "database/memory_database.hpp"
+#include "database/journal_database.hpp"
+#include "database/change_stream.hpp"
+#include "database/commit_pipeline.hpp"
 
 #include "object/object.hpp"
 #include "object/object_store.hpp"
 #include "object/prototype_node.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 using namespace std;
@@ -35,12 +39,16 @@ namespace oos {
 
 session::session(object_store &ostore, const std::string &dbstring)
   : ostore_(ostore)
+  , planner_(ostore)
 {
   // parse dbstring
   std::string::size_type pos = dbstring.find(':');
   type_ = dbstring.substr(0, pos);
   if (type_ == "memory") {
     impl_ = new memory_database(this);
+  } else if (type_ == "journal") {
+    connection_ = dbstring.substr(pos + 3);
+    impl_ = new journal_database(this);
   } else {
     connection_ = dbstring.substr(pos + 3);
 
@@ -57,8 +65,9 @@ session::session(object_store &ostore, const std::string &dbstring)
 
 session::~session()
 {
+  pipeline_.reset();
   if (impl_) {
-    if (type_ == "memory") {
+    if (type_ == "memory" || type_ == "journal") {
       delete impl_;
     } else {
       database_factory::instance().destroy(type_, impl_);
@@ -78,21 +87,25 @@ bool session::is_open() const
 
 void session::create()
 {
+  flush();
   impl_->create();
 }
 
 void session::drop()
 {
+  flush();
   impl_->drop();
 }
 
 void session::close()
 {
+  disable_async_commit();
   impl_->close();
 }
 
 bool session::load()
 {
+  flush();
   // load sequencer
   impl_->seq()->load();
 
@@ -110,11 +123,13 @@ bool session::load()
 
 result* session::execute(const std::string &sql)
 {
+  flush();
   return impl_->execute(sql);
 }
 
 void session::update(const object_base_ptr &optr)
 {
+  flush();
   impl_->update(optr.proxy_);
 }
 
@@ -173,17 +188,42 @@ void session::commit(transaction &tr)
 {
   impl_->begin();
 
-  transaction::const_iterator first = tr.action_list_.begin();
-  transaction::const_iterator last = tr.action_list_.end();
-  while (first != last) {
-    (*first++)->accept(impl_);
+  planner_.plan(tr, plan_);
+  for (commit_planner::t_action_vector::const_iterator i = plan_.begin(); i != plan_.end(); ++i) {
+    (*i)->accept(impl_);
   }
 
   impl_->commit();
+
+  publish(tr);
+}
+
+void session::publish(const transaction &tr)
+{
+  for (std::vector<change_stream*>::const_iterator i = streams_.begin(); i != streams_.end(); ++i) {
+    (*i)->publish(tr, ostore_);
+  }
+}
+
+commit_ticket session::commit_async(transaction &tr)
+{
+  if (pipeline_) {
+    // the writer publishes the changes
+    // once the group is committed
+    planner_.plan(tr, plan_);
+    return pipeline_->push(plan_);
+  }
+  commit(tr);
+  std::promise<void> done;
+  done.set_value();
+  return done.get_future().share();
 }
 
 void session::rollback()
 {
+  if (pipeline_) {
+    pipeline_->wait();
+  }
   impl_->rollback();
 }
 
@@ -197,6 +237,91 @@ transaction* session::current_transaction() const
   return (transaction_stack_.empty() ? 0 : transaction_stack_.top());
 }
 
+void session::enable_async_commit(std::size_t max_queued_bytes)
+{
+  if (!pipeline_) {
+    pipeline_.reset(new commit_pipeline(*this, max_queued_bytes));
+  }
+}
+
+void session::disable_async_commit()
+{
+  if (pipeline_) {
+    std::unique_ptr<commit_pipeline> pipeline(std::move(pipeline_));
+    pipeline->flush();
+  }
+}
+
+bool session::async_commit_enabled() const
+{
+  return pipeline_ != nullptr;
+}
+
+bool session::async_commit_failed() const
+{
+  return pipeline_ && pipeline_->failed();
+}
+
+void session::flush()
+{
+  if (pipeline_) {
+    pipeline_->flush();
+  }
+}
+
+void session::attach(change_stream &stream)
+{
+  // the writer thread reads the streams
+  if (pipeline_) {
+    pipeline_->wait();
+  }
+  if (std::find(streams_.begin(), streams_.end(), &stream) == streams_.end()) {
+    streams_.push_back(&stream);
+  }
+}
+
+void session::detach(change_stream &stream)
+{
+  if (pipeline_) {
+    pipeline_->wait();
+  }
+  streams_.erase(std::remove(streams_.begin(), streams_.end(), &stream), streams_.end());
+}
+
+void session::enable_metrics()
+{
+  flush();
+  impl_->enable_metrics();
+}
+
+void session::disable_metrics()
+{
+  flush();
+  impl_->disable_metrics();
+}
+
+const statement_metrics* session::metrics() const
+{
+  return impl_->metrics();
+}
+
+void session::enable_slow_query_log(std::chrono::nanoseconds threshold, std::size_t capacity)
+{
+  flush();
+  impl_->enable_slow_query_log(threshold, capacity);
+}
+
+void session::disable_slow_query_log()
+{
+  flush();
+  impl_->disable_slow_query_log();
+}
+
+slow_query_log* session::slow_queries() const
+{
+  return impl_->slow_queries();
+}
+
 const database& session::db() const
 {
   return *impl_;
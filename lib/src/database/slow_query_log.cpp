@@ -0,0 +1,210 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "database/slow_query_log.hpp"
+
+#include "object/object_atomizable.hpp"
+#include "object/object_atomizer.hpp"
+#include "object/object_ptr.hpp"
+#include "object/primary_key.hpp"
+
+#include "tools/blob.hpp"
+#include "tools/string.hpp"
+#include "tools/varchar.hpp"
+
+#include <cstring>
+#include <sstream>
+
+namespace oos {
+
+namespace {
+
+/*
+ * prints the attributes of an object
+ * as they are bound to a statement
+ */
+class parameter_printer : public object_writer
+{
+public:
+  static const std::size_t max_text = 32;
+
+  virtual ~parameter_printer() {}
+
+  virtual void write(const char *id, char x) { add(id) << x; }
+  virtual void write(const char *id, float x) { add(id) << x; }
+  virtual void write(const char *id, double x) { add(id) << x; }
+  virtual void write(const char *id, short x) { add(id) << x; }
+  virtual void write(const char *id, int x) { add(id) << x; }
+  virtual void write(const char *id, long x) { add(id) << x; }
+  virtual void write(const char *id, unsigned char x) { add(id) << (unsigned int)x; }
+  virtual void write(const char *id, unsigned short x) { add(id) << x; }
+  virtual void write(const char *id, unsigned int x) { add(id) << x; }
+  virtual void write(const char *id, unsigned long x) { add(id) << x; }
+  virtual void write(const char *id, bool x) { add(id) << (x ? "true" : "false"); }
+  virtual void write(const char *id, const char *x, int s) { text(id, x, strnlen(x, s)); }
+  virtual void write(const char *id, const std::string &x) { text(id, x.data(), x.size()); }
+  virtual void write(const char *id, const varchar_base &x) { text(id, x.data(), x.size()); }
+  virtual void write(const char *id, const date &x) { add(id) << to_string(x); }
+  virtual void write(const char *id, const time &x) { add(id) << to_string(x); }
+  virtual void write(const char *id, const blob &x) { add(id) << "<" << x.size() << " bytes>"; }
+  virtual void write(const char *id, const object_base_ptr &x) { add(id) << x.id(); }
+  virtual void write(const char*, const object_container&) {}
+  virtual void write(const char *id, const primary_key_base &x) { x.serialize(id, *this); }
+
+  std::string str() const { return out_.str(); }
+
+private:
+  std::ostream& add(const char *id)
+  {
+    if (out_.tellp() > 0) {
+      out_ << ", ";
+    }
+    return out_ << id << "=";
+  }
+
+  void text(const char *id, const char *x, std::size_t size)
+  {
+    add(id) << "'";
+    if (size > max_text) {
+      out_.write(x, max_text) << "...'";
+    } else {
+      out_.write(x, size) << "'";
+    }
+  }
+
+private:
+  std::ostringstream out_;
+};
+
+}
+
+slow_query_log::slow_query_log(std::chrono::nanoseconds threshold, std::size_t capacity)
+  : threshold_((unsigned long long)threshold.count())
+  , explain_(false)
+  , sink_(nullptr)
+  , capacity_(capacity ? capacity : 1)
+  , next_(0)
+  , logged_(0)
+{}
+
+slow_query_log::~slow_query_log()
+{}
+
+unsigned long long slow_query_log::threshold() const
+{
+  return threshold_;
+}
+
+void slow_query_log::threshold(std::chrono::nanoseconds threshold)
+{
+  threshold_ = (unsigned long long)threshold.count();
+}
+
+bool slow_query_log::is_slow(unsigned long long duration) const
+{
+  return duration >= threshold_;
+}
+
+bool slow_query_log::explain() const
+{
+  return explain_;
+}
+
+void slow_query_log::explain(bool enable)
+{
+  explain_ = enable;
+}
+
+void slow_query_log::sink(slow_query_sink *s)
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  sink_ = s;
+}
+
+void slow_query_log::log(const slow_query &query)
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  // the ring overwrites the oldest
+  // statement once it is full
+  if (ring_.size() < capacity_) {
+    ring_.push_back(query);
+  } else {
+    ring_[next_] = query;
+  }
+  next_ = (next_ + 1) % capacity_;
+  ++logged_;
+  if (sink_) {
+    sink_->log(query);
+  }
+}
+
+slow_query_log::t_query_vector slow_query_log::queries() const
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  if (ring_.size() < capacity_) {
+    return ring_;
+  }
+  t_query_vector queries(ring_.begin() + next_, ring_.end());
+  queries.insert(queries.end(), ring_.begin(), ring_.begin() + next_);
+  return queries;
+}
+
+std::size_t slow_query_log::capacity() const
+{
+  return capacity_;
+}
+
+unsigned long slow_query_log::logged() const
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  return logged_;
+}
+
+void slow_query_log::clear()
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  ring_.clear();
+  next_ = 0;
+  logged_ = 0;
+  plans_.clear();
+}
+
+bool slow_query_log::find_plan(const std::string &sql, std::string &plan) const
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  std::unordered_map<std::string, std::string>::const_iterator i = plans_.find(sql);
+  if (i == plans_.end()) {
+    return false;
+  }
+  plan = i->second;
+  return true;
+}
+
+void slow_query_log::add_plan(const std::string &sql, const std::string &plan)
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  plans_[sql] = plan;
+}
+
+std::string slow_query_log::parameters(const object_atomizable *o)
+{
+  parameter_printer printer;
+  o->serialize(printer);
+  return printer.str();
+}
+
+}
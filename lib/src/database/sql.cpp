@@ -60,11 +60,13 @@ void sql::append(const char *id, data_type_t type, const std::string &val)
 
 void sql::append(const condition &c)
 {
-  field_ptr f(new field(c.column().c_str(), c.type(), host_field_vector_.size(), true));
-  
   token_list_.push_back(new condition_token(c));
-  host_field_map_.insert(std::make_pair(c.column(), f));
-  host_field_vector_.push_back(f);
+  // a value list condition has a host field per value
+  for (unsigned long i = 0; i < c.count(); ++i) {
+    field_ptr f(new field(c.column().c_str(), c.type(), host_field_vector_.size(), true));
+    host_field_map_.insert(std::make_pair(c.column(), f));
+    host_field_vector_.push_back(f);
+  }
 }
 
 std::string sql::prepare() const
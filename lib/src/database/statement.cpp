@@ -16,10 +16,12 @@
  */
 
 #include "database/statement.hpp"
+#include "database/result.hpp"
 
 #include "object/object_atomizable.hpp"
 
 #include <functional>
+#include <memory>
 
 using namespace std::placeholders;
 
@@ -36,6 +38,19 @@ int statement::bind(object_atomizable *o)
   return host_index;
 }
 
+int statement::bind(object_atomizable *o, int pos)
+{
+  host_index = pos;
+  o->serialize(*this);
+  return host_index;
+}
+
+unsigned long statement::execute_update()
+{
+  std::unique_ptr<result> res(execute());
+  return res ? res->affected_rows() : 0;
+}
+
 std::string statement::str() const
 {
   return sql_;
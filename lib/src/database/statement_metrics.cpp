@@ -0,0 +1,242 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "database/statement_metrics.hpp"
+
+#include "object/object_atomizable.hpp"
+#include "object/object_atomizer.hpp"
+#include "object/primary_key.hpp"
+
+#include "tools/blob.hpp"
+#include "tools/varchar.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace oos {
+
+namespace {
+
+/*
+ * sums the sizes of all attributes
+ * written to a statement
+ */
+class byte_counter : public object_writer
+{
+public:
+  byte_counter() : bytes(0) {}
+  virtual ~byte_counter() {}
+
+  virtual void write(const char*, char) { bytes += sizeof(char); }
+  virtual void write(const char*, float) { bytes += sizeof(float); }
+  virtual void write(const char*, double) { bytes += sizeof(double); }
+  virtual void write(const char*, short) { bytes += sizeof(short); }
+  virtual void write(const char*, int) { bytes += sizeof(int); }
+  virtual void write(const char*, long) { bytes += sizeof(long); }
+  virtual void write(const char*, unsigned char) { bytes += sizeof(unsigned char); }
+  virtual void write(const char*, unsigned short) { bytes += sizeof(unsigned short); }
+  virtual void write(const char*, unsigned int) { bytes += sizeof(unsigned int); }
+  virtual void write(const char*, unsigned long) { bytes += sizeof(unsigned long); }
+  virtual void write(const char*, bool) { bytes += sizeof(bool); }
+  virtual void write(const char*, const char *x, int s) { bytes += strnlen(x, s); }
+  virtual void write(const char*, const std::string &x) { bytes += x.size(); }
+  virtual void write(const char*, const varchar_base &x) { bytes += x.size(); }
+  // dates are bound as julian day, times as text or native timestamp
+  virtual void write(const char*, const date&) { bytes += sizeof(int); }
+  virtual void write(const char*, const time&) { bytes += sizeof(long long); }
+  virtual void write(const char*, const blob &x) { bytes += x.size(); }
+  // object pointers are bound as id
+  virtual void write(const char*, const object_base_ptr&) { bytes += sizeof(long); }
+  virtual void write(const char*, const object_container&) {}
+  virtual void write(const char *id, const primary_key_base &x) { x.serialize(id, *this); }
+
+  unsigned long long bytes;
+};
+
+}
+
+latency_histogram::latency_histogram()
+  : count_(0)
+  , total_(0)
+  , min_(0)
+  , max_(0)
+{
+  std::memset(buckets_, 0, sizeof(buckets_));
+}
+
+void latency_histogram::record(unsigned long long nanoseconds)
+{
+  std::size_t i = 0;
+  unsigned long long n = nanoseconds >> 1;
+  while (n && i < bucket_count - 1) {
+    n >>= 1;
+    ++i;
+  }
+  ++buckets_[i];
+  if (count_ == 0 || nanoseconds < min_) {
+    min_ = nanoseconds;
+  }
+  if (nanoseconds > max_) {
+    max_ = nanoseconds;
+  }
+  ++count_;
+  total_ += nanoseconds;
+}
+
+unsigned long latency_histogram::count() const
+{
+  return count_;
+}
+
+unsigned long long latency_histogram::total() const
+{
+  return total_;
+}
+
+unsigned long long latency_histogram::min() const
+{
+  return min_;
+}
+
+unsigned long long latency_histogram::max() const
+{
+  return max_;
+}
+
+unsigned long latency_histogram::bucket(std::size_t i) const
+{
+  return i < bucket_count ? buckets_[i] : 0;
+}
+
+unsigned long long latency_histogram::upper_bound(std::size_t i)
+{
+  if (i >= bucket_count - 1) {
+    return std::numeric_limits<unsigned long long>::max();
+  }
+  return 2ULL << i;
+}
+
+unsigned long long latency_histogram::percentile(double p) const
+{
+  if (count_ == 0) {
+    return 0;
+  }
+  // rank of the requested duration
+  double rank = p / 100.0 * count_;
+  unsigned long seen = 0;
+  for (std::size_t i = 0; i < bucket_count; ++i) {
+    seen += buckets_[i];
+    if (seen > 0 && seen >= rank) {
+      unsigned long long bound = upper_bound(i);
+      return bound < max_ ? bound : max_;
+    }
+  }
+  return max_;
+}
+
+statement_metrics::entry::entry()
+  : calls(0)
+  , rows(0)
+  , bytes_bound(0)
+{}
+
+statement_metrics::timer::timer(entry *e, t_phase phase, bool timed)
+  : entry_(e)
+  , phase_(phase)
+  , timed_(e || timed)
+{
+  if (timed_) {
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+statement_metrics::timer::~timer()
+{
+  stop();
+}
+
+unsigned long long statement_metrics::timer::stop()
+{
+  if (!timed_) {
+    return 0;
+  }
+  std::chrono::steady_clock::duration d = std::chrono::steady_clock::now() - start_;
+  unsigned long long nanoseconds = (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+  if (entry_) {
+    entry_->phases[phase_].record(nanoseconds);
+    entry_ = nullptr;
+  }
+  timed_ = false;
+  return nanoseconds;
+}
+
+statement_metrics::statement_metrics()
+{}
+
+statement_metrics::~statement_metrics()
+{}
+
+statement_metrics::entry* statement_metrics::acquire(const std::string &key, const std::string &table, const std::string &operation)
+{
+  t_entry_map::iterator i = entries_.find(key);
+  if (i == entries_.end()) {
+    i = entries_.insert(std::make_pair(key, entry())).first;
+    i->second.table = table;
+    i->second.operation = operation;
+  }
+  return &i->second;
+}
+
+const statement_metrics::entry* statement_metrics::find(const std::string &key) const
+{
+  const_iterator i = entries_.find(key);
+  return i == entries_.end() ? nullptr : &i->second;
+}
+
+const statement_metrics::entry* statement_metrics::find(const std::string &table, const std::string &operation) const
+{
+  return find(table + "." + operation);
+}
+
+statement_metrics::const_iterator statement_metrics::begin() const
+{
+  return entries_.begin();
+}
+
+statement_metrics::const_iterator statement_metrics::end() const
+{
+  return entries_.end();
+}
+
+std::size_t statement_metrics::size() const
+{
+  return entries_.size();
+}
+
+void statement_metrics::clear()
+{
+  entries_.clear();
+}
+
+unsigned long long statement_metrics::bound_bytes(const object_atomizable *o)
+{
+  byte_counter counter;
+  o->serialize(counter);
+  return counter.bytes;
+}
+
+}
@@ -19,6 +19,7 @@
 #include "database/table.hpp"
 #include "database/database_exception.hpp"
 #include "database/result.hpp"
+#include "database/slow_query_log.hpp"
 #include "database/query.hpp"
 #include "database/condition.hpp"
 
@@ -84,9 +85,17 @@ private:
   object *object_;
 };
 
+// the number of ids of the batched delete
+// statements in descending order
+const std::size_t table::delete_batch_sizes[3] = { 64, 16, 4 };
+
+// the number of objects of a multi row update
+const std::size_t table::update_batch_size = 32;
+
 table::table(database &db, const prototype_node &node)
   : db_(db)
   , node_(node)
+  , update_batch_prepared_(false)
   , prepared_(false)
   , is_loaded_(false)
 {}
@@ -104,10 +113,22 @@ void table::prepare()
   query q(db_);
 
   std::unique_ptr<object> o(node_.producer->create());
-  insert_.reset(q.insert(o.get(), node_.type).prepare());
-  update_.reset(q.reset().update(node_.type, o.get()).where(cond("id").equal(0)).prepare());
-  delete_.reset(q.reset().remove(node_).where(cond("id").equal(0)).prepare());
-  select_.reset(q.reset().select(node_).prepare());
+  {
+    statement_metrics::timer t(metrics("insert"), statement_metrics::PREPARE);
+    insert_.reset(q.insert(o.get(), node_.type).prepare());
+  }
+  {
+    statement_metrics::timer t(metrics("update"), statement_metrics::PREPARE);
+    update_.reset(q.reset().update(node_.type, o.get()).where(cond("id").equal(0)).prepare());
+  }
+  {
+    statement_metrics::timer t(metrics("delete"), statement_metrics::PREPARE);
+    delete_.reset(q.reset().remove(node_).where(cond("id").equal(0)).prepare());
+  }
+  {
+    statement_metrics::timer t(metrics("select"), statement_metrics::PREPARE);
+    select_.reset(q.reset().select(node_).prepare());
+  }
 
   prepared_ = true;
 }
@@ -130,9 +151,25 @@ void table::load(object_store &ostore)
 
   table_reader reader(*this, ostore);
 
+  slow_query_log *slow = db_.slow_queries();
+  statement_metrics::timer load_timer(nullptr, statement_metrics::EXECUTE, slow != nullptr);
+
+  statement_metrics::entry *m = metrics("select");
+  statement_metrics::timer execute_timer(m, statement_metrics::EXECUTE);
   std::unique_ptr<result> res(select_->execute());
+  execute_timer.stop();
+  if (m) {
+    ++m->calls;
+  }
+
+  unsigned long rows = reader.read(res.get());
 
-  reader.read(res.get());
+  // a slow load is logged with the duration
+  // of the query and the object creation
+  unsigned long long duration = load_timer.stop();
+  if (slow && slow->is_slow(duration)) {
+    db_.log_slow_query(select_->str(), "", rows, duration);
+  }
 
   /*
    * after all tables were loaded fill
@@ -161,19 +198,60 @@ void table::load(object_store &ostore)
 
 void table::insert(object *obj)
 {
+  statement_metrics::entry *m = metrics("insert");
+  statement_metrics::timer bind_timer(m, statement_metrics::BIND);
   insert_->bind(obj);
-  std::unique_ptr<result> res(insert_->execute());
+  bind_timer.stop();
+  execute(*insert_, m, obj, 0);
   // Todo: check insert result == 1
 }
 
 void table::update(object *obj)
 {
+  statement_metrics::entry *m = metrics("update");
+  statement_metrics::timer bind_timer(m, statement_metrics::BIND);
   int pos = update_->bind(obj);
   update_->bind(pos, obj->id());
-  std::unique_ptr<result> res(update_->execute());
+  bind_timer.stop();
+  execute(*update_, m, obj, obj->id());
   // Todo: check update result
 }
 
+void table::update(const std::vector<object*> &objs)
+{
+  std::size_t first = 0;
+  statement_metrics::entry *m = metrics("update");
+  if (objs.size() >= update_batch_size && !update_batch_prepared_) {
+    statement_metrics::timer t(m, statement_metrics::PREPARE);
+    update_batch_.reset(db_.prepare_update(node_, update_batch_size));
+    update_batch_prepared_ = true;
+  }
+  if (update_batch_) {
+    statement &stmt = *update_batch_;
+    while (objs.size() - first >= update_batch_size) {
+      statement_metrics::timer bind_timer(m, statement_metrics::BIND);
+      stmt.reset();
+      int pos = 0;
+      for (std::size_t i = 0; i < update_batch_size; ++i) {
+        pos = stmt.bind(objs[first + i], pos);
+      }
+      bind_timer.stop();
+      execute(stmt, m, nullptr, 0);
+      if (m) {
+        for (std::size_t i = 0; i < update_batch_size; ++i) {
+          m->bytes_bound += statement_metrics::bound_bytes(objs[first + i]);
+        }
+      }
+      first += update_batch_size;
+    }
+  }
+  // the remaining objects reuse the
+  // prepared single row update
+  while (first < objs.size()) {
+    update(objs[first++]);
+  }
+}
+
 void table::remove(object *obj)
 {
   remove(obj->id());
@@ -181,11 +259,50 @@ void table::remove(object *obj)
 
 void table::remove(long id)
 {
+  statement_metrics::entry *m = metrics("delete");
+  statement_metrics::timer bind_timer(m, statement_metrics::BIND);
+  delete_->reset();
   delete_->bind(0, id);
-  std::unique_ptr<result> res(delete_->execute());
+  bind_timer.stop();
+  execute(*delete_, m, nullptr, id);
   // Todo: check delete result
 }
 
+void table::remove(const std::vector<long> &ids)
+{
+  std::size_t first = 0;
+  for (std::size_t b = 0; b < 3; ++b) {
+    const std::size_t size = delete_batch_sizes[b];
+    if (ids.size() - first < size) {
+      continue;
+    }
+    statement_metrics::entry *m = metrics("delete");
+    if (!delete_batch_[b]) {
+      statement_metrics::timer t(m, statement_metrics::PREPARE);
+      query q(db_);
+      delete_batch_[b].reset(q.remove(node_).where(cond("id").in(std::vector<long>(size, 0))).prepare());
+    }
+    statement &stmt = *delete_batch_[b];
+    while (ids.size() - first >= size) {
+      statement_metrics::timer bind_timer(m, statement_metrics::BIND);
+      stmt.reset();
+      for (std::size_t i = 0; i < size; ++i) {
+        stmt.bind(i, ids[first + i]);
+      }
+      bind_timer.stop();
+      execute(stmt, m, nullptr, 0);
+      if (m) {
+        m->bytes_bound += size * sizeof(long);
+      }
+      first += size;
+    }
+  }
+  // the remaining ids are deleted one by one
+  while (first < ids.size()) {
+    remove(ids[first++]);
+  }
+}
+
 void table::drop()
 {
   query q(db_);
@@ -199,6 +316,37 @@ bool table::is_loaded() const
   return is_loaded_;
 }
 
+void table::execute(statement &stmt, statement_metrics::entry *m, const object *obj, long id)
+{
+  slow_query_log *slow = db_.slow_queries();
+  statement_metrics::timer execute_timer(m, statement_metrics::EXECUTE, slow != nullptr);
+  unsigned long rows = stmt.execute_update();
+  unsigned long long duration = execute_timer.stop();
+  if (m) {
+    ++m->calls;
+    m->rows += rows;
+    m->bytes_bound += (obj ? statement_metrics::bound_bytes(obj) : 0) + (id ? sizeof(long) : 0);
+  }
+  if (slow && slow->is_slow(duration)) {
+    // the parameter summary is
+    // built for slow statements only
+    std::string parameters(obj ? slow_query_log::parameters(obj) : "");
+    if (id) {
+      parameters += (parameters.empty() ? "" : ", ") + std::string("id=") + std::to_string(id);
+    }
+    db_.log_slow_query(stmt.str(), parameters, rows, duration);
+  }
+}
+
+statement_metrics::entry* table::metrics(const char *operation) const
+{
+  statement_metrics *metrics = db_.metrics();
+  if (!metrics) {
+    return nullptr;
+  }
+  return metrics->acquire(node_.type + std::string(".") + operation, node_.type, operation);
+}
+
 const prototype_node& table::node() const
 {
   return node_;
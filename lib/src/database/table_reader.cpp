@@ -12,13 +12,23 @@ table_reader::table_reader(table &t, object_store &ostore)
 {}
 
 
-void table_reader::read(result *res)
+unsigned long table_reader::read(result *res)
 {
   // check result
   // create object
   std::unique_ptr<object> obj(table_.node_.producer->create());
 
-  while (res->fetch(obj.get())) {
+  statement_metrics::entry *m = table_.metrics("select");
+
+  unsigned long rows = 0;
+  while (true) {
+    statement_metrics::timer fetch_timer(m, statement_metrics::FETCH);
+    if (!res->fetch(obj.get())) {
+      break;
+    }
+    fetch_timer.stop();
+
+    statement_metrics::timer materialize_timer(m, statement_metrics::MATERIALIZE);
 
     new_proxy_ = new object_proxy(obj.get(), nullptr);
 
@@ -29,7 +39,13 @@ void table_reader::read(result *res)
     ostore_.insert_proxy(new_proxy_);
 
     obj.reset(table_.node_.producer->create());
+
+    ++rows;
+  }
+  if (m) {
+    m->rows += rows;
   }
+  return rows;
 }
 
 void table_reader::read_value(const char *, object_base_ptr &x)
@@ -55,10 +71,10 @@ void table_reader::read_value(const char *, object_base_ptr &x)
    * add the child object to the object proxy
    * of the parent container
    */
-  database::table_map_t::iterator j = table_.db_.table_map_.find(node->type);
+  table *tbl = table_.db_.find_table(node.get());
   prototype_node::field_prototype_map_t::const_iterator i = table_.node_.relations.find(node->type);
-  if (i != table_.node_.relations.end()) {
-    j->second->relation_data[i->second.second][oid].push_back(new_proxy_);
+  if (tbl && i != table_.node_.relations.end()) {
+    tbl->relation_data[i->second.second][oid].push_back(new_proxy_);
   }
 
   x.reset(oproxy);
@@ -48,7 +48,8 @@ void transaction::on_insert(object_proxy *proxy)
     if (j == action_list_.end()) {
       // should not happen
     } else {
-      id_map_.insert(std::make_pair(proxy->obj->id(), j));
+      action_slot s = { j, ai.slot() };
+      id_map_.insert(std::make_pair(proxy->obj->id(), s));
     }
   } else {
     // ERROR: an object with that id already exists
@@ -89,10 +90,13 @@ void transaction::on_delete(object_proxy *proxy)
 
   id_iterator_map_t::iterator i = id_map_.find(proxy->obj->id());
   if (i == id_map_.end()) {
-    backup(new delete_action(proxy->node->type.c_str(), proxy->obj->id()), proxy->obj);
+    backup(new delete_action(proxy->node, proxy->obj->id()), proxy->obj);
   } else {
     action_remover ar(action_list_);
-    ar.remove(i->second, proxy);
+    if (ar.remove(i->second.action, proxy, i->second.slot)) {
+      // the object never reaches the database
+      id_map_.erase(i);
+    }
   }
 }
 
@@ -136,12 +140,36 @@ transaction::commit()
     throw database_exception("transaction", "transaction isn't current transaction");
   } else {
     // commit all transaction actions
-    db_.commit(*this);
+    if (db_.async_commit_enabled()) {
+      ticket_ = db_.commit_async(*this);
+    } else {
+      db_.commit(*this);
+      ticket_ = commit_ticket();
+    }
     // clear actions
     cleanup();
   }
 }
 
+commit_ticket
+transaction::commit_async()
+{
+  if (!db_.current_transaction() || db_.current_transaction() != this) {
+    throw database_exception("transaction", "transaction isn't current transaction");
+  }
+  // queue all transaction actions
+  ticket_ = db_.commit_async(*this);
+  // clear actions
+  cleanup();
+  return ticket_;
+}
+
+commit_ticket
+transaction::ticket() const
+{
+  return ticket_;
+}
+
 void
 transaction::rollback()
 {
@@ -194,8 +222,8 @@ transaction::backup(action *a, const object *o)
    *************/
   backup_visitor bv;
   bv.backup(a, o, &object_buffer_);
-  iterator i = action_list_.insert(action_list_.end(), a);
-  id_map_.insert(std::make_pair(o->id(), i));
+  action_slot s = { action_list_.insert(action_list_.end(), a), 0 };
+  id_map_.insert(std::make_pair(o->id(), s));
 }
 
 void transaction::restore(action *a)
@@ -113,8 +113,8 @@ transaction::iterator action_inserter::insert(object_proxy *proxy)
     }
   }
   if (!inserted_) {
-    insert_action *a = new insert_action(proxy_->node->type.c_str());
-    a->push_back(proxy_);
+    insert_action *a = new insert_action(proxy_->node);
+    slot_ = a->push_back(proxy_);
     return action_list_.insert(action_list_.end(), a);
   }
   return last;
@@ -125,8 +125,8 @@ void action_inserter::visit(insert_action *a)
   // check (object) type of insert action
   // if type is equal to objects type
   // add object to action
-  if (a->type() == proxy_->node->type) {
-    a->push_back(proxy_);
+  if (a->node() ? a->node() == proxy_->node : a->type() == proxy_->node->type) {
+    slot_ = a->push_back(proxy_);
     inserted_ = true;
   }
 }
@@ -143,13 +143,16 @@ void action_inserter::visit(delete_action *)
   // it is inserted, throw error
 }
 
-bool action_remover::remove(transaction::iterator i, object_proxy *proxy)
+bool action_remover::remove(transaction::iterator i, object_proxy *proxy, std::size_t slot)
 {
   proxy_ = proxy;
+  id_ = proxy->obj->id();
   iter_ = i;
+  slot_ = slot;
+  cancelled_ = false;
   (*i)->accept(this);
   proxy_ = 0;
-  return true;
+  return cancelled_;
 }
 
 void action_remover::visit(insert_action *a)
@@ -157,15 +160,12 @@ void action_remover::visit(insert_action *a)
   /***********
    * 
    * an insert action was found
-   * try to find object with given
-   * id and delete and remove it
-   * from insert action
+   * remove the object from its
+   * slot of the insert action
    *
    ***********/
-  insert_action::iterator i = a->find(id_);
-  if (i != a->end()) {
-    a->erase(i);
-  }
+  a->remove(slot_);
+  cancelled_ = true;
   if (a->empty()) {
     delete a;
     action_list_.erase(iter_);
@@ -182,8 +182,8 @@ void action_remover::visit(update_action *a)
    * with this given object.
    *
    ***********/
-  if (a->proxy()->obj->id() == id_) {
-    *iter_ = new delete_action(proxy_->node->type.c_str(), proxy_->obj->id());
+  if (a->proxy() == proxy_) {
+    *iter_ = new delete_action(proxy_->node, id_);
     delete a;
   }
 }
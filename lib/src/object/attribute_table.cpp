@@ -0,0 +1,127 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "object/object.hpp"
+#include "object/attribute_table.hpp"
+#include "object/object_atomizer.hpp"
+#include "object/object_container.hpp"
+
+#include "tools/blob.hpp"
+
+#include <memory>
+
+namespace oos {
+
+/*
+ * collects the location and kind of
+ * all attributes of an object
+ */
+class attribute_scanner : public generic_object_reader<attribute_scanner>
+{
+public:
+  attribute_scanner(object *o, std::size_t size, attribute_table &table)
+    : generic_object_reader<attribute_scanner>(this)
+    , object_(reinterpret_cast<char*>(o))
+    , first_(reinterpret_cast<char*>(dynamic_cast<void*>(o)))
+    , last_(first_ + size)
+    , table_(table)
+    , valid_(true)
+  {}
+  virtual ~attribute_scanner() {}
+
+  bool valid() const
+  {
+    return valid_;
+  }
+
+  void read_value(const char *id, char &x) { add(id, &x, sizeof(x), attribute_table::type_char); }
+  void read_value(const char *id, float &x) { add(id, &x, sizeof(x), attribute_table::type_float); }
+  void read_value(const char *id, double &x) { add(id, &x, sizeof(x), attribute_table::type_double); }
+  void read_value(const char *id, short &x) { add(id, &x, sizeof(x), attribute_table::type_short); }
+  void read_value(const char *id, int &x) { add(id, &x, sizeof(x), attribute_table::type_int); }
+  void read_value(const char *id, long &x) { add(id, &x, sizeof(x), attribute_table::type_long); }
+  void read_value(const char *id, unsigned char &x) { add(id, &x, sizeof(x), attribute_table::type_unsigned_char); }
+  void read_value(const char *id, unsigned short &x) { add(id, &x, sizeof(x), attribute_table::type_unsigned_short); }
+  void read_value(const char *id, unsigned int &x) { add(id, &x, sizeof(x), attribute_table::type_unsigned_int); }
+  void read_value(const char *id, unsigned long &x) { add(id, &x, sizeof(x), attribute_table::type_unsigned_long); }
+  void read_value(const char *id, bool &x) { add(id, &x, sizeof(x), attribute_table::type_bool); }
+  void read_value(const char *id, char *x, int s) { add(id, x, s, attribute_table::type_char_pointer, s); }
+  void read_value(const char *id, std::string &x) { add(id, &x, sizeof(x), attribute_table::type_string); }
+  void read_value(const char *id, varchar_base &x) { add(id, &x, sizeof(x), attribute_table::type_varchar); }
+  void read_value(const char *id, date &x) { add(id, &x, sizeof(x), attribute_table::type_date); }
+  void read_value(const char *id, time &x) { add(id, &x, sizeof(x), attribute_table::type_time); }
+  void read_value(const char *id, blob &x) { add(id, &x, sizeof(x), attribute_table::type_blob); }
+  void read_value(const char *id, object_base_ptr &x) { add(id, &x, sizeof(x), attribute_table::type_object_ptr); }
+  void read_value(const char *id, object_container &x) { add(id, &x, sizeof(x), attribute_table::type_container); }
+  void read_value(const char *id, primary_key_base &x)
+  {
+    x.deserialize(id, *this);
+  }
+
+private:
+  void add(const char *id, void *addr, std::size_t size, attribute_table::t_kind kind, int capacity = 0)
+  {
+    char *first = static_cast<char*>(addr);
+    if (first < first_ || first + size > last_) {
+      // attribute isn't part of the object
+      valid_ = false;
+      return;
+    }
+    attribute_table::attribute attr;
+    attr.offset = first - object_;
+    attr.kind = kind;
+    attr.size = capacity;
+    if (!table_.attributes_.insert(std::make_pair(std::string(id), attr)).second) {
+      // attribute name isn't unique
+      valid_ = false;
+    }
+  }
+
+private:
+  char *object_;
+  char *first_;
+  char *last_;
+  attribute_table &table_;
+  bool valid_;
+};
+
+attribute_table* attribute_table::build(object *o, std::size_t size)
+{
+  if (size == 0) {
+    return nullptr;
+  }
+  std::unique_ptr<attribute_table> table(new attribute_table);
+  attribute_scanner scanner(o, size, *table);
+  o->deserialize(scanner);
+  return scanner.valid() ? table.release() : nullptr;
+}
+
+const attribute_table::attribute* attribute_table::find(const std::string &name) const
+{
+  t_attribute_map::const_iterator i = attributes_.find(name);
+  if (i == attributes_.end()) {
+    return nullptr;
+  }
+  return &i->second;
+}
+
+std::size_t attribute_table::size() const
+{
+  return attributes_.size();
+}
+
+}
@@ -17,11 +17,14 @@
 
 #include "object/object.hpp"
 #include "object/object_store.hpp"
+#include "object/object_proxy.hpp"
+#include "object/prototype_node.hpp"
 
 namespace oos {
 
 object::object()
 	: id_(0)
+  , proxy_(0)
 {
 }
 
@@ -64,4 +67,9 @@ std::ostream& operator <<(std::ostream &os, const object &o)
   return os;
 }
 
+const attribute_table* object::attributes() const
+{
+  return proxy_ && proxy_->node ? proxy_->node->attributes : nullptr;
+}
+
 }
@@ -28,6 +28,7 @@ object_deleter::t_object_count_struct::t_object_count_struct(object_proxy *oprox
   , ref_count(oproxy->ref_count)
   , ptr_count(oproxy->ptr_count)
   , ignore(ignr)
+  , visited(false)
 {}
 
 object_deleter::~object_deleter()
@@ -36,19 +37,20 @@ object_deleter::~object_deleter()
 bool
 object_deleter::is_deletable(object_proxy *proxy)
 {
-  object_count_map.clear();
-  object_count_map.insert(std::make_pair(proxy->obj->id(), t_object_count(proxy, false)));
+  clear();
+  visit(acquire(proxy, false));
 
   // start collecting information
-  proxy->obj->deserialize(*this);
+  process();
   
   return check_object_count_map();
 }
 
 bool object_deleter::is_deletable(object_container &oc)
 {
-  object_count_map.clear();
+  clear();
   oc.for_each(std::bind(&object_deleter::check_object_list_node, this, _1));
+  process();
   return check_object_count_map();
 }
 
@@ -73,61 +75,58 @@ void object_deleter::read_value(char const *id, primary_key_base &x)
 object_deleter::iterator
 object_deleter::begin()
 {
-  return object_count_map.begin();
+  return object_count_vector_.begin();
 }
 
 object_deleter::iterator
 object_deleter::end()
 {
-  return object_count_map.end();
+  return object_count_vector_.end();
 }
 
 void object_deleter::check_object(object_proxy *proxy, bool is_ref)
 {
-  std::pair<t_object_count_map::iterator, bool> ret = object_count_map.insert(std::make_pair(proxy->obj->id(), t_object_count(proxy)));
+  t_object_count &count = acquire(proxy, true);
   if (!is_ref) {
-    --ret.first->second.ptr_count;
+    --count.ptr_count;
   } else {
-    --ret.first->second.ref_count;
+    --count.ref_count;
   }
   if (!is_ref) {
-    ret.first->second.ignore = false;
-    proxy->obj->deserialize(*this);
+    count.ignore = false;
+    visit(count);
   }
 }
 
 void
 object_deleter::check_object_list_node(object_proxy *proxy)
 {
-  std::pair<t_object_count_map::iterator, bool> ret = object_count_map.insert(std::make_pair(proxy->obj->id(), t_object_count(proxy, false)));
-  
   /**********
    * 
-   * object is already in list and will
-   * be ignored on deletion so set
+   * object is maybe already in list and
+   * will be ignored on deletion so set
    * ignore flag to false because this
    * node must be deleted
    * 
    **********/
-  if (!ret.second && ret.first->second.ignore) {
-    ret.first->second.ignore = false;
-  }
+  t_object_count &count = acquire(proxy, false);
+  count.ignore = false;
 
-  // start collecting information
-  proxy->obj->deserialize(*this);
+  // collect information of the node
+  visit(count);
 }
 
 bool
 object_deleter::check_object_count_map() const
 {
   // check the reference and pointer counter of collected objects
-  const_iterator first = object_count_map.begin();
-  const_iterator last = object_count_map.end();
+  const_iterator first = object_count_vector_.begin();
+  const_iterator last = object_count_vector_.end();
   while (first != last)
   {
-    if (first->second.ignore) {
+    if (first->ignore) {
       ++first;
-    } else if (first->second.ref_count == 0 && first->second.ptr_count == 0) {
+    } else if (first->ref_count == 0 && first->ptr_count == 0) {
       ++first;
     } else {
       return false;
@@ -136,4 +135,46 @@ object_deleter::check_object_count_map() const
   return true;
 }
 
+void object_deleter::clear()
+{
+  // keep the allocated buckets and
+  // memory for the next check
+  object_count_vector_.clear();
+  object_index_map_.clear();
+  proxy_stack_.clear();
+}
+
+object_deleter::t_object_count& object_deleter::acquire(object_proxy *proxy, bool ignore)
+{
+  std::pair<t_object_index_map::iterator, bool> ret = object_index_map_.insert(std::make_pair(proxy->obj->id(), object_count_vector_.size()));
+  if (ret.second) {
+    object_count_vector_.push_back(t_object_count(proxy, ignore));
+  }
+  return object_count_vector_[ret.first->second];
+}
+
+void object_deleter::visit(t_object_count &count)
+{
+  /**********
+   *
+   * each object is only deserialized once
+   * so the counters of its children are
+   * decremented only once as well
+   *
+   **********/
+  if (!count.visited) {
+    count.visited = true;
+    proxy_stack_.push_back(count.proxy);
+  }
+}
+
+void object_deleter::process()
+{
+  while (!proxy_stack_.empty()) {
+    object_proxy *proxy = proxy_stack_.back();
+    proxy_stack_.pop_back();
+    proxy->obj->deserialize(*this);
+  }
+}
+
 }
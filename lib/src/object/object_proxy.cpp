@@ -19,10 +19,30 @@
 #include "object/object.hpp"
 #include "object/object_store.hpp"
 
+#include <cstdint>
+#include <mutex>
+
 using namespace std;
 
 namespace oos {
 
+namespace {
+
+/*
+ * readers sharing a store copy object pointers
+ * concurrently; the pointer set of a proxy is
+ * guarded by one of a few striped mutexes
+ */
+const std::size_t PTR_SET_STRIPES = 64;
+
+std::mutex& ptr_set_mutex(const object_proxy *proxy)
+{
+  static std::mutex stripes[PTR_SET_STRIPES];
+  return stripes[(reinterpret_cast<std::uintptr_t>(proxy) / sizeof(object_proxy)) % PTR_SET_STRIPES];
+}
+
+}
+
 object_proxy::object_proxy(object_store *os)
   : prev(0)
   , next(0)
@@ -32,6 +52,7 @@ object_proxy::object_proxy(object_store *os)
   , ptr_count(0)
   , ostore(os)
   , node(0)
+  , node_index(0)
 {}
 
 
@@ -44,6 +65,7 @@ object_proxy::object_proxy(unsigned long i, object_store *os)
   , ptr_count(0)
   , ostore(os)
   , node(0)
+  , node_index(0)
 {}
 
 object_proxy::object_proxy(object *o, object_store *os)
@@ -55,7 +77,12 @@ object_proxy::object_proxy(object *o, object_store *os)
   , ptr_count(0)
   , ostore(os)
   , node(0)
-{}
+  , node_index(0)
+{
+  if (o) {
+    o->proxy_ = this;
+  }
+}
 
 object_proxy::~object_proxy()
 {
@@ -133,17 +160,22 @@ void object_proxy::reset(object *o)
   ref_count = 0;
   ptr_count = 0;
   obj = o;
+  if (o) {
+    o->proxy_ = this;
+  }
   oid = o ? o->id() : 0;
   node = 0;
 }
 
 void object_proxy::add(object_base_ptr *ptr)
 {
+  std::lock_guard<std::mutex> l(ptr_set_mutex(this));
   ptr_set_.insert(ptr);
 }
 
 bool object_proxy::remove(object_base_ptr *ptr)
 {
+  std::lock_guard<std::mutex> l(ptr_set_mutex(this));
   return ptr_set_.erase(ptr) == 1;
 }
 
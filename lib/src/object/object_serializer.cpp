@@ -23,6 +23,9 @@
 #include "object/object_list.hpp"
 
 #include "tools/byte_buffer.hpp"
+#include "tools/blob.hpp"
+
+#include <algorithm>
 
 using namespace std::placeholders;
 using namespace std;
@@ -71,7 +74,7 @@ void object_serializer::write_value(const char*, const varchar_base &s)
   size_t len = s.size();
   
   buffer_->append(&len, sizeof(len));
-  buffer_->append(s.str().c_str(), len);
+  buffer_->append(s.data(), len);
 }
 
 void object_serializer::write_value(const char *id, const date &x)
@@ -86,6 +89,14 @@ void object_serializer::write_value(const char *id, const time &x)
   write_value(id, tv.tv_usec);
 }
 
+void object_serializer::write_value(const char*, const blob &x)
+{
+  size_t len = x.size();
+
+  buffer_->append(&len, sizeof(len));
+  buffer_->append(x.data(), len);
+}
+
 void object_serializer::write_value(const char*, const object_base_ptr &x)
 {
   // write type and id into buffer
@@ -128,10 +139,15 @@ void object_serializer::read_value(const char*, varchar_base &s)
 {
   size_t len = 0;
   buffer_->release(&len, sizeof(len));
-  char *str = new char[len];
-  buffer_->release(str, len);
-  s.assign(str, len);
-  delete [] str;
+  // copy in chunks to avoid a temporary heap buffer
+  char chunk[256];
+  s.clear();
+  while (len > 0) {
+    size_t n = std::min(len, sizeof(chunk));
+    buffer_->release(chunk, n);
+    s.append(chunk, n);
+    len -= n;
+  }
 }
 
 void object_serializer::read_value(const char *, date &x)
@@ -149,6 +165,15 @@ void object_serializer::read_value(const char *, time &x)
   x.set(tv);
 }
 
+void object_serializer::read_value(const char*, blob &x)
+{
+  size_t len = 0;
+  buffer_->release(&len, sizeof(len));
+  // release directly into the blob
+  x.resize(len);
+  buffer_->release(x.data(), len);
+}
+
 void object_serializer::read_value(const char*, object_base_ptr &x)
 {
   /***************
@@ -165,13 +190,15 @@ void object_serializer::read_value(const char*, object_base_ptr &x)
   std::string type;
   read(0, type);
 
-  if (id > 0) {
+  if (id > 0 && ostore_) {
     object_proxy *oproxy = ostore_->find_proxy(id);
     if (!oproxy) {
       oproxy = ostore_->create_proxy(id);
     }
     x.reset(oproxy);
   } else {
+    // without a store the pointer
+    // keeps the id only
     x.proxy_ = new object_proxy(id, nullptr);
 //    x.id_ = id;
   }
@@ -188,6 +215,9 @@ void object_serializer::read_value(const char*, object_container &x)
   for (unsigned int i = 0; i < s; ++i) {
     read(0, id);
     read(0, type);
+    if (!ostore_) {
+      continue;
+    }
     object_proxy *oproxy = ostore_->find_proxy(id);
     if (!oproxy) {
       oproxy = ostore_->create_proxy(id);
@@ -136,6 +136,11 @@ void object_store::mark_modified(object_proxy *oproxy)
   std::for_each(observer_list_.begin(), observer_list_.end(), std::bind(&object_observer::on_update, _1, oproxy));
 }
 
+shared_mutex& object_store::mutex() const
+{
+  return mutex_;
+}
+
 void object_store::register_observer(object_observer *observer)
 {
   if (std::find(observer_list_.begin(), observer_list_.end(), observer) == observer_list_.end()) {
@@ -165,7 +170,7 @@ object_store::insert_object(object *o, bool notify)
   }
 
   // find prototype node
-  prototype_iterator node = prototype_tree_.find(typeid(*o).name());
+  prototype_iterator node = prototype_tree_.find(typeid(*o));
   if (node == prototype_tree_.end()) {
     // raise exception
 //    std::string msg("couldn't insert element of type [" + std::string(typeid(*o).name()) + "]");
@@ -198,6 +203,7 @@ object_store::insert_object(object *o, bool notify)
       throw object_exception("couldn't create object proxy");
     }
     oproxy->obj = o;
+    o->proxy_ = oproxy;
   }
   // insert new element node
   insert_proxy(node, oproxy);
@@ -243,8 +249,8 @@ object_store::remove(object_proxy *proxy)
   object_deleter::iterator last = object_deleter_.end();
   
   while (first != last) {
-    if (!first->second.ignore) {
-      remove_object((first++)->second.proxy, true);
+    if (!first->ignore) {
+      remove_object((first++)->proxy, true);
     } else {
       ++first;
     }
@@ -261,18 +267,16 @@ object_store::remove_object(object_proxy *proxy, bool notify)
     throw object_exception("couldn't remove object, no prototype");
   }
   
-  prototype_iterator node = prototype_tree_.find(proxy->node->type.c_str());
-  if (node == prototype_tree_.end()) {
-    throw object_exception("couldn't find node for object");
-  }
-  
+  // the proxy knows its node
+  prototype_node *node = proxy->node;
+
   if (object_map_.erase(proxy->obj->id()) != 1) {
     // couldn't remove object
     // throw exception
     throw object_exception("couldn't remove object");
   }
 
-  remove_proxy(node.get(), proxy);
+  remove_proxy(node, proxy);
 
   if (notify) {
     // notify observer
@@ -302,8 +306,8 @@ object_store::remove(object_container &oc)
   object_deleter::iterator last = object_deleter_.end();
   
   while (first != last) {
-    if (!first->second.ignore) {
-      remove_object((first++)->second.proxy, true);
+    if (!first->ignore) {
+      remove_object((first++)->proxy, true);
     } else {
       ++first;
     }
@@ -385,7 +389,7 @@ void object_store::insert_proxy(object_proxy *oproxy)
   }
 
   // find prototype node
-  prototype_iterator node = prototype_tree_.find(typeid(*oproxy->obj).name());
+  prototype_iterator node = prototype_tree_.find(typeid(*oproxy->obj));
   if (node == prototype_tree_.end()) {
     // raise exception
     throw object_exception("couldn't insert object");
@@ -444,6 +448,7 @@ void object_store::insert_proxy(const prototype_iterator &node, object_proxy *op
   }
   // set prototype node
   oproxy->node = node.get();
+  node->append_proxy(oproxy);
   // adjust size
   ++node->count;
 }
@@ -460,6 +465,7 @@ void object_store::remove_proxy(prototype_node *node, object_proxy *oproxy)
   }
   // unlink object_proxy
   unlink_proxy(oproxy);
+  node->remove_proxy(oproxy);
   // adjust object count for node
   --node->count;
 }
@@ -18,6 +18,8 @@
 #include "object/prototype_node.hpp"
 #include "object/prototype_tree.hpp"
 #include "object/object_store.hpp"
+#include "object/object_proxy.hpp"
+#include "object/attribute_table.hpp"
 
 #include <iostream>
 
@@ -36,7 +38,9 @@ prototype_node::prototype_node()
   , op_marker(0)
   , op_last(0)
   , depth(0)
+  , index(0)
   , count(0)
+  , attributes(0)
   , abstract(false)
   , initialized(false)
 {
@@ -53,8 +57,10 @@ prototype_node::prototype_node(object_base_producer *p, const char *t, bool a)
   , op_marker(0)
   , op_last(0)
   , depth(0)
+  , index(0)
   , count(0)
   , type(t)
+  , attributes(0)
   , abstract(a)
   , initialized(false)
 {
@@ -87,6 +93,7 @@ prototype_node::~prototype_node()
   if (producer) {
     delete producer;
   }
+  delete attributes;
 }
 
 bool
@@ -101,6 +108,29 @@ prototype_node::size() const
   return count;
 }
 
+void
+prototype_node::append_proxy(object_proxy *proxy)
+{
+  proxy->node_index = proxies.size();
+  proxies.push_back(proxy);
+}
+
+void
+prototype_node::remove_proxy(object_proxy *proxy)
+{
+  // swap in last proxy and adjust its back index
+  object_proxy *last_proxy = proxies.back();
+  proxies[proxy->node_index] = last_proxy;
+  last_proxy->node_index = proxy->node_index;
+  proxies.pop_back();
+}
+
+object_proxy*
+prototype_node::proxy_at(std::size_t i) const
+{
+  return proxies.at(i);
+}
+
 void
 prototype_node::insert(prototype_node *child)
 {
@@ -140,6 +170,7 @@ void prototype_node::clear(prototype_tree &tree, bool recursive)
       // delete object proxy and object
       delete op;
     }
+    proxies.clear();
     count = 0;
   }
 
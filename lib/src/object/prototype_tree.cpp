@@ -20,6 +20,7 @@
 #include "object/object_store.hpp"
 #include "object/object_atomizer.hpp"
 #include "object/object_container.hpp"
+#include "object/attribute_table.hpp"
 
 #include <iterator>
 #include <iostream>
@@ -257,6 +258,8 @@ void const_prototype_iterator::decrement()
 prototype_tree::prototype_tree()
   : first_(new prototype_node)
   , last_(new prototype_node)
+  , next_index_(1)
+  , generation_(0)
 {
   prototype_node *root = new prototype_node(new object_producer<object>, "object", true);
   object_proxy *first = new object_proxy(nullptr);
@@ -348,6 +351,8 @@ prototype_tree::iterator prototype_tree::insert(object_base_producer *producer,
   }
 
   parent_node->insert(node);
+  node->index = next_index_++;
+  ++generation_;
 
   // store prototype in map
   // Todo: check return value
@@ -356,8 +361,17 @@ prototype_tree::iterator prototype_tree::insert(object_base_producer *producer,
 
   // Check if nodes object has 'to-many' relations
   object *o = producer->create();
+  // register the type index; a second prototype for the same
+  // class makes it ambiguous and lookups fall back to the name
+  if (typeid_prototype_map_[producer->classname()].size() == 1) {
+    type_index_map_[std::type_index(typeid(*o))] = node;
+  } else {
+    type_index_map_.erase(std::type_index(typeid(*o)));
+  }
   relation_builder rb(*this, node);
   o->serialize(rb);
+  // build the named attribute access table
+  node->attributes = attribute_table::build(o, producer->size());
   delete o;
 
   return prototype_iterator(node);
@@ -379,6 +393,22 @@ prototype_tree::const_iterator prototype_tree::find(const char *type) const {
   return const_prototype_iterator(node);
 }
 
+prototype_tree::iterator prototype_tree::find(const std::type_info &ti) {
+  prototype_node *node = find_prototype_node(ti);
+  if (!node) {
+    return end();
+  }
+  return prototype_iterator(node);
+}
+
+prototype_tree::const_iterator prototype_tree::find(const std::type_info &ti) const {
+  prototype_node *node = find_prototype_node(ti);
+  if (!node) {
+    return end();
+  }
+  return const_prototype_iterator(node);
+}
+
 bool prototype_tree::empty() const {
   return first_->next == last_->prev;
 }
@@ -393,6 +423,11 @@ size_t prototype_tree::prototype_count() const
   return prototype_map_.size();
 }
 
+std::size_t prototype_tree::generation() const
+{
+  return generation_;
+}
+
 void prototype_tree::clear()
 {
   prototype_node *root = first_->next;
@@ -526,6 +561,13 @@ prototype_node* prototype_tree::find_prototype_node(const char *type) const {
   }
 }
 
+prototype_node* prototype_tree::find_prototype_node(const std::type_info &ti) const {
+  t_type_index_map::const_iterator i = type_index_map_.find(std::type_index(ti));
+  if (i != type_index_map_.end()) {
+    return i->second;
+  }
+  return find_prototype_node(ti.name());
+}
 
 prototype_node* prototype_tree::remove_prototype_node(prototype_node *node) {
   // remove (and delete) from tree (deletes subsequently all child nodes
@@ -537,6 +579,14 @@ prototype_node* prototype_tree::remove_prototype_node(prototype_node *node) {
   }
   // and objects they're containing
   node->clear(*this, false);
+  ++generation_;
+  // drop the type index entry of the node
+  for (t_type_index_map::iterator i = type_index_map_.begin(); i != type_index_map_.end(); ++i) {
+    if (i->second == node) {
+      type_index_map_.erase(i);
+      break;
+    }
+  }
   // delete prototype node as well
   // unlink node
   node->unlink();
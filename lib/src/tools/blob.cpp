@@ -1,14 +1,53 @@
 #include "tools/blob.hpp"
 
+#include <ostream>
+
 namespace oos {
 
 blob::blob()
 {}
 
+blob::blob(const char *data, size_type size)
+  : data_(data, data + size)
+{}
+
 blob::~blob()
 {
 }
 
+bool blob::assign(const char *data, size_type size)
+{
+  if (size > data_.max_size()) {
+    return false;
+  }
+  data_.assign(data, data + size);
+  return true;
+}
+
+bool blob::append(const char *data, size_type size)
+{
+  if (size > data_.max_size() - data_.size()) {
+    return false;
+  }
+  data_.insert(data_.end(), data, data + size);
+  return true;
+}
+
+void blob::clear()
+{
+  data_.clear();
+}
+
+void blob::resize(size_type size)
+{
+  data_.resize(size);
+}
+
+void blob::reserve(size_type size)
+{
+  data_.reserve(size);
+}
+
 blob::size_type blob::size() const
 {
   return data_.size();
@@ -19,9 +58,40 @@ blob::size_type blob::capacity() const
   return data_.capacity();
 }
 
+bool blob::empty() const
+{
+  return data_.empty();
+}
+
 const char* blob::data() const
 {
-  return &data_.front();
+  return data_.data();
+}
+
+char* blob::data()
+{
+  return data_.data();
+}
+
+bool blob::operator==(const blob &x) const
+{
+  return data_ == x.data_;
+}
+
+bool blob::operator!=(const blob &x) const
+{
+  return !operator==(x);
+}
+
+std::ostream& operator<<(std::ostream &out, const blob &x)
+{
+  static const char digits[] = "0123456789ABCDEF";
+  for (std::vector<char>::const_iterator i = x.data_.begin(); i != x.data_.end(); ++i) {
+    unsigned char c = static_cast<unsigned char>(*i);
+    out.put(digits[c >> 4]);
+    out.put(digits[c & 0x0f]);
+  }
+  return out;
 }
 
 }
@@ -65,3 +65,44 @@ seconds2time(unsigned int seconds, unsigned int &hour, unsigned int &minute, uns
   minute = (seconds - 3600 * hour) / 60;
   second = seconds - 3600 * hour - 60 * minute;
 }
+
+/*!
+  \internal
+  Converts a Gregorian date to the number of
+  days since 1970-01-01.
+  This algorithm is taken from Howard Hinnant,
+  chrono-Compatible Low-Level Date Algorithms.
+  \sa civil_from_days()
+*/
+
+int
+days_from_civil(int y, int m, int d) {
+  y -= m <= 2;
+  int era = (y >= 0 ? y : y - 399) / 400;
+  unsigned int yoe = (unsigned int)(y - era * 400);
+  unsigned int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  unsigned int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + (int)doe - 719468;
+}
+
+/*!
+  \internal
+  Converts the number of days since 1970-01-01
+  to a Gregorian date.
+  This algorithm is taken from Howard Hinnant,
+  chrono-Compatible Low-Level Date Algorithms.
+  \sa days_from_civil()
+*/
+
+void
+civil_from_days(int z, int &y, int &m, int &d) {
+  z += 719468;
+  int era = (z >= 0 ? z : z - 146096) / 146097;
+  unsigned int doe = (unsigned int)(z - era * 146097);
+  unsigned int yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+  unsigned int doy = doe - (365*yoe + yoe/4 - yoe/100);
+  unsigned int mp = (5*doy + 2)/153;
+  d = (int)(doy - (153*mp + 2)/5 + 1);
+  m = (int)(mp < 10 ? mp + 3 : mp - 9);
+  y = (int)yoe + era * 400 + (m <= 2);
+}
@@ -24,7 +24,7 @@ namespace oos {
 void
 convert(const varchar_base &from, std::string &to)
 {
-  to = from.str();
+  to.assign(from.data(), from.size());
 }
 
 void
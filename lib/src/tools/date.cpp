@@ -29,7 +29,10 @@ date::date()
 }
 
 date::date(int julian_date)
-  : julian_date_(julian_date)
+  : day_(0)
+  , month_(0)
+  , year_(0)
+  , julian_date_(julian_date)
 {
   sync_julian_date(julian_date);
 }
@@ -303,9 +306,16 @@ void date::sync_date(int d, int m, int y)
 
 void date::sync_julian_date(int juliandate)
 {
+  int d = day_ + juliandate - julian_date_;
+  if (month_ > 0 && d > 0 && d <= month_days[month_ - 1] + (month_ == 2 && is_leap_year_ ? 1 : 0)) {
+    // still in the current month
+    day_ = d;
+  } else {
+    // julian day 2440588 is 1970-01-01
+    civil_from_days(juliandate - 2440588, year_, month_, day_);
+    is_leap_year_ = is_leapyear(year_);
+  }
   julian_date_ = juliandate;
-  jd2gc(juliandate, day_, month_, year_);
-  is_leap_year_ = is_leapyear(year_);
   is_daylight_saving_ = is_daylight_saving(year_, month_, day_);
 }
 
@@ -55,6 +55,89 @@ long default_sequencer::update(long id)
   return number_;
 }
 
+namespace {
+
+/*
+ * the ids of one atomic sequencer
+ * cached by the current thread
+ */
+struct id_cache
+{
+  unsigned long owner;
+  unsigned long generation;
+  long next;
+  long last;
+};
+
+thread_local id_cache cache = { 0, 0, 1, 0 };
+
+std::atomic<unsigned long> instances(0);
+
+}
+
+atomic_sequencer::atomic_sequencer(long cache_size)
+  : id_(++instances)
+  , cache_size_(cache_size < 1 ? 1 : cache_size)
+  , number_(0)
+  , generation_(0)
+{}
+
+atomic_sequencer::~atomic_sequencer()
+{}
+
+long atomic_sequencer::init()
+{
+  return number_;
+}
+
+long atomic_sequencer::reset(long id)
+{
+  number_.store(id);
+  ++generation_;
+  return id;
+}
+
+long atomic_sequencer::next()
+{
+  if (cache_size_ == 1) {
+    return number_.fetch_add(1) + 1;
+  }
+  id_cache &c = cache;
+  unsigned long generation = generation_.load(std::memory_order_acquire);
+  if (c.owner != id_ || c.generation != generation || c.next > c.last) {
+    c.last = number_.fetch_add(cache_size_) + cache_size_;
+    c.next = c.last - cache_size_ + 1;
+    c.owner = id_;
+    c.generation = generation;
+  }
+  return c.next++;
+}
+
+long atomic_sequencer::current() const
+{
+  return number_;
+}
+
+long atomic_sequencer::update(long id)
+{
+  long current = number_.load(std::memory_order_relaxed);
+  while (id > current) {
+    if (number_.compare_exchange_weak(current, id)) {
+      return id;
+    }
+  }
+  if (cache_size_ > 1) {
+    // the id may lie in a cached range
+    ++generation_;
+  }
+  return current;
+}
+
+long atomic_sequencer::cache_size() const
+{
+  return cache_size_;
+}
+
 sequencer::sequencer(const sequencer_impl_ptr &impl)
   : impl_(impl)
 {
@@ -0,0 +1,90 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tools/shared_mutex.hpp"
+
+namespace oos {
+
+shared_mutex::shared_mutex()
+  : reader_count_(0)
+  , waiting_writers_(0)
+  , writer_(false)
+{}
+
+shared_mutex::~shared_mutex()
+{}
+
+void shared_mutex::lock()
+{
+  std::unique_lock<std::mutex> l(mutex_);
+  ++waiting_writers_;
+  writers_.wait(l, [this]() { return !writer_ && reader_count_ == 0; });
+  --waiting_writers_;
+  writer_ = true;
+}
+
+bool shared_mutex::try_lock()
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  if (writer_ || reader_count_ > 0) {
+    return false;
+  }
+  writer_ = true;
+  return true;
+}
+
+void shared_mutex::unlock()
+{
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    writer_ = false;
+  }
+  // a waiting writer goes first
+  writers_.notify_one();
+  readers_.notify_all();
+}
+
+void shared_mutex::lock_shared()
+{
+  std::unique_lock<std::mutex> l(mutex_);
+  readers_.wait(l, [this]() { return !writer_ && waiting_writers_ == 0; });
+  ++reader_count_;
+}
+
+bool shared_mutex::try_lock_shared()
+{
+  std::lock_guard<std::mutex> l(mutex_);
+  if (writer_ || waiting_writers_ > 0) {
+    return false;
+  }
+  ++reader_count_;
+  return true;
+}
+
+void shared_mutex::unlock_shared()
+{
+  bool last = false;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    last = --reader_count_ == 0;
+  }
+  if (last) {
+    writers_.notify_one();
+  }
+}
+
+}
@@ -7,6 +7,7 @@
 
 #include <stdexcept>
 #include <cstring>
+#include <ctime>
 
 namespace oos {
 
@@ -32,7 +33,180 @@ std::string trim(const std::string& str, const std::string& whitespace)
   return str.substr(first, range);
 }
 
-std::string to_string(const oos::time &x, const char *format)
+namespace {
+
+const char digit_pairs[] =
+  "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+  "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+struct time_fields
+{
+  int year;
+  int month;
+  int day;
+  int hour;
+  int minute;
+  int second;
+  long usec;
+  bool has_time;
+};
+
+/*
+ * writes the formatted fields into a caller
+ * buffer without allocating memory
+ */
+class fixed_formatter
+{
+public:
+  fixed_formatter(char *buffer, std::size_t size)
+    : first_(buffer), cur_(buffer), last_(buffer + size - 1)
+  {}
+
+  /*
+   * formats the common fixed tokens %Y, %m, %d,
+   * %H, %M, %S, %F, %T, %f, %3f and %6f.
+   * returns false on any other token.
+   */
+  bool write(const time_fields &f, const char *format)
+  {
+    while (*format) {
+      if (*format != '%') {
+        put(*format++);
+        continue;
+      }
+      ++format;
+      switch (*format++) {
+        case 'Y':
+          if (f.year < 0 || f.year > 9999) {
+            return false;
+          }
+          put_pair(f.year / 100);
+          put_pair(f.year % 100);
+          break;
+        case 'm':
+          put_pair(f.month);
+          break;
+        case 'd':
+          put_pair(f.day);
+          break;
+        case 'F':
+          if (!write(f, "%Y-%m-%d")) {
+            return false;
+          }
+          break;
+        case '%':
+          put('%');
+          break;
+        default:
+          if (!f.has_time || !write_time(f, format)) {
+            return false;
+          }
+          break;
+      }
+    }
+    *cur_ = '\0';
+    return true;
+  }
+
+  std::size_t size() const
+  {
+    return cur_ - first_;
+  }
+
+private:
+  bool write_time(const time_fields &f, const char *&format)
+  {
+    switch (format[-1]) {
+      case 'H':
+        put_pair(f.hour);
+        break;
+      case 'M':
+        put_pair(f.minute);
+        break;
+      case 'S':
+        put_pair(f.second);
+        break;
+      case 'T':
+        put_pair(f.hour);
+        put(':');
+        put_pair(f.minute);
+        put(':');
+        put_pair(f.second);
+        break;
+      case 'f':
+      case '3':
+        if (format[-1] == '3' && *format++ != 'f') {
+          return false;
+        }
+        put_digit(f.usec / 100000);
+        put_pair(f.usec / 1000 % 100);
+        break;
+      case '6':
+        if (*format++ != 'f') {
+          return false;
+        }
+        put_pair(f.usec / 10000);
+        put_pair(f.usec / 100 % 100);
+        put_pair(f.usec % 100);
+        break;
+      default:
+        return false;
+    }
+    return true;
+  }
+
+  void put(char c)
+  {
+    if (cur_ == last_) {
+      throw std::logic_error("buffer too small for time string");
+    }
+    *cur_++ = c;
+  }
+
+  void put_digit(long d)
+  {
+    put((char)('0' + d));
+  }
+
+  void put_pair(long v)
+  {
+    put(digit_pairs[v * 2]);
+    put(digit_pairs[v * 2 + 1]);
+  }
+
+private:
+  char *first_;
+  char *cur_;
+  char *last_;
+};
+
+time_fields fields_of(const oos::time &x)
+{
+  time_fields f;
+  f.year = x.year();
+  f.month = x.month();
+  f.day = x.day();
+  f.hour = x.hour();
+  f.minute = x.minute();
+  f.second = x.second();
+  f.usec = x.get_timeval().tv_usec;
+  f.has_time = true;
+  return f;
+}
+
+time_fields fields_of(const oos::date &x)
+{
+  time_fields f;
+  f.year = x.year();
+  f.month = x.month();
+  f.day = x.day();
+  f.hour = f.minute = f.second = 0;
+  f.usec = 0;
+  f.has_time = false;
+  return f;
+}
+
+std::string format_time(const oos::time &x, const char *format)
 {
   struct tm timeinfo = x.get_tm();
 
@@ -44,16 +218,19 @@ std::string to_string(const oos::time &x, const char *format)
   // check for %f
   auto pos = result.find("%f");
   if (pos != std::string::npos) {
-    std::string millis = std::to_string(x.milli_second());
+    char millis[4];
+    fixed_formatter formatter(millis, sizeof(millis));
+    formatter.write(fields_of(x), "%f");
     // replace %f with millis
     result.replace(pos, 2, millis);
   }
   return result;
 }
 
-std::string to_string(const oos::date &x, const char *format)
+std::string format_date(const oos::date &x, const char *format)
 {
   struct tm timeinfo;
+  memset(&timeinfo, 0, sizeof(timeinfo));
   timeinfo.tm_mon = x.month() - 1;
   timeinfo.tm_year = x.year() - 1900;
   timeinfo.tm_mday = x.day();
@@ -65,4 +242,43 @@ std::string to_string(const oos::date &x, const char *format)
   return buffer;
 }
 
+template < class T >
+std::size_t format_into(const T &x, char *buffer, std::size_t size, const char *format, std::string (*fallback)(const T&, const char*))
+{
+  fixed_formatter formatter(buffer, size);
+  if (formatter.write(fields_of(x), format)) {
+    return formatter.size();
+  }
+  std::string result = fallback(x, format);
+  if (result.size() >= size) {
+    throw std::logic_error("buffer too small for time string");
+  }
+  std::memcpy(buffer, result.c_str(), result.size() + 1);
+  return result.size();
+}
+
+}
+
+std::string to_string(const oos::time &x, const char *format)
+{
+  char buffer[255];
+  return std::string(buffer, to_string(x, buffer, sizeof(buffer), format));
+}
+
+std::string to_string(const oos::date &x, const char *format)
+{
+  char buffer[80];
+  return std::string(buffer, to_string(x, buffer, sizeof(buffer), format));
+}
+
+std::size_t to_string(const oos::time &x, char *buffer, std::size_t size, const char *format)
+{
+  return format_into(x, buffer, size, format, format_time);
+}
+
+std::size_t to_string(const oos::date &x, char *buffer, std::size_t size, const char *format)
+{
+  return format_into(x, buffer, size, format, format_date);
+}
+
 }
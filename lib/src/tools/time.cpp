@@ -1,8 +1,10 @@
 #include "tools/time.hpp"
+#include "tools/calendar.h"
 
 #include <stdexcept>
 #include <cstring>
 #include <cmath>
+#include <climits>
 #include <vector>
 
 #include <sys/time.h>
@@ -11,6 +13,177 @@ namespace oos {
 
 //const char *time::default_format = "%FT%T.SSSSS%z";
 
+namespace {
+
+/*
+ * The timezone offset of a utc hour. The offsets
+ * of recently used hours are cached to avoid the
+ * costly libc localtime on every conversion.
+ * Changes of the TZ environment variable at
+ * runtime aren't noticed by the cache.
+ */
+struct zone_info
+{
+  long long hour;
+  long gmtoff;
+  int isdst;
+  decltype(tm::tm_zone) zone;
+};
+
+enum { ZONE_CACHE_SIZE = 64 };
+
+long long floor_div(long long a, long long b)
+{
+  return a / b - (a % b < 0 ? 1 : 0);
+}
+
+const zone_info& zone_at(time_t t)
+{
+  static thread_local zone_info cache[ZONE_CACHE_SIZE] = {};
+  static thread_local bool initialized = false;
+  if (!initialized) {
+    for (zone_info &z : cache) {
+      z.hour = LLONG_MIN;
+    }
+    initialized = true;
+  }
+  long long hour = floor_div(t, 3600);
+  zone_info &z = cache[(unsigned long long)hour % ZONE_CACHE_SIZE];
+  if (z.hour != hour) {
+    struct tm l;
+    localtime_r(&t, &l);
+    z.hour = hour;
+    z.gmtoff = l.tm_gmtoff;
+    z.isdst = l.tm_isdst;
+    z.zone = l.tm_zone;
+  }
+  return z;
+}
+
+/*
+ * same as localtime_r but the calendar
+ * fields are computed without libc
+ */
+void to_local_tm(time_t t, struct tm &tm)
+{
+  const zone_info &z = zone_at(t);
+  long long local = (long long)t + z.gmtoff;
+  long long days = floor_div(local, 86400);
+  int secs = (int)(local - days * 86400);
+  int year, month, day;
+  civil_from_days((int)days, year, month, day);
+  tm.tm_year = year - 1900;
+  tm.tm_mon = month - 1;
+  tm.tm_mday = day;
+  tm.tm_hour = secs / 3600;
+  tm.tm_min = secs / 60 % 60;
+  tm.tm_sec = secs % 60;
+  // 1970-01-01 was a thursday
+  tm.tm_wday = (int)((days % 7 + 11) % 7);
+  tm.tm_yday = (int)days - days_from_civil(year, 1, 1);
+  tm.tm_isdst = z.isdst;
+  tm.tm_gmtoff = z.gmtoff;
+  tm.tm_zone = z.zone;
+}
+
+/*
+ * converts seconds of a local time
+ * since 1970-01-01 to utc
+ */
+time_t local_to_utc(long long local)
+{
+  time_t t = (time_t)(local - zone_at((time_t)local).gmtoff);
+  // the offset may change between local and utc time
+  return (time_t)(local - zone_at(t).gmtoff);
+}
+
+bool parse_number(const char *&str, int min_digits, int max_digits, int &value, int &digits)
+{
+  value = 0;
+  digits = 0;
+  while (digits < max_digits && *str >= '0' && *str <= '9') {
+    value = value * 10 + (*str++ - '0');
+    ++digits;
+  }
+  return digits >= min_digits;
+}
+
+/*
+ * parses the common fixed tokens %Y, %m, %d,
+ * %H, %M, %S, %F, %T and %f without strptime.
+ * returns false on any other token or if
+ * the string doesn't match the format.
+ */
+bool parse_tokens(const char *&str, const char *format, struct tm &tm, long &usec)
+{
+  int digits = 0;
+  while (*format) {
+    if (*format != '%') {
+      if (*str++ != *format++) {
+        return false;
+      }
+      continue;
+    }
+    ++format;
+    bool ok = true;
+    switch (*format++) {
+      case 'Y':
+        ok = parse_number(str, 4, 4, tm.tm_year, digits);
+        tm.tm_year -= 1900;
+        break;
+      case 'm':
+        ok = parse_number(str, 1, 2, tm.tm_mon, digits);
+        --tm.tm_mon;
+        break;
+      case 'd':
+        ok = parse_number(str, 1, 2, tm.tm_mday, digits);
+        break;
+      case 'H':
+        ok = parse_number(str, 1, 2, tm.tm_hour, digits);
+        break;
+      case 'M':
+        ok = parse_number(str, 1, 2, tm.tm_min, digits);
+        break;
+      case 'S':
+        ok = parse_number(str, 1, 2, tm.tm_sec, digits);
+        break;
+      case 'F':
+        ok = parse_tokens(str, "%Y-%m-%d", tm, usec);
+        break;
+      case 'T':
+        ok = parse_tokens(str, "%H:%M:%S", tm, usec);
+        break;
+      case '3':
+      case '6':
+        if (*format++ != 'f') {
+          return false;
+        }
+        // fall through
+      case 'f':
+        {
+          int fraction = 0;
+          ok = parse_number(str, 1, 6, fraction, digits);
+          static const long scale[] = { 1, 100000, 10000, 1000, 100, 10, 1 };
+          usec = fraction * scale[digits];
+        }
+        break;
+      default:
+        return false;
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool parse_fast(const char *str, const char *format, struct tm &tm, long &usec)
+{
+  return parse_tokens(str, format, tm, usec) && *str == '\0';
+}
+
+}
+
 void throw_invalid_time(int h, int m, int s, long ms)
 {
   if (!time::is_valid_time(h, m, s, ms)) {
@@ -23,7 +196,7 @@ time::time()
   if (gettimeofday(&time_, 0) != 0) {
     throw std::logic_error("couldn' get time of day");
   }
-  localtime_r(&time_.tv_sec, &tm_);
+  to_local_tm(time_.tv_sec, tm_);
 }
 
 time::time(time_t t)
@@ -133,35 +306,45 @@ bool time::is_valid_time(int hour, int min, int sec, long millis) {
 
 time time::parse(const std::string &tstr, const char *format)
 {
-  /*
-  * find the %f format token
-  * and split the string to parse
-  */
-  const char *pch = strstr(format, "%f");
+  return parse(tstr.c_str(), format);
+}
 
-  std::string part(format, (pch ? pch-format : strlen(format)));
+time time::parse(const char *tstr, const char *format)
+{
   struct tm tm;
   memset(&tm, 0, sizeof(struct tm));
-  const char *endptr = strptime(tstr.c_str(), part.c_str(), &tm);
-  unsigned long usec = 0;
-  if (endptr == nullptr && pch != nullptr) {
-    // parse error
-    throw std::logic_error("error parsing time");
-  } else if (pch != nullptr) {
-    char *next;
-    usec = std::strtoul(endptr, &next, 10);
-    // calculate precision
-    unsigned digits = next - endptr;
-    usec *= (unsigned long)pow(10.0, 6 - digits);
-    if ((size_t)(next - format) != strlen(format)) {
-      // still time string to parse
-      strptime(next, pch+2, &tm);
+  long usec = 0;
+  if (!parse_fast(tstr, format, tm, usec)) {
+    /*
+    * find the %f format token
+    * and split the string to parse
+    */
+    memset(&tm, 0, sizeof(struct tm));
+    usec = 0;
+    const char *pch = strstr(format, "%f");
+
+    std::string part(format, (pch ? pch-format : strlen(format)));
+    const char *endptr = strptime(tstr, part.c_str(), &tm);
+    if (endptr == nullptr && pch != nullptr) {
+      // parse error
+      throw std::logic_error("error parsing time");
+    } else if (pch != nullptr) {
+      char *next;
+      usec = std::strtoul(endptr, &next, 10);
+      // calculate precision
+      unsigned digits = next - endptr;
+      usec *= (unsigned long)pow(10.0, 6 - digits);
+      if ((size_t)(next - format) != strlen(format)) {
+        // still time string to parse
+        strptime(next, pch+2, &tm);
+      }
     }
   }
 
-  tm.tm_isdst = date::is_daylight_saving(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+  long long local = (long long)days_from_civil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday) * 86400
+                  + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
   struct timeval tv;
-  tv.tv_sec = mktime(&tm);
+  tv.tv_sec = local_to_utc(local);
   tv.tv_usec = usec;
   return oos::time(tv);
 }
@@ -192,7 +375,7 @@ void time::set(time_t t, long millis)
 {
   time_.tv_sec = t;
   time_.tv_usec = millis * 1000;
-  localtime_r(&time_.tv_sec, &tm_);
+  to_local_tm(time_.tv_sec, tm_);
 }
 
 void time::set(const date &d)
@@ -203,7 +386,7 @@ void time::set(const date &d)
 void time::set(timeval tv)
 {
   time_ = tv;
-  localtime_r(&time_.tv_sec, &tm_);
+  to_local_tm(time_.tv_sec, tm_);
 }
 
 int time::year() const
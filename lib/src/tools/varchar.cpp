@@ -1,46 +1,66 @@
 #include "tools/varchar.hpp"
 
 #include <algorithm>
+#include <ostream>
 
 namespace oos {
 
 varchar_base::varchar_base(size_type capacity)
   : capacity_(capacity)
+  , size_(0)
+  , data_(new char[capacity + 1])
+  , owner_(true)
+{
+  data_[0] = '\0';
+}
+
+varchar_base::varchar_base(char *buffer, size_type capacity)
+  : capacity_(capacity)
+  , size_(0)
+  , data_(buffer)
+  , owner_(false)
 {}
 
 varchar_base::varchar_base(const varchar_base &x)
   : capacity_(x.capacity_)
-  , data_(x.data_)
-{}
+  , size_(0)
+  , data_(new char[x.capacity_ + 1])
+  , owner_(true)
+{
+  assign(x.data_, x.size_);
+}
 
 varchar_base& varchar_base::operator=(const varchar_base &x)
 {
-  capacity_ = x.capacity_;
-  data_ = x.data_;
+  if (this != &x) {
+    assign(x.data_, x.size_);
+  }
   return *this;
 }
 
 varchar_base& varchar_base::operator=(const std::string &x)
 {
-  data_ = x;
-  trim();
+  assign(x.data(), x.size());
   return *this;
 }
 
 varchar_base& varchar_base::operator=(const char *x)
 {
 //  ok(x);
-  data_.assign(x);
-  trim();
+  assign(x);
   return *this;
 }
 
 varchar_base::~varchar_base()
-{}
+{
+  if (owner_) {
+    delete [] data_;
+  }
+}
 
 bool varchar_base::operator==(const varchar_base &x) const
 {
-  return data_ == x.data_;
+  return size_ == x.size_ && std::equal(data_, data_ + size_, x.data_);
 }
 
 bool varchar_base::operator!=(const varchar_base &x) const
@@ -50,49 +70,66 @@ bool varchar_base::operator!=(const varchar_base &x) const
 
 varchar_base& varchar_base::operator+=(const varchar_base &x)
 {
-  data_ += x.str();
-  trim();
+  append(x.data_, x.size_);
   return *this;
 }
 
 varchar_base& varchar_base::operator+=(const std::string &x)
 {
-  data_ += x;
-  trim();
+  append(x.data(), x.size());
   return *this;
 }
 
 varchar_base& varchar_base::operator+=(const char *x)
 {
-  data_ += x;
-  trim();
+  append(x, std::strlen(x));
   return *this;
 }
 
 void varchar_base::assign(const char *s, size_t n)
 {
-  data_.assign(s, n);
-  trim();
+  size_ = 0;
+  append(s, n);
 }
 
 void varchar_base::assign(const char *s)
 {
-  data_.assign(s);
+  assign(s, std::strlen(s));
+}
+
+void varchar_base::append(const char *s, size_t n)
+{
+  n = std::min(n, capacity_ - size_);
+  // the source may overlap with the own data
+  std::memmove(data_ + size_, s, n);
+  size_ += n;
+  data_[size_] = '\0';
+}
+
+void varchar_base::clear()
+{
+  size_ = 0;
+  data_[0] = '\0';
 }
 
 std::string varchar_base::str() const
 {
-  return data_;
+  return std::string(data_, size_);
 }
 
 const char* varchar_base::c_str() const
 {
-  return data_.c_str();
+  return data_;
+}
+
+const char* varchar_base::data() const
+{
+  return data_;
 }
 
 varchar_base::size_type varchar_base::size() const
 {
-  return data_.size();
+  return size_;
 }
 
 varchar_base::size_type varchar_base::capacity() const
@@ -100,9 +137,14 @@ varchar_base::size_type varchar_base::capacity() const
   return capacity_;
 }
 
+bool varchar_base::empty() const
+{
+  return size_ == 0;
+}
+
 std::ostream& operator<<(std::ostream &out, const varchar_base &val)
 {
-  out << val.str();
+  out.write(val.data_, val.size_);
   return out;
 }
 
@@ -113,9 +155,4 @@ void varchar_base::ok(const std::string &x)
   }
 }
 
-void varchar_base::trim()
-{
-  data_.resize(std::min(capacity_, data_.size()));
-}
-
 }
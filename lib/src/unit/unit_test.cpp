@@ -46,6 +46,11 @@ std::string unit_test::caption() const
   return caption_;
 }
 
+std::string unit_test::current_test() const
+{
+  return current_test_func_info ? current_test_func_info->name : std::string();
+}
+
 bool unit_test::execute()
 {
   // execute each test
@@ -125,10 +130,10 @@ void unit_test::info(const std::string &msg)
 
 void unit_test::execute(test_func_info &test_info)
 {
+    current_test_func_info = &test_info;
     initialize();
     std::cout << std::left << std::setw(70) << test_info.caption << " ... " << std::flush;
     try {
-      current_test_func_info = &test_info;
       test_info.func();
     } catch (unit_exception &ex) {
       test_info.succeeded = false;
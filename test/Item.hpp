@@ -25,6 +25,7 @@
 #include "object/linked_object_list.hpp"
 
 #include "tools/varchar.hpp"
+#include "tools/blob.hpp"
 
 class Item : public oos::object
 {
@@ -158,7 +159,7 @@ public:
   bool get_bool() const { return bool_; }
   const char* get_cstr() const { return cstr_; }
   std::string get_string() const { return string_; }
-  oos::varchar_base get_varchar() const { return varchar_; }
+  oos::varchar<64> get_varchar() const { return varchar_; }
   oos::date get_date() const { return date_; }
   oos::time get_time() const { return time_; }
 
@@ -367,6 +368,21 @@ public:
   {
     return item_list_.erase(i);
   }
+
+  void splice(iterator pos, LinkedList &other)
+  {
+    item_list_.splice(pos, other.item_list_);
+  }
+
+  void splice(iterator pos, LinkedList &other, iterator first, iterator last)
+  {
+    item_list_.splice(pos, other.item_list_, first, last);
+  }
+
+  void sort() { item_list_.sort(); }
+
+  void reverse() { item_list_.reverse(); }
+
 private:
   item_list_t item_list_;
   std::string relation_name_;
@@ -427,6 +443,24 @@ public:
     vector_.push_back(i);
   }
 
+  template < class ForwardIterator >
+  iterator insert(iterator pos, ForwardIterator first, ForwardIterator last)
+  {
+    return vector_.insert(pos, first, last);
+  }
+
+  template < class ForwardIterator >
+  void assign(ForwardIterator first, ForwardIterator last)
+  {
+    vector_.assign(first, last);
+  }
+
+  void reserve(size_type n) { vector_.reserve(n); }
+  size_type capacity() const { return vector_.capacity(); }
+
+  template < class OutputIterator >
+  OutputIterator ids(OutputIterator out) const { return vector_.ids(out); }
+
   iterator begin() { return vector_.begin(); }
   const_iterator begin() const { return vector_.begin(); }
 
@@ -511,6 +545,38 @@ public:
   std::string author() const { return author_; }
 };
 
+class attachment : public oos::object
+{
+private:
+  std::string name_;
+  oos::blob data_;
+
+public:
+  attachment() {}
+  attachment(const std::string &name, const oos::blob &data)
+    : name_(name)
+    , data_(data)
+  {}
+  virtual ~attachment() {}
+
+  virtual void deserialize(oos::object_reader &deserializer)
+  {
+    oos::object::deserialize(deserializer);
+    deserializer.read("name", name_);
+    deserializer.read("data", data_);
+  }
+  virtual void serialize(oos::object_writer &serializer) const
+  {
+    oos::object::serialize(serializer);
+    serializer.write("name", name_);
+    serializer.write("data", data_);
+  }
+
+  std::string name() const { return name_; }
+  const oos::blob& data() const { return data_; }
+  void data(const oos::blob &x) { modify(data_, x); }
+};
+
 class book_list : public oos::object
 {
 public:
@@ -768,6 +834,12 @@ public:
     return tracks_.insert(pos, b);
   }
 
+  template < class ForwardIterator >
+  iterator insert(iterator pos, ForwardIterator first, ForwardIterator last)
+  {
+    return tracks_.insert(pos, first, last);
+  }
+
   iterator begin() { return tracks_.begin(); }
   const_iterator begin() const { return tracks_.begin(); }
 
@@ -0,0 +1,310 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ChangeStreamTestUnit.hpp"
+
+#include "../Item.hpp"
+
+#include "object/object_serializer.hpp"
+
+#include "database/session.hpp"
+#include "database/transaction.hpp"
+#include "database/change_stream.hpp"
+
+#include "tools/byte_buffer.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace oos;
+
+ChangeStreamTestUnit::ChangeStreamTestUnit()
+  : unit_test("change_stream", "change stream test unit")
+  , session_(0)
+{
+  add_test("publish", std::bind(&ChangeStreamTestUnit::test_publish, this), "publish the changes of committed transactions");
+  add_test("rollback", std::bind(&ChangeStreamTestUnit::test_rollback, this), "rolled back transactions aren't published");
+  add_test("cursors", std::bind(&ChangeStreamTestUnit::test_cursors, this), "independent cursors on one stream");
+  add_test("lost", std::bind(&ChangeStreamTestUnit::test_lost, this), "skip changes overwritten before they were read");
+  add_test("image", std::bind(&ChangeStreamTestUnit::test_image, this), "restore an object from its after-image");
+  add_test("concurrent", std::bind(&ChangeStreamTestUnit::test_concurrent, this), "read the stream while transactions commit");
+  add_test("async", std::bind(&ChangeStreamTestUnit::test_async, this), "publish asynchronous commits once they are written");
+}
+
+ChangeStreamTestUnit::~ChangeStreamTestUnit()
+{}
+
+void ChangeStreamTestUnit::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+
+  session_ = new session(ostore_);
+  session_->open();
+}
+
+void ChangeStreamTestUnit::finalize()
+{
+  session_->close();
+
+  delete session_;
+  session_ = 0;
+
+  ostore_.clear(true);
+}
+
+void ChangeStreamTestUnit::test_publish()
+{
+  typedef object_ptr<Item> item_ptr;
+
+  change_stream stream;
+  session_->attach(stream);
+
+  change_stream::cursor c = stream.subscribe();
+  change_stream::change ch;
+
+  UNIT_ASSERT_FALSE(c.next(ch), "stream must be empty");
+
+  transaction tr(*session_);
+  tr.begin();
+  item_ptr first = ostore_.insert(new Item("first", 1));
+  item_ptr second = ostore_.insert(new Item("second", 2));
+  tr.commit();
+
+  tr.begin();
+  first->set_int(10);
+  tr.commit();
+
+  unsigned long id = second->id();
+  session_->remove(second);
+
+  UNIT_ASSERT_TRUE(c.next(ch), "insert must be published");
+  UNIT_ASSERT_EQUAL(ch.operation, change_stream::op_insert, "operation must be insert");
+  UNIT_ASSERT_EQUAL(ch.type, "item", "invalid type");
+  UNIT_ASSERT_EQUAL(ch.id, first->id(), "invalid id");
+  UNIT_ASSERT_TRUE(ch.image.empty(), "there must be no image");
+
+  UNIT_ASSERT_TRUE(c.next(ch), "insert must be published");
+  UNIT_ASSERT_EQUAL(ch.id, id, "invalid id");
+
+  UNIT_ASSERT_TRUE(c.next(ch), "update must be published");
+  UNIT_ASSERT_EQUAL(ch.operation, change_stream::op_update, "operation must be update");
+  UNIT_ASSERT_EQUAL(ch.id, first->id(), "invalid id");
+
+  UNIT_ASSERT_TRUE(c.next(ch), "delete must be published");
+  UNIT_ASSERT_EQUAL(ch.operation, change_stream::op_delete, "operation must be delete");
+  UNIT_ASSERT_EQUAL(ch.type, "item", "invalid type");
+  UNIT_ASSERT_EQUAL(ch.id, id, "invalid id");
+
+  UNIT_ASSERT_FALSE(c.next(ch), "stream must be read");
+  UNIT_ASSERT_EQUAL(c.position(), stream.head(), "cursor must be at head");
+
+  session_->detach(stream);
+  session_->insert(new Item("third", 3));
+
+  UNIT_ASSERT_FALSE(c.next(ch), "detached stream must not change");
+}
+
+void ChangeStreamTestUnit::test_rollback()
+{
+  change_stream stream;
+  session_->attach(stream);
+
+  transaction tr(*session_);
+  tr.begin();
+  ostore_.insert(new Item("item", 1));
+  tr.rollback();
+
+  UNIT_ASSERT_EQUAL(stream.head(), (std::uint64_t)0, "rolled back changes must not be published");
+
+  session_->detach(stream);
+}
+
+void ChangeStreamTestUnit::test_cursors()
+{
+  change_stream stream;
+  session_->attach(stream);
+
+  change_stream::cursor fast = stream.subscribe();
+  change_stream::cursor slow = stream.subscribe();
+  change_stream::change ch;
+
+  for (int i = 0; i < 5; ++i) {
+    session_->insert(new Item("item", i));
+    UNIT_ASSERT_TRUE(fast.next(ch), "change must be read");
+  }
+
+  // a late cursor sees only new changes
+  change_stream::cursor late = stream.subscribe();
+  UNIT_ASSERT_FALSE(late.next(ch), "late cursor must be empty");
+
+  int count = 0;
+  while (slow.next(ch)) {
+    UNIT_ASSERT_EQUAL(ch.sequence, (std::uint64_t)count + 1, "invalid sequence");
+    ++count;
+  }
+  UNIT_ASSERT_EQUAL(count, 5, "slow cursor must read all changes");
+  UNIT_ASSERT_EQUAL(fast.position(), slow.position(), "cursors must be at the same position");
+
+  session_->detach(stream);
+}
+
+void ChangeStreamTestUnit::test_lost()
+{
+  change_stream stream(4);
+  session_->attach(stream);
+
+  change_stream::cursor c = stream.subscribe();
+  change_stream::change ch;
+
+  for (int i = 0; i < 10; ++i) {
+    session_->insert(new Item("item", i));
+  }
+
+  int count = 0;
+  while (c.next(ch)) {
+    ++count;
+  }
+  UNIT_ASSERT_EQUAL(count, 4, "only the last changes are kept");
+  UNIT_ASSERT_EQUAL(c.lost(), (std::uint64_t)6, "invalid number of lost changes");
+  UNIT_ASSERT_EQUAL(ch.sequence, (std::uint64_t)10, "last change must be read");
+
+  session_->detach(stream);
+}
+
+void ChangeStreamTestUnit::test_image()
+{
+  change_stream stream(16, 1024);
+  session_->attach(stream);
+
+  change_stream::cursor c = stream.subscribe();
+  change_stream::change ch;
+
+  session_->insert(new Item("imaged", 4711));
+
+  UNIT_ASSERT_TRUE(c.next(ch), "insert must be published");
+  UNIT_ASSERT_FALSE(ch.image.empty(), "image must not be empty");
+
+  byte_buffer buffer;
+  buffer.append(ch.image.data(), ch.image.size());
+  Item item;
+  object_serializer serializer;
+  serializer.deserialize(&item, &buffer, nullptr);
+
+  UNIT_ASSERT_EQUAL(item.id(), ch.id, "invalid id");
+  UNIT_ASSERT_EQUAL(item.get_string(), "imaged", "invalid string");
+  UNIT_ASSERT_EQUAL(item.get_int(), 4711, "invalid int");
+
+  // images overwritten before reading are empty
+  for (int i = 0; i < 50; ++i) {
+    session_->insert(new Item("item", i));
+  }
+  int empty = 0;
+  while (c.next(ch)) {
+    if (ch.image.empty()) {
+      ++empty;
+    }
+  }
+  UNIT_ASSERT_GREATER(empty, 0, "overwritten images must be empty");
+
+  session_->detach(stream);
+}
+
+void ChangeStreamTestUnit::test_concurrent()
+{
+  const int count = 2000;
+
+  change_stream stream(64, 4096);
+  session_->attach(stream);
+
+  change_stream::cursor c = stream.subscribe();
+  std::atomic<bool> done(false);
+  std::atomic<int> errors(0);
+  std::uint64_t read = 0;
+
+  std::thread consumer([&]() {
+    change_stream::change ch;
+    std::uint64_t last = 0;
+    while (!done || c.position() < stream.head()) {
+      while (c.next(ch)) {
+        if (ch.sequence <= last || ch.operation != change_stream::op_insert || ch.type != "item") {
+          ++errors;
+        }
+        last = ch.sequence;
+        ++read;
+      }
+    }
+  });
+
+  for (int i = 0; i < count; ++i) {
+    session_->insert(new Item("item", i));
+  }
+  done = true;
+  consumer.join();
+
+  UNIT_ASSERT_EQUAL(errors.load(), 0, "changes must be read in order");
+  UNIT_ASSERT_EQUAL(read + c.lost(), (std::uint64_t)count, "every change must be read or lost");
+
+  session_->detach(stream);
+}
+
+void ChangeStreamTestUnit::test_async()
+{
+  typedef object_ptr<Item> item_ptr;
+
+  change_stream stream(16, 4096);
+  session_->attach(stream);
+  session_->enable_async_commit();
+
+  change_stream::cursor c = stream.subscribe();
+  change_stream::change ch;
+
+  transaction tr(*session_);
+  tr.begin();
+  item_ptr item = ostore_.insert(new Item("item", 1));
+  tr.commit();
+
+  tr.begin();
+  item->set_int(2);
+  tr.commit();
+
+  session_->flush();
+  session_->disable_async_commit();
+  session_->detach(stream);
+
+  unsigned long id = item->id();
+  // the stream owns the type names
+  ostore_.remove_prototype("item");
+
+  UNIT_ASSERT_TRUE(c.next(ch), "insert must be published");
+  UNIT_ASSERT_EQUAL(ch.operation, change_stream::op_insert, "operation must be insert");
+  UNIT_ASSERT_EQUAL(ch.type, "item", "invalid type");
+  UNIT_ASSERT_EQUAL(ch.id, id, "invalid id");
+
+  UNIT_ASSERT_TRUE(c.next(ch), "update must be published");
+  UNIT_ASSERT_EQUAL(ch.operation, change_stream::op_update, "operation must be update");
+  UNIT_ASSERT_EQUAL(ch.type, "item", "invalid type");
+
+  Item restored;
+  byte_buffer buffer;
+  buffer.append(ch.image.data(), ch.image.size());
+  object_serializer serializer;
+  serializer.deserialize(&restored, &buffer, nullptr);
+  UNIT_ASSERT_EQUAL(restored.get_int(), 2, "image must hold the written state");
+
+  UNIT_ASSERT_FALSE(c.next(ch), "stream must be read");
+}
@@ -0,0 +1,51 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANGE_STREAM_TEST_UNIT_HPP
+#define CHANGE_STREAM_TEST_UNIT_HPP
+
+#include "object/object_store.hpp"
+
+#include "unit/unit_test.hpp"
+
+namespace oos {
+class session;
+}
+
+class ChangeStreamTestUnit : public oos::unit_test
+{
+public:
+  ChangeStreamTestUnit();
+  virtual ~ChangeStreamTestUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void test_publish();
+  void test_rollback();
+  void test_cursors();
+  void test_lost();
+  void test_image();
+  void test_concurrent();
+  void test_async();
+
+private:
+  oos::object_store ostore_;
+  oos::session *session_;
+};
+
+#endif /* CHANGE_STREAM_TEST_UNIT_HPP */
@@ -0,0 +1,166 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConnectionPoolTestUnit.hpp"
+
+#include "../Item.hpp"
+
+#include "database/session.hpp"
+#include "database/connection_pool.hpp"
+#include "database/database.hpp"
+#include "database/statement.hpp"
+#include "database/result.hpp"
+#include "database/query.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace oos;
+
+namespace {
+
+long count_items(connection_pool::connection &conn)
+{
+  statement *stmt = conn.prepare("count_items", [](query &q) {
+    q.select().column("count(*)", type_long).from("item");
+  });
+  std::unique_ptr<result> res(stmt->execute());
+  long count = -1;
+  if (res->fetch()) {
+    res->get(0, count);
+  }
+  return count;
+}
+
+}
+
+ConnectionPoolTestUnit::ConnectionPoolTestUnit(const std::string &name, const std::string &msg, const std::string &db)
+  : unit_test(name, msg)
+  , db_(db)
+  , session_(0)
+{
+  add_test("acquire", std::bind(&ConnectionPoolTestUnit::test_acquire, this), "acquire and release pooled connections");
+  add_test("prepare", std::bind(&ConnectionPoolTestUnit::test_prepare, this), "reuse prepared statements of a connection");
+  add_test("concurrent", std::bind(&ConnectionPoolTestUnit::test_concurrent, this), "concurrent reads on pooled connections");
+}
+
+ConnectionPoolTestUnit::~ConnectionPoolTestUnit()
+{}
+
+void ConnectionPoolTestUnit::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+
+  session_ = new session(ostore_, db_);
+  session_->open();
+  session_->create();
+}
+
+void ConnectionPoolTestUnit::finalize()
+{
+  session_->drop();
+  session_->close();
+
+  delete session_;
+  session_ = 0;
+
+  ostore_.clear(true);
+}
+
+void ConnectionPoolTestUnit::test_acquire()
+{
+  connection_pool pool(*session_, 2);
+
+  UNIT_ASSERT_EQUAL((int)pool.size(), 2, "pool must have two connections");
+  UNIT_ASSERT_EQUAL((int)pool.available(), 2, "two connections must be available");
+
+  connection_pool::connection c1 = pool.acquire();
+  connection_pool::connection c2 = pool.acquire();
+
+  UNIT_ASSERT_TRUE((bool)c1, "connection must be valid");
+  UNIT_ASSERT_TRUE((bool)c2, "connection must be valid");
+  UNIT_ASSERT_TRUE(&c1.db() != &c2.db(), "connections must differ");
+  UNIT_ASSERT_TRUE(&c1.db() != &session_->db(), "connection must differ from session");
+  UNIT_ASSERT_EQUAL((int)pool.available(), 0, "no connection must be available");
+
+  connection_pool::connection c3 = pool.acquire(std::chrono::milliseconds(10));
+
+  UNIT_ASSERT_FALSE((bool)c3, "connection must be invalid");
+
+  c2.release();
+
+  UNIT_ASSERT_FALSE((bool)c2, "connection must be invalid");
+  UNIT_ASSERT_EQUAL((int)pool.available(), 1, "one connection must be available");
+
+  c3 = pool.acquire(std::chrono::milliseconds(10));
+
+  UNIT_ASSERT_TRUE((bool)c3, "connection must be valid");
+  UNIT_ASSERT_TRUE(c3.db().is_open(), "connection must be open");
+}
+
+void ConnectionPoolTestUnit::test_prepare()
+{
+  connection_pool pool(*session_, 1);
+
+  statement *stmt = 0;
+  {
+    connection_pool::connection conn = pool.acquire();
+
+    UNIT_ASSERT_EQUAL(count_items(conn), 0L, "table must be empty");
+
+    stmt = conn.prepare("count_items", [](query &) {});
+  }
+
+  // commits go through the owning session
+  session_->insert(new Item("item", 1));
+  session_->insert(new Item("item", 2));
+
+  connection_pool::connection conn = pool.acquire();
+
+  UNIT_ASSERT_TRUE(conn.prepare("count_items", [](query &) {}) == stmt, "statement must be reused");
+  UNIT_ASSERT_EQUAL(count_items(conn), 2L, "table must contain two items");
+}
+
+void ConnectionPoolTestUnit::test_concurrent()
+{
+  for (int i = 0; i < 50; ++i) {
+    session_->insert(new Item("item", i));
+  }
+
+  connection_pool pool(*session_, 4);
+
+  std::atomic<int> failures(0);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 8; ++i) {
+    readers.push_back(std::thread([&pool, &failures]() {
+      for (int j = 0; j < 25; ++j) {
+        connection_pool::connection conn = pool.acquire();
+        if (count_items(conn) != 50) {
+          ++failures;
+        }
+      }
+    }));
+  }
+  for (std::vector<std::thread>::iterator i = readers.begin(); i != readers.end(); ++i) {
+    i->join();
+  }
+
+  UNIT_ASSERT_EQUAL((int)failures, 0, "all readers must count 50 items");
+  UNIT_ASSERT_EQUAL((int)pool.available(), 4, "all connections must be released");
+}
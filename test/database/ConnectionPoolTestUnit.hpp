@@ -0,0 +1,48 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONNECTION_POOL_TEST_UNIT_HPP
+#define CONNECTION_POOL_TEST_UNIT_HPP
+
+#include "object/object_store.hpp"
+
+#include "unit/unit_test.hpp"
+
+namespace oos {
+class session;
+}
+
+class ConnectionPoolTestUnit : public oos::unit_test
+{
+public:
+  ConnectionPoolTestUnit(const std::string &name, const std::string &msg, const std::string &db);
+  virtual ~ConnectionPoolTestUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void test_acquire();
+  void test_prepare();
+  void test_concurrent();
+
+private:
+  oos::object_store ostore_;
+  std::string db_;
+  oos::session *session_;
+};
+
+#endif /* CONNECTION_POOL_TEST_UNIT_HPP */
@@ -23,8 +23,15 @@
 
 #include "database/session.hpp"
 #include "database/database_exception.hpp"
+#include "database/result.hpp"
+#include "database/statement_metrics.hpp"
+#include "database/slow_query_log.hpp"
+#include "database/database.hpp"
+#include "database/database_sequencer.hpp"
 
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 using namespace oos;
 using namespace std;
@@ -38,7 +45,16 @@ DatabaseTestUnit::DatabaseTestUnit(const std::string &name, const std::string &m
   add_test("datatypes", std::bind(&DatabaseTestUnit::test_datatypes, this), "test all supported datatypes");
   add_test("insert", std::bind(&DatabaseTestUnit::test_insert, this), "insert an item into the database");
   add_test("update", std::bind(&DatabaseTestUnit::test_update, this), "update an item on the database");
+  add_test("blob", std::bind(&DatabaseTestUnit::test_blob, this), "insert, update and reload a binary blob");
   add_test("delete", std::bind(&DatabaseTestUnit::test_delete, this), "delete an item from the database");
+  add_test("delete_batch", std::bind(&DatabaseTestUnit::test_delete_batch, this), "delete many items with batched statements");
+  add_test("update_batch", std::bind(&DatabaseTestUnit::test_update_batch, this), "update many items of one type inside a transaction");
+  add_test("metrics", std::bind(&DatabaseTestUnit::test_metrics, this), "collect statement metrics and latency histograms");
+  add_test("slow_query", std::bind(&DatabaseTestUnit::test_slow_query, this), "log slow statements with their query plan");
+  add_test("sequence_block", std::bind(&DatabaseTestUnit::test_sequence_block, this), "reserve blocks of ids shared by several sessions");
+  add_test("async_commit", std::bind(&DatabaseTestUnit::test_async_commit, this), "commit transactions in the background");
+  add_test("async_failure", std::bind(&DatabaseTestUnit::test_async_failure, this), "refuse commits after a background commit failed");
+  add_test("async_reinsert", std::bind(&DatabaseTestUnit::test_async_reinsert, this), "reinsert a removed object in the background");
   add_test("reload_simple", std::bind(&DatabaseTestUnit::test_reload_simple, this), "simple reload database test");
   add_test("reload", std::bind(&DatabaseTestUnit::test_reload, this), "reload database test");
   add_test("reload_container", std::bind(&DatabaseTestUnit::test_reload_container, this), "reload object list database test");
@@ -55,6 +71,7 @@ DatabaseTestUnit::initialize()
   ostore_.insert_prototype<ItemPtrList>("item_ptr_list");
   ostore_.insert_prototype<ItemPtrVector>("item_ptr_vector");
   ostore_.insert_prototype<album>("album");
+  ostore_.insert_prototype<attachment>("attachment");
   ostore_.insert_prototype<track>("track");
   
   // create session
@@ -229,6 +246,245 @@ void DatabaseTestUnit::test_update()
   UNIT_ASSERT_EQUAL("Mars", item->get_string(), "expected string must be 'Mars'");
 }
 
+void DatabaseTestUnit::test_blob()
+{
+  typedef object_ptr<attachment> attachment_ptr;
+  typedef object_view<attachment> oview_t;
+
+  // binary data with embedded null characters
+  // spanning more than one chunk
+  blob data;
+  for (int i = 0; i < 300000; ++i) {
+    data.append(i);
+  }
+
+  attachment_ptr a = session_->insert(new attachment("numbers", data));
+
+  UNIT_ASSERT_TRUE(a->id() > 0, "id must be greater zero");
+
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  oview_t oview(ostore_);
+
+  UNIT_ASSERT_FALSE(oview.empty(), "object view must not be empty");
+
+  a = oview.front();
+
+  UNIT_ASSERT_EQUAL(a->name(), "numbers", "name must be 'numbers'");
+  UNIT_ASSERT_EQUAL((long)a->data().size(), (long)data.size(), "blob sizes must be equal");
+  UNIT_ASSERT_TRUE(a->data() == data, "blobs must be equal");
+
+  // replace by an empty blob
+  a->data(blob());
+  session_->update(a);
+
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  a = oview.front();
+
+  UNIT_ASSERT_TRUE(a->data().empty(), "blob must be empty");
+
+  // a null byte in the middle of a short payload
+  const char payload[] = { 'a', 'b', '\0', 'c', 'd' };
+  blob short_data(payload, sizeof(payload));
+  a->data(short_data);
+  session_->update(a);
+
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  a = oview.front();
+
+  UNIT_ASSERT_EQUAL((long)a->data().size(), (long)sizeof(payload), "blob size must be five");
+  UNIT_ASSERT_TRUE(a->data() == short_data, "blobs must be equal");
+
+  if (db_.compare(0, 6, "sqlite") == 0) {
+    // the text result can't hold binary data
+    std::unique_ptr<result> res(session_->execute("SELECT data FROM attachment;"));
+    UNIT_ASSERT_TRUE(res->fetch(), "result must not be empty");
+    blob text_data;
+    UNIT_ASSERT_EXCEPTION(res->get(0, text_data), database_exception, "blob columns can only be read by a prepared statement", "blob must not be read from a text result");
+  }
+}
+
+void DatabaseTestUnit::test_async_commit()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> oview_t;
+
+  // a small queue forces the commits to wait
+  session_->enable_async_commit(4096);
+
+  UNIT_ASSERT_TRUE(session_->async_commit_enabled(), "async commit must be enabled");
+
+  std::vector<item_ptr> items;
+  commit_ticket ticket;
+  for (int i = 0; i < 100; ++i) {
+    transaction tr(*session_);
+    tr.begin();
+    items.push_back(ostore_.insert(new Item("item", i)));
+    ticket = tr.commit_async();
+  }
+
+  // modify after commit; the last state is written
+  transaction tr(*session_);
+  tr.begin();
+  for (int i = 0; i < 10; ++i) {
+    items[i]->set_int(1000 + i);
+  }
+  tr.commit();
+  items[0]->set_string("not committed");
+
+  tr.begin();
+  ostore_.remove(items.back());
+  items.pop_back();
+  ticket = tr.commit_async();
+
+  ticket.get();
+  session_->disable_async_commit();
+
+  UNIT_ASSERT_FALSE(session_->async_commit_enabled(), "async commit must be disabled");
+
+  items.clear();
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  oview_t oview(ostore_);
+
+  UNIT_ASSERT_EQUAL((int)oview.size(), 99, "invalid number of items");
+
+  int modified = 0;
+  for (oview_t::const_iterator i = oview.begin(); i != oview.end(); ++i) {
+    const item_ptr item = *i;
+    UNIT_ASSERT_EQUAL(item->get_string(), "item", "invalid item string");
+    if (item->get_int() >= 1000) {
+      ++modified;
+    }
+  }
+  UNIT_ASSERT_EQUAL(modified, 10, "invalid number of modified items");
+}
+
+void DatabaseTestUnit::test_async_failure()
+{
+  typedef object_ptr<Item> item_ptr;
+
+  // the queued inserts fail without the table
+  std::unique_ptr<result> res(session_->execute("DROP TABLE item"));
+  session_->enable_async_commit();
+
+  transaction tr(*session_);
+  tr.begin();
+  item_ptr item = ostore_.insert(new Item("item", 1));
+  tr.commit();
+
+  commit_ticket ticket = tr.ticket();
+  UNIT_ASSERT_TRUE(ticket.valid(), "ticket must be valid");
+  bool failed = false;
+  try {
+    ticket.get();
+  } catch (std::exception &) {
+    failed = true;
+  }
+  UNIT_ASSERT_TRUE(failed, "ticket must carry the error");
+  UNIT_ASSERT_TRUE(session_->async_commit_failed(), "session must be failed");
+
+  // further commits are refused until the error is taken
+  tr.begin();
+  item->set_int(2);
+  UNIT_ASSERT_EXCEPTION(tr.commit(), database_exception, "a queued transaction failed", "commit must be refused");
+  tr.rollback();
+  UNIT_ASSERT_EQUAL(item->get_int(), 1, "rolled back value must be restored");
+
+  failed = false;
+  try {
+    session_->flush();
+  } catch (std::exception &) {
+    failed = true;
+  }
+  UNIT_ASSERT_TRUE(failed, "flush must throw the error");
+  UNIT_ASSERT_FALSE(session_->async_commit_failed(), "error must be taken");
+
+  session_->db().create(*ostore_.find_prototype<Item>());
+
+  tr.begin();
+  ostore_.insert(new Item("item", 2));
+  tr.commit();
+  tr.ticket().get();
+
+  session_->disable_async_commit();
+}
+
+void DatabaseTestUnit::test_async_reinsert()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> oview_t;
+
+  unsigned long id = 0;
+  {
+    transaction tr(*session_);
+    tr.begin();
+    item_ptr item = ostore_.insert(new Item("item", 1));
+    tr.commit();
+    id = item->id();
+
+    session_->enable_async_commit();
+
+    // while the writer is busy with the first
+    // commit the following ones are queued and
+    // written as one group
+    tr.begin();
+    for (int i = 0; i < 100; ++i) {
+      ostore_.insert(new Item("filler", i));
+    }
+    tr.commit_async();
+
+    tr.begin();
+    item->set_int(2);
+    tr.commit_async();
+
+    tr.begin();
+    ostore_.remove(item);
+    tr.commit_async();
+
+    tr.begin();
+    Item *again = new Item("again", 3);
+    again->id(id);
+    item = ostore_.insert(again);
+    commit_ticket ticket = tr.commit_async();
+
+    ticket.get();
+    session_->disable_async_commit();
+  }
+
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  oview_t oview(ostore_);
+  UNIT_ASSERT_EQUAL(oview.size(), 101UL, "object view must contain 101 items");
+
+  int found = 0;
+  for (oview_t::const_iterator i = oview.begin(); i != oview.end(); ++i) {
+    if ((*i)->id() == id) {
+      UNIT_ASSERT_EQUAL((*i)->get_string(), std::string("again"), "item must be inserted again");
+      UNIT_ASSERT_EQUAL((*i)->get_int(), 3, "item must have its inserted value");
+      ++found;
+    }
+  }
+  UNIT_ASSERT_EQUAL(found, 1, "reinserted item must exist once");
+}
+
 void DatabaseTestUnit::test_delete()
 {
   typedef object_ptr<Item> item_ptr;
@@ -238,6 +494,8 @@ void DatabaseTestUnit::test_delete()
 
   UNIT_ASSERT_TRUE(item->id() > 0, "id must be greater zero");
 
+  session_->insert(new Item("second"));
+
   session_->close();
 
   UNIT_ASSERT_FALSE(session_->is_open(), "couldn't close database database");
@@ -250,15 +508,13 @@ void DatabaseTestUnit::test_delete()
   
   oview_t oview(ostore_);
 
-  try {
-    UNIT_ASSERT_TRUE(oview.begin() != oview.end(), "object view must not be empty");
-  } catch (object_exception &ex) {
-    // error, abort transaction
-    UNIT_WARN("caught object exception: " << ex.what());
-  }
+  UNIT_ASSERT_EQUAL(oview.size(), 2UL, "object view must contain two items");
 
+  // the prepared delete statement
+  // is executed twice
+  item = oview.front();
+  session_->remove(item);
   item = oview.front();
-
   session_->remove(item);
 
   try {
@@ -267,6 +523,350 @@ void DatabaseTestUnit::test_delete()
     // error, abort transaction
     UNIT_WARN("caught object exception: " << ex.what());
   }
+
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  UNIT_ASSERT_TRUE(oview.empty(), "object view must be empty after reload");
+}
+
+void DatabaseTestUnit::test_delete_batch()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> oview_t;
+
+  session_->enable_metrics();
+
+  transaction tr(*session_);
+  tr.begin();
+  std::vector<item_ptr> items;
+  for (int i = 0; i < 100; ++i) {
+    items.push_back(ostore_.insert(new Item("item", i)));
+  }
+  tr.commit();
+
+  // 87 ids are deleted by a batch of 64,
+  // one of 16, one of 4 and three single deletes
+  tr.begin();
+  for (int i = 0; i < 87; ++i) {
+    ostore_.remove(items[i]);
+  }
+  tr.commit();
+
+  const statement_metrics::entry *remove = session_->metrics()->find("item", "delete");
+  UNIT_ASSERT_NOT_NULL(remove, "delete metrics must exist");
+  UNIT_ASSERT_EQUAL(remove->calls, 6UL, "delete must be executed six times");
+  UNIT_ASSERT_EQUAL(remove->rows, 87UL, "delete must affect 87 rows");
+
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  oview_t oview(ostore_);
+  UNIT_ASSERT_EQUAL(oview.size(), 13UL, "object view must contain 13 items");
+  for (oview_t::iterator i = oview.begin(); i != oview.end(); ++i) {
+    UNIT_ASSERT_TRUE((*i)->get_int() >= 87, "only the last items must be left");
+  }
+}
+
+void DatabaseTestUnit::test_update_batch()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> oview_t;
+
+  transaction tr(*session_);
+  tr.begin();
+  std::vector<item_ptr> items;
+  for (int i = 0; i < 100; ++i) {
+    items.push_back(ostore_.insert(new Item("item", i)));
+  }
+  tr.commit();
+
+  session_->enable_metrics();
+
+  // the updates are executed at the end of the commit,
+  // 100 items are three batches of 32 and four single rows
+  tr.begin();
+  for (int i = 0; i < 100; ++i) {
+    items[i]->set_int(i + 1000);
+    std::stringstream str;
+    str << "updated " << i;
+    items[i]->set_string(str.str());
+  }
+  tr.commit();
+
+  const statement_metrics::entry *update = session_->metrics()->find("item", "update");
+  UNIT_ASSERT_NOT_NULL(update, "update metrics must exist");
+  UNIT_ASSERT_EQUAL(update->calls, 7UL, "update must be executed three times batched and four times single");
+  UNIT_ASSERT_EQUAL(update->rows, 100UL, "update must affect 100 rows");
+
+  // less than a batch is updated row by row
+  tr.begin();
+  for (int i = 0; i < 10; ++i) {
+    items[i]->set_int(i + 2000);
+    std::stringstream str;
+    str << "updated " << i + 1000;
+    items[i]->set_string(str.str());
+  }
+  tr.commit();
+
+  UNIT_ASSERT_EQUAL(update->calls, 17UL, "update must be executed ten times single");
+  UNIT_ASSERT_EQUAL(update->rows, 110UL, "update must affect 110 rows");
+
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  oview_t oview(ostore_);
+  UNIT_ASSERT_EQUAL(oview.size(), 100UL, "object view must contain 100 items");
+  for (oview_t::iterator i = oview.begin(); i != oview.end(); ++i) {
+    UNIT_ASSERT_TRUE((*i)->get_int() >= 1000, "item value must be updated");
+    // each row must get the values of its own object
+    std::stringstream str;
+    str << "updated " << (*i)->get_int() - 1000;
+    UNIT_ASSERT_EQUAL((*i)->get_string(), str.str(), "item must be updated");
+  }
+}
+
+void DatabaseTestUnit::test_metrics()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> oview_t;
+
+  latency_histogram histogram;
+  histogram.record(0);
+  histogram.record(100);
+  histogram.record(1000);
+  histogram.record(1000000);
+
+  UNIT_ASSERT_EQUAL(histogram.count(), 4UL, "histogram must contain four durations");
+  UNIT_ASSERT_EQUAL(histogram.bucket(0), 1UL, "zero must be counted in the first bucket");
+  UNIT_ASSERT_EQUAL(histogram.bucket(6), 1UL, "100ns must be counted in bucket [64, 128)");
+  UNIT_ASSERT_EQUAL(histogram.bucket(9), 1UL, "1us must be counted in bucket [512, 1024)");
+  UNIT_ASSERT_EQUAL(histogram.min(), 0ULL, "min must be zero");
+  UNIT_ASSERT_EQUAL(histogram.max(), 1000000ULL, "max must be 1ms");
+  UNIT_ASSERT_EQUAL(histogram.percentile(50), 128ULL, "median must be bound by 128ns");
+  UNIT_ASSERT_EQUAL(histogram.percentile(100), 1000000ULL, "p100 must be the max");
+
+  UNIT_ASSERT_NULL(session_->metrics(), "metrics must be disabled");
+
+  session_->enable_metrics();
+
+  UNIT_ASSERT_NOT_NULL(session_->metrics(), "metrics must be enabled");
+
+  transaction tr(*session_);
+  tr.begin();
+  item_ptr first = ostore_.insert(new Item("first", 1));
+  ostore_.insert(new Item("second", 2));
+  ostore_.insert(new Item("third", 3));
+  tr.commit();
+
+  session_->update(first);
+  session_->remove(first);
+
+  const statement_metrics *metrics = session_->metrics();
+  const statement_metrics::entry *insert = metrics->find("item", "insert");
+
+  UNIT_ASSERT_NOT_NULL(insert, "insert metrics must exist");
+  UNIT_ASSERT_EQUAL(insert->table, "item", "table must be item");
+  UNIT_ASSERT_EQUAL(insert->operation, "insert", "operation must be insert");
+  UNIT_ASSERT_EQUAL(insert->calls, 3UL, "insert must be called three times");
+  UNIT_ASSERT_EQUAL(insert->rows, 3UL, "insert must affect three rows");
+  UNIT_ASSERT_TRUE(insert->bytes_bound > 0, "insert must bind bytes");
+  UNIT_ASSERT_EQUAL(insert->phases[statement_metrics::BIND].count(), 3UL, "insert must be bound three times");
+  UNIT_ASSERT_EQUAL(insert->phases[statement_metrics::EXECUTE].count(), 3UL, "insert must be executed three times");
+
+  const statement_metrics::entry *update = metrics->find("item", "update");
+  UNIT_ASSERT_NOT_NULL(update, "update metrics must exist");
+  UNIT_ASSERT_EQUAL(update->calls, 1UL, "update must be called once");
+  UNIT_ASSERT_EQUAL(update->rows, 1UL, "update must affect one row");
+
+  const statement_metrics::entry *remove = metrics->find("item", "delete");
+  UNIT_ASSERT_NOT_NULL(remove, "delete metrics must exist");
+  UNIT_ASSERT_EQUAL(remove->calls, 1UL, "delete must be called once");
+  UNIT_ASSERT_EQUAL(remove->rows, 1UL, "delete must affect one row");
+
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  oview_t oview(ostore_);
+  UNIT_ASSERT_EQUAL(oview.size(), 2UL, "two items must be loaded");
+
+  const statement_metrics::entry *select = metrics->find("item", "select");
+  UNIT_ASSERT_NOT_NULL(select, "select metrics must exist");
+  UNIT_ASSERT_EQUAL(select->calls, 1UL, "select must be called once");
+  UNIT_ASSERT_EQUAL(select->rows, 2UL, "select must load two rows");
+  UNIT_ASSERT_EQUAL(select->phases[statement_metrics::PREPARE].count(), 1UL, "select must be prepared once");
+  UNIT_ASSERT_EQUAL(select->phases[statement_metrics::FETCH].count(), 3UL, "select must fetch two rows and the end");
+  UNIT_ASSERT_EQUAL(select->phases[statement_metrics::MATERIALIZE].count(), 2UL, "select must materialize two objects");
+
+  // ad-hoc queries are keyed by their sql
+  const std::string sql("SELECT id FROM item");
+  std::unique_ptr<result> res(session_->execute(sql));
+  const statement_metrics::entry *adhoc = metrics->find(sql);
+  UNIT_ASSERT_NOT_NULL(adhoc, "ad-hoc metrics must exist");
+  UNIT_ASSERT_EQUAL(adhoc->operation, "execute", "operation must be execute");
+  UNIT_ASSERT_EQUAL(adhoc->calls, 1UL, "query must be executed once");
+
+  session_->disable_metrics();
+
+  UNIT_ASSERT_NULL(session_->metrics(), "metrics must be disabled");
+}
+
+namespace {
+
+struct slow_query_counter : public slow_query_sink
+{
+  slow_query_counter() : count(0) {}
+  virtual void log(const slow_query &) { ++count; }
+  unsigned long count;
+};
+
+}
+
+void DatabaseTestUnit::test_slow_query()
+{
+  typedef object_ptr<Item> item_ptr;
+
+  UNIT_ASSERT_NULL(session_->slow_queries(), "slow query log must be disabled");
+
+  // nothing is slower than an hour
+  session_->enable_slow_query_log(std::chrono::hours(1));
+
+  slow_query_log *log = session_->slow_queries();
+  UNIT_ASSERT_NOT_NULL(log, "slow query log must be enabled");
+
+  item_ptr item = session_->insert(new Item("fast", 1));
+  UNIT_ASSERT_EQUAL(log->logged(), 0UL, "no statement must be logged");
+
+  // every statement is slow
+  session_->enable_slow_query_log(std::chrono::nanoseconds(0));
+  UNIT_ASSERT_EQUAL(session_->slow_queries(), log, "slow query log must be kept");
+  log->explain(true);
+
+  slow_query_counter counter;
+  log->sink(&counter);
+
+  item->set_int(42);
+  session_->update(item);
+
+  slow_query_log::t_query_vector queries = log->queries();
+  UNIT_ASSERT_FALSE(queries.empty(), "update must be logged");
+  const slow_query &update = queries.back();
+  UNIT_ASSERT_TRUE(update.sql.find("UPDATE") != std::string::npos, "sql must be the update statement");
+  UNIT_ASSERT_TRUE(update.parameters.find("val_int=42") != std::string::npos, "parameters must contain the new value");
+  UNIT_ASSERT_TRUE(update.parameters.find("val_string='fast'") != std::string::npos, "parameters must contain the string");
+  UNIT_ASSERT_EQUAL(update.rows, 1UL, "update must affect one row");
+  UNIT_ASSERT_EQUAL(counter.count, log->logged(), "sink must receive each statement");
+
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  // the select of the load is explained
+  queries = log->queries();
+  slow_query_log::t_query_vector::const_iterator select = queries.end();
+  for (slow_query_log::t_query_vector::const_iterator i = queries.begin(); i != queries.end(); ++i) {
+    if (i->sql.find("SELECT") == 0 && i->sql.find("item") != std::string::npos && i->rows == 1) {
+      select = i;
+    }
+  }
+  UNIT_ASSERT_TRUE(select != queries.end(), "select of item must be logged");
+  UNIT_ASSERT_FALSE(select->plan.empty(), "select must be explained");
+  std::string plan;
+  UNIT_ASSERT_TRUE(log->find_plan(select->sql, plan), "plan must be captured");
+  UNIT_ASSERT_EQUAL(plan, select->plan, "captured plan must be attached");
+
+  // the ring keeps the latest statements
+  session_->enable_slow_query_log(std::chrono::nanoseconds(0), 2);
+  log = session_->slow_queries();
+  log->clear();
+  std::unique_ptr<result> res(session_->execute("SELECT id FROM item WHERE id=1"));
+  res.reset(session_->execute("SELECT id FROM item WHERE id=2"));
+  res.reset(session_->execute("SELECT id FROM item WHERE id=3"));
+  UNIT_ASSERT_EQUAL(log->logged(), 3UL, "three statements must be logged");
+  UNIT_ASSERT_EQUAL(log->capacity(), 128UL, "running log must keep its capacity");
+
+  session_->disable_slow_query_log();
+  session_->enable_slow_query_log(std::chrono::nanoseconds(0), 2);
+  log = session_->slow_queries();
+  res.reset(session_->execute("SELECT id FROM item WHERE id=1"));
+  res.reset(session_->execute("SELECT id FROM item WHERE id=2"));
+  res.reset(session_->execute("SELECT id FROM item WHERE id=3"));
+  queries = log->queries();
+  UNIT_ASSERT_EQUAL(log->logged(), 3UL, "three statements must be logged");
+  UNIT_ASSERT_EQUAL(queries.size(), 2UL, "ring must keep two statements");
+  UNIT_ASSERT_EQUAL(queries.front().sql, "SELECT id FROM item WHERE id=2", "oldest kept statement must be the second");
+  UNIT_ASSERT_EQUAL(queries.back().sql, "SELECT id FROM item WHERE id=3", "latest statement must be the third");
+
+  session_->disable_slow_query_log();
+  UNIT_ASSERT_NULL(session_->slow_queries(), "slow query log must be disabled");
+}
+
+void DatabaseTestUnit::test_sequence_block()
+{
+  typedef object_ptr<Item> item_ptr;
+
+  session_->db().seq()->block_size(4);
+
+  transaction tr(*session_);
+  tr.begin();
+  for (int i = 1; i <= 6; ++i) {
+    item_ptr item = ostore_.insert(new Item("item", i));
+    UNIT_ASSERT_EQUAL(item->id(), (unsigned long)i, "ids of a session must be consecutive");
+  }
+  tr.commit();
+
+  // two blocks of four ids are reserved
+  UNIT_ASSERT_EQUAL(session_->db().seq()->limit(), 8L, "two blocks must be reserved");
+  std::unique_ptr<result> res(session_->execute("SELECT number FROM oos_sequence WHERE name='object'"));
+  UNIT_ASSERT_TRUE(res->fetch(), "sequence must be found");
+  long number = 0;
+  res->get(0, number);
+  UNIT_ASSERT_EQUAL(number, 8L, "sequence row must hold the last reserved id");
+  res.reset();
+
+  // a second session on the same database
+  // reserves a block behind the first one
+  {
+    object_store ostore;
+    ostore.insert_prototype<Item>("item");
+    session other(ostore, db_);
+    other.open();
+    other.load();
+    other.db().seq()->block_size(4);
+
+    transaction tr2(other);
+    tr2.begin();
+    item_ptr item = ostore.insert(new Item("other", 42));
+    tr2.commit();
+    UNIT_ASSERT_EQUAL(item->id(), 9UL, "second session must start behind the reserved block");
+
+    other.close();
+  }
+
+  tr.begin();
+  item_ptr item = ostore_.insert(new Item("seventh", 7));
+  UNIT_ASSERT_EQUAL(item->id(), 7UL, "first session must use its reserved block");
+  item = ostore_.insert(new Item("eighth", 8));
+  UNIT_ASSERT_EQUAL(item->id(), 8UL, "first session must use its reserved block");
+  item = ostore_.insert(new Item("ninth", 9));
+  UNIT_ASSERT_EQUAL(item->id(), 13UL, "first session must skip the block of the second session");
+  tr.commit();
+
+  res.reset(session_->execute("SELECT id FROM item"));
+  unsigned long count = 0;
+  while (res->fetch()) {
+    ++count;
+  }
+  UNIT_ASSERT_EQUAL(count, 10UL, "all items must be stored");
 }
 
 void
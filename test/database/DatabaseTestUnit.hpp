@@ -40,7 +40,16 @@ public:
   void test_datatypes();
   void test_insert();
   void test_update();
+  void test_blob();
+  void test_async_commit();
+  void test_async_failure();
+  void test_async_reinsert();
   void test_delete();
+  void test_delete_batch();
+  void test_update_batch();
+  void test_metrics();
+  void test_slow_query();
+  void test_sequence_block();
   void test_reload_simple();
   void test_reload();
   void test_reload_container();
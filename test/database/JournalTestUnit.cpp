@@ -0,0 +1,238 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "JournalTestUnit.hpp"
+
+#include "../Item.hpp"
+
+#include "object/object_view.hpp"
+
+#include "database/session.hpp"
+#include "database/transaction.hpp"
+#include "database/journal_database.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace oos;
+
+JournalTestUnit::JournalTestUnit()
+  : unit_test("journal", "journal database test unit")
+  , session_(0)
+{
+  add_test("replay", std::bind(&JournalTestUnit::test_replay, this), "replay inserts, updates and deletes from the journal");
+  add_test("list", std::bind(&JournalTestUnit::test_list, this), "replay an object list from the journal");
+  add_test("torn", std::bind(&JournalTestUnit::test_torn, this), "drop a torn frame at the end of the journal");
+  add_test("compact", std::bind(&JournalTestUnit::test_compact, this), "compact the journal into a snapshot");
+  add_test("async", std::bind(&JournalTestUnit::test_async, this), "write the journal with asynchronous commits");
+}
+
+JournalTestUnit::~JournalTestUnit()
+{}
+
+void JournalTestUnit::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+  ostore_.insert_prototype<ObjectItem<Item> >("object_item");
+  ostore_.insert_prototype<ItemPtrList>("item_ptr_list");
+
+  // each test writes its own journal
+  journal_ = name() + "_" + current_test() + ".journal";
+  session_ = new session(ostore_, "journal://" + journal_);
+  session_->open();
+  session_->create();
+}
+
+void JournalTestUnit::finalize()
+{
+  session_->drop();
+  session_->close();
+
+  delete session_;
+  session_ = 0;
+
+  ostore_.clear(true);
+}
+
+void JournalTestUnit::reopen()
+{
+  session_->close();
+  ostore_.clear();
+  session_->open();
+  session_->load();
+}
+
+void JournalTestUnit::test_replay()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_ptr<ObjectItem<Item> > object_item_ptr;
+  typedef object_view<Item> item_view_t;
+  typedef object_view<ObjectItem<Item> > object_item_view_t;
+
+  std::vector<item_ptr> items;
+  for (int i = 0; i < 10; ++i) {
+    items.push_back(session_->insert(new Item("item", i)));
+  }
+
+  ObjectItem<Item> *oi = new ObjectItem<Item>("object item", 42);
+  oi->ptr(items[3]);
+  session_->insert(oi);
+
+  transaction tr(*session_);
+  tr.begin();
+  items[0]->set_int(100);
+  tr.commit();
+
+  tr.begin();
+  items[1]->set_int(200);
+  tr.rollback();
+
+  session_->remove(items[9]);
+  items.clear();
+
+  reopen();
+
+  item_view_t iview(ostore_);
+  UNIT_ASSERT_EQUAL((int)iview.size(), 10, "invalid number of items");
+
+  int sum = 0;
+  for (item_view_t::const_iterator i = iview.begin(); i != iview.end(); ++i) {
+    if ((*i)->get_string() == "item") {
+      sum += (*i)->get_int();
+    }
+  }
+  // 100 + 1 + 2 + ... + 8
+  UNIT_ASSERT_EQUAL(sum, 136, "invalid item values");
+
+  object_item_view_t oview(ostore_);
+  UNIT_ASSERT_EQUAL((int)oview.size(), 1, "invalid number of object items");
+
+  object_item_ptr optr = oview.front();
+  UNIT_ASSERT_EQUAL(optr->get_int(), 42, "invalid object item value");
+  UNIT_ASSERT_TRUE(optr->ptr().is_loaded(), "item pointer must be resolved");
+  UNIT_ASSERT_EQUAL(optr->ptr()->get_int(), 3, "invalid pointed item");
+}
+
+void JournalTestUnit::test_list()
+{
+  typedef object_ptr<ItemPtrList> itemlist_ptr;
+  typedef object_view<ItemPtrList> itemlist_view_t;
+
+  transaction tr(*session_);
+  tr.begin();
+  itemlist_ptr itemlist = ostore_.insert(new ItemPtrList);
+  for (int i = 0; i < 3; ++i) {
+    itemlist->push_back(ostore_.insert(new Item("item", i)));
+  }
+  tr.commit();
+
+  reopen();
+
+  itemlist_view_t view(ostore_);
+  UNIT_ASSERT_EQUAL((int)view.size(), 1, "invalid number of lists");
+
+  itemlist = view.front();
+  UNIT_ASSERT_EQUAL((int)itemlist->size(), 3, "invalid list size");
+
+  int i = 0;
+  for (ItemPtrList::const_iterator j = itemlist->begin(); j != itemlist->end(); ++j, ++i) {
+    UNIT_ASSERT_EQUAL((*j)->value()->get_int(), i, "invalid list item");
+  }
+}
+
+void JournalTestUnit::test_torn()
+{
+  typedef object_view<Item> item_view_t;
+
+  for (int i = 0; i < 5; ++i) {
+    session_->insert(new Item("item", i));
+  }
+  session_->close();
+
+  // a partly written frame
+  std::FILE *file = std::fopen(journal_.c_str(), "ab");
+  const char torn[] = { 0x40, 0x00, 0x00, 0x00, 0x12, 0x34 };
+  std::fwrite(torn, 1, sizeof(torn), file);
+  std::fclose(file);
+
+  ostore_.clear();
+  session_->open();
+  session_->load();
+
+  item_view_t view(ostore_);
+  UNIT_ASSERT_EQUAL((int)view.size(), 5, "invalid number of items");
+
+  session_->insert(new Item("item", 5));
+
+  reopen();
+
+  UNIT_ASSERT_EQUAL((int)view.size(), 6, "invalid number of items");
+}
+
+void JournalTestUnit::test_compact()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> item_view_t;
+
+  std::vector<item_ptr> items;
+  for (int i = 0; i < 20; ++i) {
+    items.push_back(session_->insert(new Item("item", i)));
+  }
+  unsigned long last_id = items.back()->id();
+  session_->remove(items.back());
+  items.clear();
+
+  journal_database &journal = static_cast<journal_database&>(session_->db());
+
+  UNIT_ASSERT_TRUE(journal.journal_size() > 0, "journal must not be empty");
+
+  journal.compact();
+
+  UNIT_ASSERT_EQUAL(journal.journal_size(), 0L, "journal must be empty");
+
+  reopen();
+
+  item_view_t view(ostore_);
+  UNIT_ASSERT_EQUAL((int)view.size(), 19, "invalid number of items");
+
+  // ids of removed objects aren't reused
+  item_ptr item = session_->insert(new Item("item", 20));
+  UNIT_ASSERT_GREATER(item->id(), last_id, "id must be greater than the last id");
+
+  reopen();
+
+  UNIT_ASSERT_EQUAL((int)view.size(), 20, "invalid number of items");
+}
+
+void JournalTestUnit::test_async()
+{
+  typedef object_view<Item> item_view_t;
+
+  session_->enable_async_commit();
+  for (int i = 0; i < 50; ++i) {
+    transaction tr(*session_);
+    tr.begin();
+    ostore_.insert(new Item("item", i));
+    tr.commit();
+  }
+  session_->disable_async_commit();
+
+  reopen();
+
+  item_view_t view(ostore_);
+  UNIT_ASSERT_EQUAL((int)view.size(), 50, "invalid number of items");
+}
@@ -0,0 +1,55 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOURNAL_TEST_UNIT_HPP
+#define JOURNAL_TEST_UNIT_HPP
+
+#include "object/object_store.hpp"
+
+#include "unit/unit_test.hpp"
+
+#include <string>
+
+namespace oos {
+class session;
+}
+
+class JournalTestUnit : public oos::unit_test
+{
+public:
+  JournalTestUnit();
+  virtual ~JournalTestUnit();
+
+  virtual void initialize();
+  virtual void finalize();
+
+  void test_replay();
+  void test_list();
+  void test_torn();
+  void test_compact();
+  void test_async();
+
+private:
+  void reopen();
+
+private:
+  oos::object_store ostore_;
+  oos::session *session_;
+  std::string journal_;
+};
+
+#endif /* JOURNAL_TEST_UNIT_HPP */
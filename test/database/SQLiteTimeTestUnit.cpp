@@ -0,0 +1,139 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SQLiteTimeTestUnit.hpp"
+
+#include "../Item.hpp"
+
+#include "object/object_view.hpp"
+
+#include "database/session.hpp"
+#include "database/result.hpp"
+
+#include <memory>
+
+using namespace oos;
+
+SQLiteTimeTestUnit::SQLiteTimeTestUnit(const std::string &name, const std::string &msg, const std::string &db)
+  : unit_test(name, msg)
+  , db_(db)
+{
+  add_test("native", std::bind(&SQLiteTimeTestUnit::test_native, this), "store time and date natively");
+  add_test("migrate", std::bind(&SQLiteTimeTestUnit::test_migrate, this), "read text time in native mode");
+}
+
+SQLiteTimeTestUnit::~SQLiteTimeTestUnit()
+{}
+
+void SQLiteTimeTestUnit::initialize()
+{
+  ostore_.insert_prototype<Item>("item");
+}
+
+void SQLiteTimeTestUnit::finalize()
+{
+  ostore_.clear(true);
+}
+
+void SQLiteTimeTestUnit::test_native()
+{
+  oos::date date_val(15, 3, 2015);
+  oos::time time_val(2015, 3, 15, 13, 56, 23, 123);
+
+  session native(ostore_, db_ + "?time=native");
+  native.open();
+  native.create();
+
+  Item *i = new Item("item", 42);
+  i->set_date(date_val);
+  i->set_time(time_val);
+  native.insert(i);
+
+  std::unique_ptr<result> res(native.execute("SELECT typeof(val_date), typeof(val_time) FROM item;"));
+
+  UNIT_ASSERT_TRUE(res->fetch(), "result must not be empty");
+  UNIT_ASSERT_EQUAL(std::string(res->column(0)), "integer", "date must be stored as integer");
+  UNIT_ASSERT_EQUAL(std::string(res->column(1)), "integer", "time must be stored as integer");
+
+  native.close();
+  ostore_.clear();
+  native.open();
+  native.load();
+
+  object_view<Item> oview(ostore_);
+
+  UNIT_ASSERT_FALSE(oview.empty(), "object view must not be empty");
+  UNIT_ASSERT_EQUAL(oview.front()->get_date(), date_val, "date is not equal");
+  UNIT_ASSERT_EQUAL(oview.front()->get_time(), time_val, "time is not equal");
+
+  native.drop();
+  native.close();
+}
+
+void SQLiteTimeTestUnit::test_migrate()
+{
+  oos::time time_val(2015, 3, 15, 13, 56, 23, 123);
+  oos::time native_val(2016, 7, 4, 8, 12, 42, 999);
+
+  session text(ostore_, db_ + "?time=text");
+  text.open();
+  text.create();
+
+  Item *i = new Item("text", 1);
+  i->set_time(time_val);
+  text.insert(i);
+
+  text.close();
+  ostore_.clear();
+
+  // open the text database in native mode
+  session native(ostore_, db_ + "?time=native");
+  native.open();
+  native.load();
+
+  object_view<Item> oview(ostore_);
+
+  UNIT_ASSERT_EQUAL((int)oview.size(), 1, "object view must contain one item");
+  UNIT_ASSERT_EQUAL(oview.front()->get_time(), time_val, "text time is not equal");
+
+  i = new Item("native", 2);
+  i->set_time(native_val);
+  native.insert(i);
+
+  // the text column keeps text values
+  std::unique_ptr<result> res(native.execute("SELECT typeof(val_time) FROM item WHERE val_int=2;"));
+  UNIT_ASSERT_TRUE(res->fetch(), "result must not be empty");
+  UNIT_ASSERT_EQUAL(std::string(res->column(0)), "text", "time must be stored as text");
+  res.reset();
+
+  native.close();
+  ostore_.clear();
+  native.open();
+  native.load();
+
+  UNIT_ASSERT_EQUAL((int)oview.size(), 2, "object view must contain two items");
+  for (object_view<Item>::iterator j = oview.begin(); j != oview.end(); ++j) {
+    if ((*j)->get_int() == 1) {
+      UNIT_ASSERT_EQUAL((*j)->get_time(), time_val, "text time is not equal");
+    } else {
+      UNIT_ASSERT_EQUAL((*j)->get_time(), native_val, "native time is not equal");
+    }
+  }
+
+  native.drop();
+  native.close();
+}
@@ -5,8 +5,12 @@
 #include "object/object_view.hpp"
 
 #include "database/session.hpp"
+#include "database/action.hpp"
+#include "database/commit_planner.hpp"
 #include "database/database_exception.hpp"
 
+#include <vector>
+
 using namespace oos;
 
 
@@ -19,6 +23,8 @@ TransactionTestUnit::TransactionTestUnit(const std::string &name, const std::str
   add_test("complex", std::bind(&TransactionTestUnit::test_with_sub, this), "object with sub object database test");
   add_test("list", std::bind(&TransactionTestUnit::test_with_list, this), "object with object list database test");
   add_test("vector", std::bind(&TransactionTestUnit::test_with_vector, this), "object with object vector database test");
+  add_test("insert_delete", std::bind(&TransactionTestUnit::test_insert_delete, this), "delete inserted and updated objects inside a transaction");
+  add_test("planner", std::bind(&TransactionTestUnit::test_planner, this), "commit actions ordered by prototype and dependency");
 }
 
 
@@ -389,6 +395,177 @@ TransactionTestUnit::test_with_vector()
   session_->close();
 }
 
+void
+TransactionTestUnit::test_insert_delete()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> item_view;
+
+  session_->open();
+  session_->create();
+
+  item_view view(ostore_);
+
+  transaction tr(*session_);
+  tr.begin();
+  std::vector<item_ptr> kept;
+  for (int i = 0; i < 3; ++i) {
+    kept.push_back(ostore_.insert(new Item("kept", i)));
+  }
+  tr.commit();
+
+  // delete most of the inserted objects
+  // and an updated object before commit
+  tr.begin();
+  std::vector<item_ptr> inserted;
+  for (int i = 0; i < 10; ++i) {
+    inserted.push_back(ostore_.insert(new Item("inserted", i)));
+  }
+  kept[0]->set_int(99);
+  for (int i = 0; i < 10; i += 2) {
+    ostore_.remove(inserted[i]);
+  }
+  ostore_.remove(kept[0]);
+  tr.commit();
+
+  UNIT_ASSERT_EQUAL(view.size(), (size_t)7, "seven items must be left");
+
+  // the same inside a rolled back transaction
+  tr.begin();
+  inserted.clear();
+  for (int i = 0; i < 4; ++i) {
+    inserted.push_back(ostore_.insert(new Item("rolled back", i)));
+  }
+  ostore_.remove(inserted[1]);
+  ostore_.remove(inserted[3]);
+  kept[1]->set_int(42);
+  ostore_.remove(kept[1]);
+  UNIT_ASSERT_EQUAL(view.size(), (size_t)8, "eight items must be in the view");
+  tr.rollback();
+
+  UNIT_ASSERT_EQUAL(view.size(), (size_t)7, "seven items must be left");
+  for (item_view::iterator i = view.begin(); i != view.end(); ++i) {
+    UNIT_ASSERT_NOT_EQUAL((*i)->get_string(), std::string("rolled back"), "inserted items must be removed");
+    if ((*i)->get_string() == "kept") {
+      UNIT_ASSERT_TRUE((*i)->get_int() == 1 || (*i)->get_int() == 2, "kept items must be restored");
+    }
+  }
+
+  if (db_ != "memory") {
+    // the database holds the committed items
+    session_->close();
+    ostore_.clear();
+    session_->open();
+    session_->load();
+
+    UNIT_ASSERT_EQUAL(view.size(), (size_t)7, "seven items must be loaded");
+    int odd = 0;
+    for (item_view::iterator i = view.begin(); i != view.end(); ++i) {
+      if ((*i)->get_string() == "inserted") {
+        UNIT_ASSERT_EQUAL((*i)->get_int() % 2, 1, "only odd items must be stored");
+        ++odd;
+      } else {
+        UNIT_ASSERT_EQUAL((*i)->get_string(), "kept", "item must be kept");
+        UNIT_ASSERT_NOT_EQUAL((*i)->get_int(), 0, "deleted item must not be stored");
+      }
+    }
+    UNIT_ASSERT_EQUAL(odd, 5, "five inserted items must be stored");
+  }
+
+  session_->drop();
+  session_->close();
+}
+
+void
+TransactionTestUnit::test_planner()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef ObjectItem<Item> object_item_t;
+  typedef object_ptr<object_item_t> object_item_ptr;
+  typedef object_view<object_item_t> object_item_view;
+
+  session_->open();
+  session_->create();
+
+  transaction tr(*session_);
+  tr.begin();
+  item_ptr updated = ostore_.insert(new Item("updated", 1));
+  object_item_ptr removed = ostore_.insert(new object_item_t("removed", 2));
+  removed->ptr(ostore_.insert(new Item("removed", 3)));
+  tr.commit();
+
+  // modify object items and items interleaved
+  tr.begin();
+  std::vector<object_item_ptr> object_items;
+  for (int i = 0; i < 3; ++i) {
+    object_item_ptr oi = ostore_.insert(new object_item_t("object item", i));
+    oi->ptr(ostore_.insert(new Item("item", i)));
+    object_items.push_back(oi);
+  }
+  updated->set_int(7);
+  // removes the referred item as well
+  ostore_.remove(removed);
+  object_items[0]->set_int(42);
+
+  commit_planner planner(ostore_);
+  commit_planner::t_action_vector plan;
+  planner.plan(tr, plan);
+
+  UNIT_ASSERT_EQUAL(plan.size(), (size_t)5, "plan must hold five actions");
+  // items are inserted before the object items referring to them
+  insert_action *ia = dynamic_cast<insert_action*>(plan[0]);
+  UNIT_ASSERT_NOT_NULL(ia, "action must be an insert action");
+  UNIT_ASSERT_EQUAL(ia->type(), std::string("item"), "items must be inserted first");
+  // each object item inserted a default item as well
+  UNIT_ASSERT_EQUAL(ia->size(), (size_t)6, "six items must be inserted");
+  ia = dynamic_cast<insert_action*>(plan[1]);
+  UNIT_ASSERT_NOT_NULL(ia, "action must be an insert action");
+  UNIT_ASSERT_EQUAL(ia->type(), std::string("object_item"), "object items must be inserted last");
+  UNIT_ASSERT_EQUAL(ia->size(), (size_t)3, "three object items must be inserted");
+  // updates follow the inserts
+  UNIT_ASSERT_NOT_NULL(dynamic_cast<update_action*>(plan[2]), "action must be an update action");
+  // object items are deleted before the items they refer to
+  delete_action *da = dynamic_cast<delete_action*>(plan[3]);
+  UNIT_ASSERT_NOT_NULL(da, "action must be a delete action");
+  UNIT_ASSERT_EQUAL(std::string(da->classname()), std::string("object_item"), "object item must be deleted first");
+  da = dynamic_cast<delete_action*>(plan[4]);
+  UNIT_ASSERT_NOT_NULL(da, "action must be a delete action");
+  UNIT_ASSERT_EQUAL(std::string(da->classname()), std::string("item"), "item must be deleted last");
+
+  tr.commit();
+
+  if (db_ != "memory") {
+    session_->close();
+    ostore_.clear();
+    session_->open();
+    session_->load();
+
+    object_item_view view(ostore_);
+    UNIT_ASSERT_EQUAL(view.size(), (size_t)3, "three object items must be loaded");
+    for (object_item_view::iterator i = view.begin(); i != view.end(); ++i) {
+      UNIT_ASSERT_EQUAL((*i)->get_string(), std::string("object item"), "object item must be stored");
+      UNIT_ASSERT_NOT_NULL((*i)->ptr().get(), "object item must refer to an item");
+      UNIT_ASSERT_EQUAL((*i)->ptr()->get_string(), std::string("item"), "object item must refer to its item");
+    }
+  }
+
+  // dependencies are collected again once the prototypes changed
+  object_store store;
+  store.insert_prototype<Item>("item");
+  store.insert_prototype<object_item_t>("object_item");
+  commit_planner local_planner(store);
+  prototype_node *node = store.find_prototype("object_item").get();
+  UNIT_ASSERT_EQUAL(local_planner.dependencies(node).size(), (size_t)1, "object item must depend on item");
+  store.remove_prototype("item");
+  store.insert_prototype<Item>("item");
+  const commit_planner::t_node_vector &deps = local_planner.dependencies(node);
+  UNIT_ASSERT_EQUAL(deps.size(), (size_t)1, "object item must depend on item");
+  UNIT_ASSERT_EQUAL(deps.front()->index, store.find_prototype("item")->index, "dependency must be the new item prototype");
+
+  session_->drop();
+  session_->close();
+}
+
 session* TransactionTestUnit::create_session()
 {
   return new session(ostore_, db_);
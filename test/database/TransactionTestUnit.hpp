@@ -39,6 +39,8 @@ public:
   void test_with_sub();
   void test_with_list();
   void test_with_vector();
+  void test_insert_delete();
+  void test_planner();
 
 private:
   oos::session* create_session();
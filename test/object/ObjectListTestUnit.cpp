@@ -3,6 +3,7 @@
 #include "../Item.hpp"
 
 #include "object/object_view.hpp"
+#include "object/object_observer.hpp"
 
 #include <fstream>
 
@@ -18,6 +19,7 @@ ObjectListTestUnit::ObjectListTestUnit()
   add_test("linked_int", std::bind(&ObjectListTestUnit::test_linked_int_list, this), "test linked integer list");
   add_test("linked_ref", std::bind(&ObjectListTestUnit::test_linked_ref_list, this), "test linked object list with references");
   add_test("linked_ptr", std::bind(&ObjectListTestUnit::test_linked_ptr_list, this), "test linked object list with pointers");
+  add_test("linked_relink", std::bind(&ObjectListTestUnit::test_linked_relink, this), "test linked list splice, sort and reverse");
   add_test("direct_ref", std::bind(&ObjectListTestUnit::test_direct_ref_list, this), "test object list without relation table");
 }
 
@@ -40,6 +42,38 @@ ObjectListTestUnit::initialize()
   ostore_.insert_prototype<department>("department");
 }
 
+namespace {
+
+class update_counter : public object_observer
+{
+public:
+  update_counter() : updates(0) {}
+  virtual ~update_counter() {}
+
+  virtual void on_insert(object_proxy *) {}
+  virtual void on_update(object_proxy *proxy)
+  {
+    // count only the linked list items
+    if (dynamic_cast<LinkedIntList::item_type*>(proxy->obj)) {
+      ++updates;
+    }
+  }
+  virtual void on_delete(object_proxy *) {}
+
+  int updates;
+};
+
+std::vector<int> values(const object_ptr<LinkedIntList> &l)
+{
+  std::vector<int> result;
+  for (LinkedIntList::const_iterator i = l->begin(); i != l->end(); ++i) {
+    result.push_back(i->value());
+  }
+  return result;
+}
+
+}
+
 void
 ObjectListTestUnit::finalize()
 {
@@ -310,6 +344,81 @@ ObjectListTestUnit::test_linked_ptr_list()
   ostore_.remove(itemlist);
 }
 
+void
+ObjectListTestUnit::test_linked_relink()
+{
+  typedef object_ptr<LinkedIntList> intlist_ptr;
+
+  intlist_ptr first = ostore_.insert(new LinkedIntList);
+  intlist_ptr second = ostore_.insert(new LinkedIntList);
+
+  first->push_back(5);
+  first->push_back(8);
+  first->push_back(1);
+  second->push_back(7);
+  second->push_back(3);
+
+  unsigned long id_val = first->begin()->id();
+
+  // sort relinks the existing items
+  first->sort();
+
+  int sorted[] = { 1, 5, 8 };
+  UNIT_ASSERT_TRUE(values(first) == std::vector<int>(sorted, sorted + 3), "linked list isn't sorted");
+
+  LinkedIntList::iterator i = first->begin();
+  ++i;
+  UNIT_ASSERT_EQUAL(i->id(), id_val, "sorted item was recreated");
+
+  // reverse
+  first->reverse();
+
+  int reversed[] = { 8, 5, 1 };
+  UNIT_ASSERT_TRUE(values(first) == std::vector<int>(reversed, reversed + 3), "linked list isn't reversed");
+
+  // splice the second list in the middle
+  i = first->begin();
+  ++i;
+  first->splice(i, *second);
+
+  int spliced[] = { 8, 7, 3, 5, 1 };
+  UNIT_ASSERT_TRUE(values(first) == std::vector<int>(spliced, spliced + 5), "linked list isn't spliced");
+  UNIT_ASSERT_TRUE(second->empty(), "spliced linked list must be empty");
+  UNIT_ASSERT_EQUAL((int)first->size(), 5, "linked list size is invalid");
+
+  // splice range within the same list
+  i = first->begin();
+  ++i;
+  LinkedIntList::iterator j = i;
+  ++j;
+  ++j;
+  first->splice(first->end(), *first, i, j);
+
+  int moved[] = { 8, 5, 1, 7, 3 };
+  UNIT_ASSERT_TRUE(values(first) == std::vector<int>(moved, moved + 5), "linked list range isn't moved");
+
+  // only changed items are marked modified
+  update_counter counter;
+  ostore_.register_observer(&counter);
+
+  first->sort();
+  // all five items and both sentinels change their links
+  UNIT_ASSERT_EQUAL(counter.updates, 7, "sort must only mark relinked items");
+
+  counter.updates = 0;
+  first->sort();
+  UNIT_ASSERT_EQUAL(counter.updates, 0, "sort of sorted list must not mark any item");
+
+  ostore_.unregister_observer(&counter);
+
+  first->clear();
+  UNIT_ASSERT_TRUE(ostore_.is_removable(first), "couldn't remove linked item list");
+  UNIT_ASSERT_TRUE(ostore_.is_removable(second), "couldn't remove linked item list");
+
+  ostore_.remove(first);
+  ostore_.remove(second);
+}
+
 void ObjectListTestUnit::test_direct_ref_list()
 {
   typedef object_ptr<department> department_ptr;
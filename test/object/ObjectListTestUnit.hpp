@@ -20,6 +20,7 @@ public:
   void test_linked_int_list();
   void test_linked_ref_list();
   void test_linked_ptr_list();
+  void test_linked_relink();
   
   void test_direct_ref_list();
 
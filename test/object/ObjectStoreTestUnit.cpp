@@ -11,7 +11,10 @@
 
 #include "version.hpp"
 
+#include <atomic>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 using namespace oos;
 using namespace std;
@@ -39,6 +42,10 @@ ObjectStoreTestUnit::ObjectStoreTestUnit()
 //  add_test("structure", std::bind(&ObjectStoreTestUnit::test_structure, this), "object structure test");
   add_test("insert", std::bind(&ObjectStoreTestUnit::test_insert, this), "object insert test");
   add_test("remove", std::bind(&ObjectStoreTestUnit::test_remove, this), "object remove test");
+  add_test("directory", std::bind(&ObjectStoreTestUnit::test_directory, this), "prototype proxy directory test");
+  add_test("large_remove", std::bind(&ObjectStoreTestUnit::test_large_remove, this), "remove large and shared object trees test");
+  add_test("attribute_table", std::bind(&ObjectStoreTestUnit::test_attribute_table, this), "named attribute access table test");
+  add_test("concurrent", std::bind(&ObjectStoreTestUnit::test_concurrent, this), "concurrent readers and one writer test");
 }
 
 ObjectStoreTestUnit::~ObjectStoreTestUnit()
@@ -57,6 +64,7 @@ ObjectStoreTestUnit::initialize()
   ostore_.insert_prototype<Item>("ITEM");
   ostore_.insert_prototype<ObjectItem<Item> >("OBJECT_ITEM");
   ostore_.insert_prototype<ItemPtrList>("ITEM_PTR_LIST");
+  ostore_.insert_prototype<ItemRefList>("ITEM_REF_LIST");
   ostore_.insert_prototype<ObjectItemPtrList>("OBJECT_ITEM_PTR_LIST");
 }
 
@@ -713,3 +721,196 @@ void ObjectStoreTestUnit::test_remove()
 
   UNIT_ASSERT_EXCEPTION(ostore_.remove(item), object_exception, "object proxy is nullptr", "transient object shouldn't be removable");
 }
+
+void ObjectStoreTestUnit::test_directory()
+{
+  typedef object_ptr<Item> item_ptr;
+
+  prototype_iterator node = ostore_.find_prototype<Item>();
+
+  UNIT_ASSERT_TRUE(node->proxies.empty(), "proxy directory must be empty");
+
+  std::vector<item_ptr> items;
+  for (int i = 0; i < 10; ++i) {
+    items.push_back(ostore_.insert(new Item("item", i)));
+  }
+
+  UNIT_ASSERT_EQUAL(node->proxies.size(), (size_t)10, "proxy directory size must be 10");
+  for (size_t i = 0; i < node->proxies.size(); ++i) {
+    UNIT_ASSERT_EQUAL(node->proxy_at(i)->node_index, i, "invalid back index");
+  }
+
+  // remove some items from the middle
+  ostore_.remove(items[3]);
+  ostore_.remove(items[0]);
+
+  UNIT_ASSERT_EQUAL(node->proxies.size(), (size_t)8, "proxy directory size must be 8");
+  for (size_t i = 0; i < node->proxies.size(); ++i) {
+    UNIT_ASSERT_EQUAL(node->proxy_at(i)->node_index, i, "invalid back index");
+    UNIT_ASSERT_TRUE(node->proxy_at(i)->obj != nullptr, "object must be valid");
+  }
+
+  object_view<Item> view(ostore_, true);
+  UNIT_ASSERT_EQUAL(view.size(), (size_t)8, "view size must be 8");
+
+  ostore_.clear();
+
+  UNIT_ASSERT_TRUE(node->proxies.empty(), "proxy directory must be empty");
+}
+
+void ObjectStoreTestUnit::test_large_remove()
+{
+  typedef object_ptr<ItemPtrList> itemlist_ptr;
+  typedef object_ptr<Item> item_ptr;
+
+  // a large object tree
+  itemlist_ptr itemlist = ostore_.insert(new ItemPtrList);
+  for (int i = 0; i < 10000; ++i) {
+    itemlist->push_back(ostore_.insert(new Item("item", i)));
+  }
+
+  UNIT_ASSERT_TRUE(ostore_.is_removable(itemlist), "item list must be removable");
+
+  ostore_.remove(itemlist);
+
+  UNIT_ASSERT_TRUE(ostore_.empty(), "object store must be empty");
+
+  // an object shared by two list items
+  itemlist = ostore_.insert(new ItemPtrList);
+  item_ptr item = ostore_.insert(new Item("item", 1));
+  itemlist->push_back(item);
+  itemlist->push_back(item);
+
+  UNIT_ASSERT_EQUAL(item.ptr_count(), (unsigned long)2, "pointer count for item should be 2 (two)");
+
+  // the second check must see the same counters
+  UNIT_ASSERT_TRUE(ostore_.is_removable(itemlist), "item list must be removable");
+  UNIT_ASSERT_TRUE(ostore_.is_removable(itemlist), "item list must be removable");
+
+  // a second list referencing the item
+  object_ptr<ItemRefList> other = ostore_.insert(new ItemRefList);
+  other->push_back(item);
+
+  UNIT_ASSERT_FALSE(ostore_.is_removable(itemlist), "item is still referenced by other list");
+
+  other->clear();
+  ostore_.remove(other);
+  ostore_.remove(itemlist);
+
+  UNIT_ASSERT_TRUE(ostore_.empty(), "object store must be empty");
+}
+
+void ObjectStoreTestUnit::test_attribute_table()
+{
+  prototype_iterator node = ostore_.find_prototype<Item>();
+  UNIT_ASSERT_TRUE(node != ostore_.end(), "item prototype must exist");
+  const attribute_table *table = node->attributes;
+
+  UNIT_ASSERT_TRUE(table != nullptr, "item must have an attribute table");
+  UNIT_ASSERT_EQUAL(table->size(), (std::size_t)16, "item must have 16 attributes");
+  UNIT_ASSERT_TRUE(table->find("val_varchar") != nullptr, "attribute must be found");
+  UNIT_ASSERT_TRUE(table->find("val_unknown") == nullptr, "attribute must not be found");
+
+  // an object outside of a store is accessed by serialization
+  Item standalone("standalone", 1);
+  UNIT_ASSERT_TRUE(standalone.set("val_int", 2), "int attribute must be set");
+  UNIT_ASSERT_EQUAL(standalone.get_int(), 2, "int attribute is invalid");
+
+  object_ptr<Item> optr = ostore_.insert(new Item("item", 4711));
+  Item &item = *optr.get();
+
+  UNIT_ASSERT_TRUE(item.set("val_int", std::string("42")), "int attribute must be set");
+  UNIT_ASSERT_EQUAL(item.get_int(), 42, "int attribute is invalid");
+  UNIT_ASSERT_TRUE(item.set("val_string", 7), "string attribute must be set");
+  UNIT_ASSERT_EQUAL(item.get_string(), "7", "string attribute is invalid");
+  UNIT_ASSERT_TRUE(item.set("val_cstr", "baba"), "char array attribute must be set");
+  UNIT_ASSERT_FALSE(item.set("val_unknown", 7), "unknown attribute must not be set");
+  UNIT_ASSERT_FALSE(item.set("val_date", 7), "date attribute must not be set");
+
+  // the table and the serialization give the same values
+  const char *names[] = { "id", "val_char", "val_short", "val_int", "val_long",
+                          "val_unsigned_short", "val_unsigned_int", "val_unsigned_long", "val_bool",
+                          "val_cstr", "val_string", "val_varchar" };
+  for (const char *name : names) {
+    std::string value, expected;
+    UNIT_ASSERT_TRUE(item.get(name, value), "attribute must be found");
+    attribute_writer<std::string> writer(name, expected);
+    item.serialize(writer);
+    UNIT_ASSERT_TRUE(writer.success(), "attribute must be serialized");
+    UNIT_ASSERT_EQUAL(value, expected, "attribute value is invalid");
+  }
+
+  item.set("val_double", 123.55789);
+
+  std::string value;
+  UNIT_ASSERT_TRUE(item.get("val_double", value, 3), "double attribute must be found");
+  UNIT_ASSERT_EQUAL(value, "123.558", "double attribute is invalid");
+
+  UNIT_ASSERT_FALSE(item.get("val_unknown", value), "unknown attribute must not be found");
+}
+
+void ObjectStoreTestUnit::test_concurrent()
+{
+  typedef object_ptr<Item> item_ptr;
+  typedef object_view<Item> item_view_t;
+
+  const int count = 100;
+  for (int i = 0; i < count; ++i) {
+    ostore_.insert(new Item("item", i));
+  }
+  const long sum = count * (count - 1) / 2;
+
+  std::atomic<bool> done(false);
+  std::atomic<int> errors(0);
+  std::atomic<int> reads(0);
+
+  // readers check the sum of all values
+  // and the number of items
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r) {
+    readers.push_back(std::thread([&]() {
+      while (!done || reads < 100) {
+        shared_lock l(ostore_.mutex());
+        item_view_t view(ostore_);
+        long s = 0;
+        int n = 0;
+        for (item_view_t::const_iterator i = view.begin(); i != view.end(); ++i) {
+          const item_ptr item = *i;
+          s += item->get_int();
+          ++n;
+        }
+        if (s != sum || (n != count && n != count + 1)) {
+          ++errors;
+        }
+        ++reads;
+      }
+    }));
+  }
+
+  // the writer moves values between items
+  // and inserts and removes one item
+  item_view_t view(ostore_);
+  for (int i = 0; i < 200; ++i) {
+    item_ptr extra;
+    {
+      std::lock_guard<shared_mutex> l(ostore_.mutex());
+      item_ptr first = view.front();
+      item_ptr last = view.back();
+      first->set_int(first->get_int() + 1);
+      last->set_int(last->get_int() - 1);
+      extra = ostore_.insert(new Item("extra", 0));
+    }
+    {
+      std::lock_guard<shared_mutex> l(ostore_.mutex());
+      ostore_.remove(extra);
+    }
+  }
+  done = true;
+
+  for (std::thread &t : readers) {
+    t.join();
+  }
+
+  UNIT_ASSERT_EQUAL(errors.load(), 0, "readers must see consistent items");
+  UNIT_ASSERT_EQUAL((int)view.size(), count, "invalid item view size");
+}
@@ -39,6 +39,10 @@ public:
   void test_structure();
   void test_insert();
   void test_remove();
+  void test_directory();
+  void test_large_remove();
+  void test_attribute_table();
+  void test_concurrent();
 
 private:
   oos::object_store ostore_;
@@ -7,10 +7,44 @@
 
 #include <iostream>
 #include <fstream>
+#include <iterator>
+#include <stdexcept>
 
 using namespace oos;
 using namespace std;
 
+namespace {
+
+/*
+ * forward iterator over ints throwing
+ * when the given position is read
+ */
+class throwing_iterator : public std::iterator<std::forward_iterator_tag, int>
+{
+public:
+  throwing_iterator(std::vector<int>::const_iterator i, std::vector<int>::const_iterator fail)
+    : i_(i), fail_(fail)
+  {}
+
+  const int& operator*() const
+  {
+    if (i_ == fail_) {
+      throw std::runtime_error("read failed");
+    }
+    return *i_;
+  }
+  throwing_iterator& operator++() { ++i_; return *this; }
+  throwing_iterator operator++(int) { throwing_iterator tmp(*this); ++i_; return tmp; }
+  bool operator==(const throwing_iterator &x) const { return i_ == x.i_; }
+  bool operator!=(const throwing_iterator &x) const { return i_ != x.i_; }
+
+private:
+  std::vector<int>::const_iterator i_;
+  std::vector<int>::const_iterator fail_;
+};
+
+}
+
 ObjectVectorTestUnit::ObjectVectorTestUnit()
   : unit_test("vector", "object vector")
 {
@@ -18,6 +52,7 @@ ObjectVectorTestUnit::ObjectVectorTestUnit()
   add_test("ptr", std::bind(&ObjectVectorTestUnit::test_ptr_vector, this), "test object vector with pointers");
   add_test("ref", std::bind(&ObjectVectorTestUnit::test_ref_vector, this), "test object vector with references");
   add_test("direct_ref", std::bind(&ObjectVectorTestUnit::test_direct_ref_vector, this), "test direct object vector with references");
+  add_test("bulk", std::bind(&ObjectVectorTestUnit::test_bulk_vector, this), "test object vector bulk operations");
 }
 
 ObjectVectorTestUnit::~ObjectVectorTestUnit()
@@ -224,3 +259,95 @@ void ObjectVectorTestUnit::test_direct_ref_vector()
 
 //  std::for_each(alb1->begin(), alb1->end(), print_track);
 }
+
+void ObjectVectorTestUnit::test_bulk_vector()
+{
+  typedef object_ptr<IntVector> itemvector_ptr;
+
+  itemvector_ptr itemvector = ostore_.insert(new IntVector);
+
+  itemvector->reserve(100);
+  UNIT_ASSERT_TRUE(itemvector->capacity() >= 100, "capacity must be at least 100");
+
+  std::vector<int> values;
+  for (int i = 0; i < 10; ++i) {
+    values.push_back(i);
+  }
+
+  itemvector->insert(itemvector->end(), values.begin(), values.end());
+
+  UNIT_ASSERT_EQUAL((int)itemvector->size(), 10, "itemvector size isn't valid");
+
+  // insert in the middle
+  std::vector<int> middle(5, 42);
+  IntVector::iterator i = itemvector->insert(itemvector->begin() + 3, middle.begin(), middle.end());
+
+  UNIT_ASSERT_EQUAL((int)(*i)->index(), 3, "item is invalid");
+  UNIT_ASSERT_EQUAL((int)itemvector->size(), 15, "itemvector size isn't valid");
+
+  int index = 0;
+  for (i = itemvector->begin(); i != itemvector->end(); ++i) {
+    UNIT_ASSERT_EQUAL((int)(*i)->index(), index++, "item index is invalid");
+  }
+  UNIT_ASSERT_EQUAL((*(itemvector->begin() + 2))->value(), 2, "value must be 2");
+  UNIT_ASSERT_EQUAL((*(itemvector->begin() + 3))->value(), 42, "value must be 42");
+  UNIT_ASSERT_EQUAL((*(itemvector->begin() + 8))->value(), 3, "value must be 3");
+
+  std::vector<unsigned long> ids;
+  itemvector->ids(std::back_inserter(ids));
+
+  UNIT_ASSERT_EQUAL((int)ids.size(), 15, "id count isn't valid");
+  UNIT_ASSERT_EQUAL(ids.front(), itemvector->begin()->id(), "id isn't valid");
+
+  itemvector->assign(values.begin(), values.begin() + 4);
+
+  UNIT_ASSERT_EQUAL((int)itemvector->size(), 4, "itemvector size isn't valid");
+  UNIT_ASSERT_EQUAL((*(itemvector->begin() + 3))->value(), 3, "value must be 3");
+
+  // a failing range leaves the vector unchanged
+  throwing_iterator tfirst(values.begin(), values.begin() + 5);
+  throwing_iterator tlast(values.end(), values.begin() + 5);
+  bool failed = false;
+  try {
+    itemvector->insert(itemvector->begin() + 1, tfirst, tlast);
+  } catch (std::runtime_error &) {
+    failed = true;
+  }
+  UNIT_ASSERT_TRUE(failed, "insert must fail");
+  UNIT_ASSERT_EQUAL((int)itemvector->size(), 4, "itemvector size isn't valid");
+  index = 0;
+  for (i = itemvector->begin(); i != itemvector->end(); ++i) {
+    UNIT_ASSERT_EQUAL((*i)->value(), index, "item value is invalid");
+    UNIT_ASSERT_EQUAL((int)(*i)->index(), index++, "item index is invalid");
+  }
+
+  // refs
+  typedef object_ptr<ItemRefVector> refvector_ptr;
+  refvector_ptr refvector = ostore_.insert(new ItemRefVector);
+
+  std::vector<ItemRefVector::value_type> items;
+  for (int j = 0; j < 10; ++j) {
+    items.push_back(ostore_.insert(new Item("item", j)));
+  }
+  refvector->assign(items.begin(), items.end());
+
+  UNIT_ASSERT_EQUAL((int)refvector->size(), 10, "refvector size isn't valid");
+  UNIT_ASSERT_EQUAL((*(refvector->begin() + 7))->value()->get_int(), 7, "value must be 7");
+
+  // direct vector
+  object_ptr<album> alb = ostore_.insert(new album("My Album"));
+  alb->add(ostore_.insert(new track("Track 1")));
+
+  std::vector<album::track_ref> tracks;
+  tracks.push_back(ostore_.insert(new track("Track 2")));
+  tracks.push_back(ostore_.insert(new track("Track 3")));
+
+  alb->insert(alb->begin(), tracks.begin(), tracks.end());
+
+  UNIT_ASSERT_EQUAL((int)alb->size(), 3, "album size isn't valid");
+  UNIT_ASSERT_EQUAL((*alb->begin())->title(), "Track 2", "invalid track");
+  UNIT_ASSERT_EQUAL((*alb->begin())->index(), 0, "invalid track index");
+  UNIT_ASSERT_EQUAL((*(alb->begin() + 2))->title(), "Track 1", "invalid track");
+  UNIT_ASSERT_EQUAL((*(alb->begin() + 2))->index(), 2, "invalid track index");
+  UNIT_ASSERT_TRUE((*alb->begin())->alb() == alb, "invalid album reference");
+}
@@ -19,6 +19,7 @@ public:
   void test_ptr_vector();
 
   void test_direct_ref_vector();
+  void test_bulk_vector();
 
 private:
   oos::object_store ostore_;
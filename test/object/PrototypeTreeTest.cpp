@@ -84,15 +84,36 @@ void PrototypeTreeTestUnit::test_find()
 
   UNIT_ASSERT_TRUE(elem != ptree.end(), "couldn't find prototype");
   UNIT_ASSERT_EQUAL(elem->type, "item", "type must be 'item'");
+
+  // second lookup is served from type index cache
+  elem = ptree.find(typeid(Item));
+
+  UNIT_ASSERT_TRUE(elem != ptree.end(), "couldn't find prototype");
+  UNIT_ASSERT_EQUAL(elem->type, "item", "type must be 'item'");
+
+  // inserting the same type twice makes typeid ambiguous
+  ptree.insert(new object_producer<Item>, "other_item", false);
+
+  UNIT_ASSERT_EXCEPTION(ptree.find<Item>(), object_exception, "type id not unique", "type id must not be unique");
+
+  ptree.remove("other_item");
+  ptree.remove("item");
+
+  elem = ptree.find<Item>();
+
+  UNIT_ASSERT_TRUE(elem == ptree.end(), "prototype must not be found");
 }
 
 
 void PrototypeTreeTestUnit::test_remove()
 {
   prototype_tree ptree;
+  std::size_t generation = ptree.generation();
   ptree.insert(new object_producer<Item>, "item", false);
 
   UNIT_ASSERT_EQUAL(ptree.size(), (size_t)1, "prototype size must be one (1)");
+  UNIT_ASSERT_TRUE(ptree.generation() != generation, "insert must change the generation");
+  generation = ptree.generation();
 
   UNIT_ASSERT_EXCEPTION(ptree.remove(0), object_exception, "invalid type (null)", "expect an object exception when trying to remove unknown type");
   UNIT_ASSERT_EXCEPTION(ptree.remove("ITEM"), object_exception, "unknown prototype type", "expect an object exception when trying to remove unknown type");
@@ -101,6 +122,7 @@ void PrototypeTreeTestUnit::test_remove()
 
   UNIT_ASSERT_EQUAL(ptree.size(), (size_t)0, "prototype size must be one (0)");
   UNIT_ASSERT_TRUE(ptree.empty(), "prototype tree must be empty");
+  UNIT_ASSERT_TRUE(ptree.generation() != generation, "remove must change the generation");
 }
 
 
@@ -25,6 +25,7 @@
 #include "tools/VarCharTestUnit.hpp"
 #include "tools/FactoryTestUnit.hpp"
 #include "tools/StringTestUnit.hpp"
+#include "tools/SequencerTestUnit.hpp"
 
 #include "object/ObjectStoreTestUnit.hpp"
 #include "object/ObjectPrototypeTestUnit.hpp"
@@ -35,6 +36,10 @@
 #include "database/DatabaseTestUnit.hpp"
 #include "database/SessionTestUnit.hpp"
 #include "database/TransactionTestUnit.hpp"
+#include "database/SQLiteTimeTestUnit.hpp"
+#include "database/ConnectionPoolTestUnit.hpp"
+#include "database/JournalTestUnit.hpp"
+#include "database/ChangeStreamTestUnit.hpp"
 
 #include "json/JsonTestUnit.hpp"
 
@@ -64,6 +69,7 @@ int main(int argc, char *argv[])
   test_suite::instance().register_unit(new VarCharTestUnit());
   test_suite::instance().register_unit(new FactoryTestUnit());
   test_suite::instance().register_unit(new StringTestUnit());
+  test_suite::instance().register_unit(new SequencerTestUnit());
 
   test_suite::instance().register_unit(new PrototypeTreeTestUnit());
   test_suite::instance().register_unit(new ObjectPrototypeTestUnit());
@@ -71,6 +77,9 @@ int main(int argc, char *argv[])
   test_suite::instance().register_unit(new ObjectListTestUnit());
   test_suite::instance().register_unit(new ObjectVectorTestUnit());
 
+  test_suite::instance().register_unit(new JournalTestUnit());
+  test_suite::instance().register_unit(new ChangeStreamTestUnit());
+
 #ifdef OOS_MYSQL
   test_suite::instance().register_unit(new SessionTestUnit("mysql_session", "mysql session test unit", connection::mysql));
   test_suite::instance().register_unit(new TransactionTestUnit("mysql_transaction", "mysql transaction test unit", connection::mysql));
@@ -79,18 +88,23 @@ int main(int argc, char *argv[])
   #else
     test_suite::instance().register_unit(new DatabaseTestUnit("mysql_database", "mysql database test unit", connection::mysql));
   #endif
+  test_suite::instance().register_unit(new ConnectionPoolTestUnit("mysql_pool", "mysql connection pool test unit", connection::mysql));
 #endif
 
 #ifdef OOS_ODBC
   test_suite::instance().register_unit(new SessionTestUnit("mssql_session", "mssql session test unit", connection::mssql));
   test_suite::instance().register_unit(new TransactionTestUnit("mssql_transaction", "mssql transaction test unit", connection::mssql));
   test_suite::instance().register_unit(new DatabaseTestUnit("mssql_database", "mssql database test unit", connection::mssql));
+  test_suite::instance().register_unit(new ConnectionPoolTestUnit("mssql_pool", "mssql connection pool test unit", connection::mssql));
 #endif
 
 #ifdef OOS_SQLITE3
   test_suite::instance().register_unit(new SessionTestUnit("sqlite_session", "sqlite session test unit", connection::sqlite));
   test_suite::instance().register_unit(new TransactionTestUnit("sqlite_transaction", "sqlite transaction test unit", connection::sqlite));
   test_suite::instance().register_unit(new DatabaseTestUnit("sqlite_database", "sqlite database test unit", connection::sqlite));
+  test_suite::instance().register_unit(new DatabaseTestUnit("sqlite_native_database", "sqlite native time database test unit", std::string(connection::sqlite) + "?time=native"));
+  test_suite::instance().register_unit(new SQLiteTimeTestUnit("sqlite_time", "sqlite time storage test unit", connection::sqlite));
+  test_suite::instance().register_unit(new ConnectionPoolTestUnit("sqlite_pool", "sqlite connection pool test unit", connection::sqlite));
 #endif
 
   test_suite::instance().register_unit(new TransactionTestUnit("memory_transaction", "memory transaction test unit"));
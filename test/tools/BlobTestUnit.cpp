@@ -2,16 +2,16 @@
 
 #include "tools/blob.hpp"
 
-#include <iostream>
+#include <sstream>
 
 using namespace oos;
 
-using std::cout;
-
 BlobTestUnit::BlobTestUnit()
   : unit_test("blob", "blob test unit")
 {
   add_test("create", std::bind(&BlobTestUnit::create_blob, this), "create blob");
+  add_test("append", std::bind(&BlobTestUnit::append_blob, this), "append to blob");
+  add_test("binary", std::bind(&BlobTestUnit::binary_blob, this), "blob with binary data");
 }
 
 BlobTestUnit::~BlobTestUnit()
@@ -19,24 +19,63 @@ BlobTestUnit::~BlobTestUnit()
 
 void BlobTestUnit::create_blob()
 {
-  /*
-  cout << "\n";
-
   blob b1;
-  
+
+  UNIT_ASSERT_TRUE(b1.empty(), "blob must be empty");
+  UNIT_ASSERT_EQUAL((int)b1.size(), 0, "size must be zero");
+
   int val = 8;
-  b1.assign(val);
-  b1.assign(val);
+  UNIT_ASSERT_TRUE(b1.assign(val), "value must be assigned");
+  UNIT_ASSERT_TRUE(b1.assign(val), "value must be assigned");
+
+  UNIT_ASSERT_EQUAL(b1.size(), sizeof(int), "size must be size of int");
+  UNIT_ASSERT_TRUE(b1.capacity() >= b1.size(), "capacity must not be less than size");
+
+  int result = 0;
+  memcpy(&result, b1.data(), sizeof(int));
+  UNIT_ASSERT_EQUAL(result, 8, "value must be 8");
+
+  blob b2(b1);
+
+  UNIT_ASSERT_TRUE(b1 == b2, "blobs must be equal");
+
+  b2.clear();
+
+  UNIT_ASSERT_TRUE(b2.empty(), "blob must be empty");
+  UNIT_ASSERT_TRUE(b1 != b2, "blobs must not be equal");
+}
+
+void BlobTestUnit::append_blob()
+{
+  blob b;
+
+  for (int i = 0; i < 10; ++i) {
+    UNIT_ASSERT_TRUE(b.append(i), "value must be appended");
+  }
+
+  UNIT_ASSERT_EQUAL(b.size(), 10 * sizeof(int), "size must be ten ints");
+
+  const int *values = reinterpret_cast<const int*>(b.data());
+  for (int i = 0; i < 10; ++i) {
+    UNIT_ASSERT_EQUAL(values[i], i, "value must be equal");
+  }
+
+  b.resize(2 * sizeof(int));
+
+  UNIT_ASSERT_EQUAL(b.size(), 2 * sizeof(int), "size must be two ints");
+}
+
+void BlobTestUnit::binary_blob()
+{
+  const char data[] = { 'a', '\0', 'b', '\0', '\xff' };
+
+  blob b(data, sizeof(data));
 
-  cout << "size: " << b1.size() << "\n";
-  cout << "capacity: " << b1.capacity() << "\n";
+  UNIT_ASSERT_EQUAL((int)b.size(), 5, "size must be 5");
+  UNIT_ASSERT_TRUE(memcmp(b.data(), data, sizeof(data)) == 0, "data must be equal");
 
-  blob b2;
-  
-  b2.assign(val);
-  b2.assign(val);
+  std::stringstream out;
+  out << b;
 
-  cout << "size: " << b2.size() << "\n";
-  cout << "capacity: " << b2.capacity() << "\n";
-  */
+  UNIT_ASSERT_EQUAL(out.str(), "61006200FF", "hex string must be equal");
 }
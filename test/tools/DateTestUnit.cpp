@@ -23,6 +23,7 @@ DateTestUnit::DateTestUnit()
   add_test("modify", std::bind(&DateTestUnit::test_modify, this), "modify date");
   add_test("difference", std::bind(&DateTestUnit::test_difference, this), "difference date");
   add_test("to_string", std::bind(&DateTestUnit::test_to_string, this), "to string");
+  add_test("calendar", std::bind(&DateTestUnit::test_calendar, this), "calendar conversion");
 }
 
 DateTestUnit::~DateTestUnit()
@@ -263,3 +264,34 @@ void DateTestUnit::test_to_string()
 
   UNIT_ASSERT_EQUAL(str, "2015-06-30", "result must be '2015-06-30'");
 }
+
+void DateTestUnit::test_calendar()
+{
+  // 1.1.1900 to 31.12.2100
+  date d(1, 1, 1900);
+  int day = 1, month = 1, year = 1900;
+  while (year <= 2100) {
+    date x(d.julian_date());
+
+    UNIT_ASSERT_EQUAL(day, x.day(), "day of month isn't equal");
+    UNIT_ASSERT_EQUAL(month, x.month(), "month of year isn't equal");
+    UNIT_ASSERT_EQUAL(year, x.year(), "year isn't equal");
+    UNIT_ASSERT_EQUAL(day, d.day(), "day of month isn't equal");
+    UNIT_ASSERT_EQUAL(month, d.month(), "month of year isn't equal");
+    UNIT_ASSERT_EQUAL(year, d.year(), "year isn't equal");
+    UNIT_ASSERT_EQUAL(date::is_leapyear(year), d.is_leapyear(), "leap year isn't equal");
+
+    ++d;
+    if (++day > date::month_days[month - 1] + (month == 2 && date::is_leapyear(year) ? 1 : 0)) {
+      day = 1;
+      if (++month > 12) {
+        month = 1;
+        ++year;
+      }
+    }
+  }
+
+  d += 40;
+
+  UNIT_ASSERT_EQUAL(d, date(10, 2, 2101), "date isn't equal");
+}
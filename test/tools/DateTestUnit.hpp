@@ -23,6 +23,7 @@ public:
   void test_modify();
   void test_difference();
   void test_to_string();
+  void test_calendar();
 };
 
 #endif /* DATETESTUNIT_HPP */
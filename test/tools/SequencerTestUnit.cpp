@@ -0,0 +1,127 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SequencerTestUnit.hpp"
+
+#include "tools/sequencer.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace oos;
+
+SequencerTestUnit::SequencerTestUnit()
+  : unit_test("sequencer", "sequencer test unit")
+{
+  add_test("default", std::bind(&SequencerTestUnit::test_default, this), "test default sequencer");
+  add_test("atomic", std::bind(&SequencerTestUnit::test_atomic, this), "test atomic sequencer");
+  add_test("cache", std::bind(&SequencerTestUnit::test_cache, this), "test thread cache of atomic sequencer");
+  add_test("concurrent", std::bind(&SequencerTestUnit::test_concurrent, this), "test concurrent id allocation");
+}
+
+SequencerTestUnit::~SequencerTestUnit()
+{}
+
+void SequencerTestUnit::test_default()
+{
+  sequencer seq;
+
+  UNIT_ASSERT_EQUAL(seq.init(), 0L, "sequence must start with zero");
+  UNIT_ASSERT_EQUAL(seq.next(), 1L, "next id must be one");
+  UNIT_ASSERT_EQUAL(seq.next(), 2L, "next id must be two");
+  UNIT_ASSERT_EQUAL(seq.update(10), 10L, "sequence must be updated to ten");
+  UNIT_ASSERT_EQUAL(seq.update(5), 10L, "sequence must stay at ten");
+  UNIT_ASSERT_EQUAL(seq.next(), 11L, "next id must be eleven");
+  UNIT_ASSERT_EQUAL(seq.reset(3), 3L, "sequence must be reset to three");
+  UNIT_ASSERT_EQUAL(seq.current(), 3L, "current id must be three");
+}
+
+void SequencerTestUnit::test_atomic()
+{
+  sequencer seq(sequencer_impl_ptr(new atomic_sequencer(1)));
+
+  UNIT_ASSERT_EQUAL(seq.init(), 0L, "sequence must start with zero");
+  UNIT_ASSERT_EQUAL(seq.next(), 1L, "next id must be one");
+  UNIT_ASSERT_EQUAL(seq.next(), 2L, "next id must be two");
+  UNIT_ASSERT_EQUAL(seq.current(), 2L, "current id must be two");
+  UNIT_ASSERT_EQUAL(seq.update(10), 10L, "sequence must be updated to ten");
+  UNIT_ASSERT_EQUAL(seq.update(5), 10L, "sequence must stay at ten");
+  UNIT_ASSERT_EQUAL(seq.next(), 11L, "next id must be eleven");
+  UNIT_ASSERT_EQUAL(seq.reset(3), 3L, "sequence must be reset to three");
+  UNIT_ASSERT_EQUAL(seq.next(), 4L, "next id must be four");
+}
+
+void SequencerTestUnit::test_cache()
+{
+  atomic_sequencer seq(8);
+
+  UNIT_ASSERT_EQUAL(seq.cache_size(), 8L, "cache size must be eight");
+  UNIT_ASSERT_EQUAL(seq.next(), 1L, "next id must be one");
+  UNIT_ASSERT_EQUAL(seq.current(), 8L, "eight ids must be taken into the cache");
+  UNIT_ASSERT_EQUAL(seq.next(), 2L, "next id must be two");
+
+  // an id inside the cached range invalidates the cache
+  seq.update(5);
+  UNIT_ASSERT_EQUAL(seq.next(), 9L, "next id must be taken from a new range");
+  UNIT_ASSERT_EQUAL(seq.next(), 10L, "next id must be ten");
+
+  // a thread caches the ids of one sequencer only
+  atomic_sequencer other(8);
+  UNIT_ASSERT_EQUAL(other.next(), 1L, "next id of other sequencer must be one");
+  UNIT_ASSERT_EQUAL(seq.next(), 17L, "next id must be taken from a new range");
+
+  seq.reset(100);
+  UNIT_ASSERT_EQUAL(seq.next(), 101L, "next id must follow the reset id");
+  UNIT_ASSERT_EQUAL(seq.current(), 108L, "eight ids must be taken into the cache");
+
+  seq.update(200);
+  UNIT_ASSERT_EQUAL(seq.next(), 102L, "cache must be kept when updated beyond");
+  UNIT_ASSERT_EQUAL(seq.current(), 200L, "current id must be updated");
+}
+
+void SequencerTestUnit::test_concurrent()
+{
+  const long threads = 4;
+  const long count = 10000;
+
+  atomic_sequencer seq(16);
+
+  std::vector<std::vector<long> > ids(threads);
+  std::vector<std::thread> workers;
+  for (long t = 0; t < threads; ++t) {
+    workers.push_back(std::thread([&seq, &ids, t, count]() {
+      ids[t].reserve(count);
+      for (long i = 0; i < count; ++i) {
+        ids[t].push_back(seq.next());
+      }
+    }));
+  }
+  for (std::vector<std::thread>::iterator i = workers.begin(); i != workers.end(); ++i) {
+    i->join();
+  }
+
+  std::vector<long> all;
+  for (long t = 0; t < threads; ++t) {
+    UNIT_ASSERT_TRUE(std::is_sorted(ids[t].begin(), ids[t].end()), "ids of a thread must be ascending");
+    all.insert(all.end(), ids[t].begin(), ids[t].end());
+  }
+  std::sort(all.begin(), all.end());
+  UNIT_ASSERT_TRUE(std::adjacent_find(all.begin(), all.end()) == all.end(), "ids must be unique");
+  UNIT_ASSERT_EQUAL(all.size(), (size_t)(threads * count), "all ids must be handed out");
+  UNIT_ASSERT_TRUE(seq.current() >= all.back(), "current id must cover all ids");
+}
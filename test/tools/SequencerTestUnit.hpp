@@ -0,0 +1,38 @@
+/*
+ * This file is part of OpenObjectStore OOS.
+ *
+ * OpenObjectStore OOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenObjectStore OOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenObjectStore OOS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SEQUENCERTESTUNIT_HPP
+#define SEQUENCERTESTUNIT_HPP
+
+#include <unit/unit_test.hpp>
+
+class SequencerTestUnit : public oos::unit_test
+{
+public:
+  SequencerTestUnit();
+  virtual ~SequencerTestUnit();
+
+  virtual void initialize() {}
+  virtual void finalize() {}
+
+  void test_default();
+  void test_atomic();
+  void test_cache();
+  void test_concurrent();
+};
+
+#endif /* SEQUENCERTESTUNIT_HPP */
@@ -3,6 +3,7 @@
 #include "tools/time.hpp"
 #include "tools/string.hpp"
 
+#include <cstring>
 #include <stdexcept>
 
 using namespace oos;
@@ -19,6 +20,8 @@ TimeTestUnit::TimeTestUnit()
   add_test("modify", std::bind(&TimeTestUnit::test_modify, this), "modify time");
   add_test("parse", std::bind(&TimeTestUnit::test_parse, this), "parse time");
   add_test("format", std::bind(&TimeTestUnit::test_format, this), "format time");
+  add_test("format_buffer", std::bind(&TimeTestUnit::test_format_buffer, this), "format time into a buffer");
+  add_test("parse_format", std::bind(&TimeTestUnit::test_parse_format, this), "parse formatted time");
 }
 
 TimeTestUnit::~TimeTestUnit()
@@ -273,3 +276,59 @@ void TimeTestUnit::test_format()
 
   UNIT_ASSERT_EQUAL(tstr, "11:35:07.123 31.01.2015", "invalid time string [" + tstr + "]");
 }
+
+void TimeTestUnit::test_format_buffer()
+{
+  oos::time t(2015, 1, 31, 11, 35, 7, 5);
+
+  char buffer[32];
+  size_t len = to_string(t, buffer, sizeof(buffer), time_format::ISO8601_MILLI);
+
+  UNIT_ASSERT_EQUAL(std::string(buffer), "2015-01-31 11:35:07.005", "invalid time string");
+  UNIT_ASSERT_EQUAL(len, strlen(buffer), "invalid length of time string");
+
+  to_string(t, buffer, sizeof(buffer), time_format::ISO8601_MICRO);
+
+  UNIT_ASSERT_EQUAL(std::string(buffer), "2015-01-31 11:35:07.005000", "invalid time string");
+
+  to_string(t, buffer, sizeof(buffer), "%T %d.%m.%Y");
+
+  UNIT_ASSERT_EQUAL(std::string(buffer), "11:35:07 31.01.2015", "invalid time string");
+
+  // formatted by strftime
+  to_string(t, buffer, sizeof(buffer), "%a %F");
+
+  UNIT_ASSERT_EQUAL(std::string(buffer), "Sat 2015-01-31", "invalid time string");
+
+  UNIT_ASSERT_EXCEPTION(to_string(t, buffer, 10, time_format::ISO8601), std::logic_error, "buffer too small for time string", "buffer should be too small");
+
+  oos::date d(5, 3, 2015);
+  len = to_string(d, buffer, sizeof(buffer));
+
+  UNIT_ASSERT_EQUAL(std::string(buffer), "2015-03-05", "invalid date string");
+  UNIT_ASSERT_EQUAL(len, 10UL, "invalid length of date string");
+}
+
+void TimeTestUnit::test_parse_format()
+{
+  struct timeval tv;
+  tv.tv_sec = 1420070400;
+  tv.tv_usec = 123456;
+
+  // every 10 days and some hours over ten years
+  char buffer[32];
+  for (int i = 0; i < 365; ++i) {
+    oos::time t(tv);
+    to_string(t, buffer, sizeof(buffer), time_format::ISO8601_MICRO);
+    oos::time p = oos::time::parse(buffer, time_format::ISO8601_MICRO);
+    UNIT_ASSERT_EQUAL(p, t, "parsed time isn't equal");
+    tv.tv_sec += 10 * 86400 + 3601;
+  }
+
+  oos::time t = oos::time::parse("2015-04-03 12:55:12.1", time_format::ISO8601_MILLI);
+
+  UNIT_ASSERT_EQUAL(12, t.hour(), "hour must be 12");
+  UNIT_ASSERT_EQUAL(100, t.milli_second(), "millisecond must be 100");
+  UNIT_ASSERT_EQUAL(5, t.day_of_week(), "day of week must be 5");
+  UNIT_ASSERT_EQUAL(92, t.day_of_year(), "day of year must be 92");
+}
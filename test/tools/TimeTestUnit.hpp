@@ -21,6 +21,8 @@ public:
   void test_modify();
   void test_parse();
   void test_format();
+  void test_format_buffer();
+  void test_parse_format();
 };
 
 #endif /* TIMETESTUNIT_HPP */
@@ -40,10 +40,49 @@ void VarCharTestUnit::create_varchar()
 
 void VarCharTestUnit::copy_varchar()
 {
+  varchar<16> str("hallo");
+  varchar<16> copy(str);
+
+  UNIT_ASSERT_EQUAL((int)copy.size(), 5, "size of varchar must be five");
+  UNIT_ASSERT_EQUAL(copy, "hallo", "copied varchar is not equal");
+  UNIT_ASSERT_TRUE(copy.data() != str.data(), "copied varchar must have its own data");
+
+  str = "welt";
+
+  UNIT_ASSERT_EQUAL(copy, "hallo", "copied varchar must not change");
+
+  oos::varchar_base base(str);
+
+  UNIT_ASSERT_EQUAL((int)base.capacity(), 16, "invalid capacity of varchar");
+  UNIT_ASSERT_TRUE(base == str, "copied varchar is not equal");
 }
 
 void VarCharTestUnit::assign_varchar()
 {
+  varchar<8> str8;
+  const char *data = str8.data();
+
+  str8 = std::string("Hallo Welt");
+
+  UNIT_ASSERT_EQUAL((int)str8.size(), 8, "varchar must be truncated to its capacity");
+  UNIT_ASSERT_EQUAL(str8, "Hallo We", "varchar must be truncated to its capacity");
+  UNIT_ASSERT_TRUE(str8.data() == data, "varchar must keep its data");
+
+  varchar<16> str16("hallo welt");
+
+  str8 = str16.str();
+
+  UNIT_ASSERT_EQUAL(str8, "hallo we", "varchar must be truncated to its capacity");
+
+  str16 = str8.str();
+  str16 += "lt";
+
+  UNIT_ASSERT_EQUAL(str16, "hallo welt", "appended varchar is not equal");
+
+  str16.clear();
+
+  UNIT_ASSERT_TRUE(str16.empty(), "varchar must be empty");
+  UNIT_ASSERT_EQUAL(std::string(str16.c_str()), std::string(), "varchar must be empty");
 }
 
 void VarCharTestUnit::init_varchar()